@@ -9,18 +9,42 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
 
 // definitions de la taille des microQRcode M1/M2/M3/M4
 // 1 module = 1 petit carré blanc ou noir composant le QRcode
-// remarque :  1 module peut donner 8x8 pixels ou plus sur l'image du QRcode (voir la definition de PIX_BY_MODULE)
+// remarque :  1 module peut donner 8x8 pixels ou plus sur l'image du QRcode (voir PIX_BY_MODULE et fixe_rendu_QRcode)
 //
 #define NB_MODULE_M1  11      /** largeur d'un QRCode dans le mode M1  */
 #define NB_MODULE_M2  13      /** largeur d'un QRCode dans le mode M2  */
 #define NB_MODULE_M3  15      /** largeur d'un QRCode dans le mode M3  */
 #define NB_MODULE_M4  17      /** largeur d'un QRCode dans le mode M4  */
 
-#warning selectionner la taille des qrcode selon le mode choisi ci dessous
-#define NB_MODULE     NB_MODULE_M1 /// Taille d'un module ( A SELECTIONNER)
+#define NB_MODULE_MAX NB_MODULE_M4 /** largeur maximale (M4) : taille du stockage des modules d'un QRcode_t */
+
+#define PIX_BY_MODULE 8       /** largeur en pixels d'un module dans les images, par défaut (voir fixe_rendu_QRcode) */
+#define ZONE_BLANCHE  2       /** largeur en modules de la zone blanche (quiet zone) autour d'un microQR (ISO 18004) */
 
 //  versions pour microQRcode (voir ISO 18004/2015 p57
 //  ces versions sont embarques dans le codage de version(et utilisées aussi pour le codage du flux binaireà
@@ -39,28 +63,73 @@
 #define NUMERIC   0b0001    /** mode numerique  (supporté par M1/M2/M3/M4)              */
 #define ALPHANUM  0b0010    /** mode alphanum a 45 caractere  (supporté par M2/M3/M4)   */
 #define ASCII     0b0100    /** mode ascii  supporté par M3/M4                          */
-#define KANJI     0b1000    /** mode kanji , pour complétude mais non implémenté        */
+#define KANJI     0b1000    /** mode kanji (Shift-JIS sur 13 bits, chaine en UTF-8) supporté par M3/M4 */
+#define MODE_AUTO (NUMERIC | ALPHANUM | ASCII | KANJI)  /** découpage automatique de la chaine en segments de modes différents */
+
+// choix automatique de la version : le plus petit microQRcode qui contient la chaine,
+// avec le niveau de correction le plus élevé possible a cette taille (au moins le niveau demandé)
+#define NIVEAU_DETECTION  0         /** M1 : détection d'erreur seulement    */
+#define NIVEAU_L          1         /** correction Low                       */
+#define NIVEAU_M          2         /** correction Medium                    */
+#define NIVEAU_Q          3         /** correction Quality (M4 seulement)    */
+#define VERSION_AUTO      0x10      /** a combiner avec le niveau minimal : VERSION_AUTO | NIVEAU_M  */
 
 // definition du noir et du blanc
 #define NOIR      0         /**  module de couleur nNOIRE   */
 #define BLANC     255       /**  module de couleur BLANCHE  */
 
+// un microQRcode (ou un qrmask) embarque sa version et sa largeur, ce qui permet
+// de traiter des M1, M2, M3 et M4 dans un meme programme.
+// les modules sont stockés dans un tableau de la taille maximale (M4), seuls
+// les nb_module x nb_module premiers sont utilisés
+typedef struct
+{
+    unsigned short int version;                          /** version parmi M1_, M2_L ... M4_Q                   */
+    int nb_module;                                        /** largeur du QRcode (NB_MODULE_M1 a NB_MODULE_M4)    */
+    unsigned char module[NB_MODULE_MAX][NB_MODULE_MAX];   /** les modules NOIR/BLANC, indexés [ligne][colonne]   */
+} QRcode_t;
+
+// representation compacte (bitboard) d'un microQRcode : 1 mot de 32 bits par ligne
+// le bit j de ligne[i] represente le module (i,j) : 1 = NOIR, 0 = BLANC
+// un M4 (17x17) tient dans 17 mots, soit 8 fois moins de memoire que le QRcode_t
+typedef struct
+{
+    unsigned short int version;            /** version parmi M1_, M2_L ... M4_Q              */
+    int nb_module;                          /** largeur du QRcode (NB_MODULE_M1 a NB_MODULE_M4) */
+    uint32_t ligne[NB_MODULE_MAX];          /** une ligne de modules par mot, bit j = colonne j */
+} QRbits_t;
+
 //////////////////////SUJET 0 = COMMUN SUJETS 1 2 3 4/////////////////////
 // fonctions communes
-void efface_QRcode(unsigned char qrcode[NB_MODULE][NB_MODULE]);                  // sujet0 (commun) :  Efface  un QRcode  (tous les modules = BLANC = 255)
-void initialise_QRcode(unsigned char qrcode[NB_MODULE][NB_MODULE]);              // Sujet 0 (commun) : initialise les finder pattern et synchronous pattern
+int  nb_module_version(unsigned short int version);                     // sujet0 (commun) : largeur d'un QRcode selon sa version (M1_ ... M4_Q)
+void cree_QRcode(QRcode_t *qrcode, unsigned short int version);         // sujet0 (commun) : fixe la version/largeur d'un QRcode et l'efface
+void efface_QRcode(QRcode_t *qrcode);                  // sujet0 (commun) :  Efface  un QRcode  (tous les modules = BLANC = 255)
+void initialise_QRcode(QRcode_t *qrcode);              // Sujet 0 (commun) : initialise les finder pattern et synchronous pattern
+void demarre_QRcode(QRcode_t *qrcode, unsigned short int version, int no_masque);   // Sujet 0 (complement) : recopie le modele précalculé (patterns + format) d'une version/masque
 
 // /////////////////// SUJET 1 ///////////////////////////////////////////
 // gestion des version/mode et n° mask
 unsigned short int  encode_version(int type, int no_masque);   // sujet 1 : combine n° de type et n° de masque, ajoute la protection BCH et masaque le tout
-void ajoute_version_QRcode(unsigned char qrcode[NB_MODULE][NB_MODULE],unsigned short int header15bits);  // sujet1 :  ecrit les 15 bits de version + code corretcion
+void ajoute_version_QRcode(QRcode_t *qrcode,unsigned short int header15bits);  // sujet1 :  ecrit les 15 bits de version + code corretcion
 
 ////////////////////// SUJET 2 ///////////////////////////////////////////
 // fonctions autour du masquage 2D
-void genere_QRmask(unsigned char qrmask[NB_MODULE][NB_MODULE],int no_masque);     // sujet 2 : genere un QRmask (n° entre 0 et 3)
-void Black_And_Whitise_QRcode(unsigned char qrcode[NB_MODULE][NB_MODULE]);        // sujet 2 :  sature en noir tout ce qui n'est pas blanc
-void xor_QRcode_QRmask(unsigned char qrcode[NB_MODULE][NB_MODULE],const unsigned char qrmask[NB_MODULE][NB_MODULE]);  //sujet 2:  Réalise le masquage du QRcode
-int  score_masquage_QRcode(const unsigned char qrcode[NB_MODULE][NB_MODULE]);     // sujet 2(complement) calcul la metrique pour choix du meilleur masque
+void genere_QRmask(QRcode_t *qrmask,int no_masque);     // sujet 2 : genere un QRmask (n° entre 0 et 3), recopié depuis une table précalculée
+void Black_And_Whitise_QRcode(QRcode_t *qrcode);        // sujet 2 :  sature en noir tout ce qui n'est pas blanc
+void xor_QRcode_QRmask(QRcode_t *qrcode,const QRcode_t *qrmask);  //sujet 2:  Réalise le masquage du QRcode
+int  score_masquage_QRcode(const QRcode_t *qrcode);     // sujet 2(complement) calcul la metrique pour choix du meilleur masque
+
+// les memes traitements sur la representation compacte (1 bit par module)
+void QRcode_to_QRbits(const QRcode_t *qrcode, QRbits_t *qrbits);   // sujet 2(complement) : compacte un QRcode (tout ce qui n'est pas BLANC devient NOIR)
+void QRbits_to_QRcode(const QRbits_t *qrbits, QRcode_t *qrcode);   // sujet 2(complement) : decompacte un QRbits en QRcode NOIR/BLANC
+void genere_QRmask_QRbits(QRbits_t *qrmask,int no_masque);          // sujet 2(complement) : genere un QRmask compacté (table précalculée)
+void xor_QRbits_QRmask(QRbits_t *qrbits, const QRbits_t *qrmask);   // sujet 2(complement) : masquage, 1 XOR par ligne
+int  score_masquage_QRbits(const QRbits_t *qrbits);                 // sujet 2(complement) : score du masquage par comptage de bits (popcount)
+
+// choix du meilleur masque sans construire les 4 QRcode masqués
+#define MASQUE_AUTO  -1   /** n° de masque a passer pour choisir automatiquement le meilleur masque */
+int  choisit_masque_QRcode(QRcode_t *qrcode, int no_masque);        // sujet 2(complement) : choisit (ou impose) le masque et l'applique une seule fois
+int  choisit_masque_QRbits(QRbits_t *qrbits, int no_masque);        // sujet 2(complement) : idem sur un qrcode compacté
 
 // /////////////////// SUJETS 3 //////////////////////////////////////////
 //Fonctions d'encodage du datastream
@@ -79,6 +148,35 @@ int data_string_to_binaryDS(const unsigned char data_string[24+1],  // sujets 3a
 
 void binaryDS_to_packedbyteDS(const unsigned char binaryDS[24*8], unsigned char packedbyteDS[24],unsigned short int version); // sujets 3a,b,c ! recompaction en bloc de 8 (sauf M1/M3 qui comportent 1 bloc de 4
 // pour écriture sur le QRCODE avec put_byte_in_block
+
+// code correcteur d'erreur Reed-Solomon (GF(256), polynome 0x11D)
+void ajoute_correction_packedbyteDS(unsigned char packedbyteDS[24], unsigned short int version); // sujets 3 (complement) : calcule et ajoute les octets de correction apres les octets de données
+
+// ecriture directe du flux binaire en octets (packedbyteDS), sans passer par le binaryDS 1 octet par bit
+typedef struct
+{
+    uint64_t accumulateur;          /** bits en attente d'ecriture, alignés sur le poids faible       */
+    int nb_bits_accu;               /** nombre de bits en attente dans l'accumulateur (< 32)          */
+    int nb_bits;                    /** nombre total de bits ecrits dans le flux                      */
+    int index_octet;                /** prochain octet a ecrire dans packedbyteDS                     */
+    unsigned char *packedbyteDS;    /** octets de sortie (24 au maximum pour un M4)                   */
+} QRflux_t;
+
+void demarre_flux(QRflux_t *flux, unsigned char packedbyteDS[24]);                       // sujets 3 (complement) : prepare l'ecriture d'un flux dans packedbyteDS
+void ecrit_bits_flux(QRflux_t *flux, uint32_t valeur, int nb_bits);                       // sujets 3 (complement) : ajoute les nb_bits (<=32) de poids faible de valeur
+int  ecrit_entete_flux(QRflux_t *flux, unsigned short int version, unsigned short int mode, int nb_caracteres); // sujets 3 (complement) : indicateur de mode + nombre de caracteres
+int  termine_flux(QRflux_t *flux, unsigned short int version);                            // sujets 3 (complement) : terminateur, bourrage 0xEC/0x11, demi-octet M1/M3
+int  flux_to_binaryDS(const QRflux_t *flux, unsigned char binaryDS[24*8]);                // sujets 3 (complement) : recopie les bits du flux (non terminé) en binaryDS, 1 octet par bit
+int  numeric_to_flux( const unsigned char *data_string, int longueur, QRflux_t *flux, unsigned short int version); // sujets 3 (complement) : mode numerique direct en octets
+int  alphanum_to_flux(const unsigned char *data_string, int longueur, QRflux_t *flux, unsigned short int version); // sujets 3 (complement) : mode alphanum direct en octets
+int  ascii_to_flux(   const unsigned char *data_string, int longueur, QRflux_t *flux, unsigned short int version); // sujets 3 (complement) : mode ascii direct en octets
+int  kanji_to_flux(   const unsigned char *data_string, int longueur, QRflux_t *flux, unsigned short int version); // sujets 3 (complement) : mode kanji (chaine UTF-8) direct en octets
+int  data_string_to_packedbyteDS(const unsigned char *data_string, int longueur,   // sujets 3 (complement) : aiguillage + terminaison, sans binaryDS
+                                 unsigned char packedbyteDS[24],
+                                 unsigned short int version,
+                                 unsigned short int mode );
+int  mixte_to_flux(   const unsigned char *data_string, int longueur, QRflux_t *flux, unsigned short int version, unsigned short int modes); // sujets 3 (complement) : segments de modes différents, découpage optimal
+int  choisit_version_QRcode(const unsigned char *data_string, int longueur, unsigned short int mode, int niveau_min); // sujets 3 (complement) : plus petite version qui contient la chaine
 // /////////////////// SUJETS 4   ////////////////////////////////////////////
 // definition des 4+1 types de blocks de 8 modules dans un microqrcode
 #define UP 1                      /** orientation de bas en haut (UP)   pour un block de 8 bits */
@@ -88,23 +186,115 @@ void binaryDS_to_packedbyteDS(const unsigned char binaryDS[24*8], unsigned char
 #define US 5                      /** Up Special pour bloc de 4 bits n°3 M1, blocs n°9 et 13 M3 */
 
 // ecriture d'un bloc de 8 modules a un emplacement donné (et direction donnée UP/DN/UL,DL, US ... )
-void put_byte_in_blocks(unsigned char qrcode[NB_MODULE][NB_MODULE],unsigned char byte,      // Sujets 4 (commun a toutes les versions M1/M2/M3/M4)
+void put_byte_in_blocks(QRcode_t *qrcode,unsigned char byte,      // Sujets 4 (commun a toutes les versions M1/M2/M3/M4)
                         unsigned char lig, unsigned char col, unsigned char direction);
 
 // fonctions spécifiques à l'ecriture du datastream dans la zone de donnée des QR code
-void ajoute_dataM1_QRcode( const unsigned char packedbyteDS[24], unsigned char qrcode[NB_MODULE][NB_MODULE]); // Sujet4/M1  : ajoute les données (packed) a un QR code de type M1
-void ajoute_dataM2_QRcode( const unsigned char packedbyteDS[24], unsigned char qrcode[NB_MODULE][NB_MODULE]); // Sujet4/M2  : ajoute les données (packed) a un QR code de type M2
-void ajoute_dataM3L_QRcode(const unsigned char packedbyteDS[24], unsigned char qrcode[NB_MODULE][NB_MODULE]); // HORS SUJET : ajoute les données (packed) a un QR code de type M3L
-void ajoute_dataM3M_QRcode(const unsigned char packedbyteDS[24], unsigned char qrcode[NB_MODULE][NB_MODULE]); // HORS SUJET : ajoute les données (packed) a un QR code de type M3M
-void ajoute_dataM4_QRcode( const unsigned char packedbyteDS[24], unsigned char qrcode[NB_MODULE][NB_MODULE]); // Sujet4/M4  : ajoute les données (packed) a un QR code de type M4
+void ajoute_dataM1_QRcode( const unsigned char packedbyteDS[24], QRcode_t *qrcode); // Sujet4/M1  : ajoute les données (packed) a un QR code de type M1
+void ajoute_dataM2_QRcode( const unsigned char packedbyteDS[24], QRcode_t *qrcode); // Sujet4/M2  : ajoute les données (packed) a un QR code de type M2
+void ajoute_dataM3L_QRcode(const unsigned char packedbyteDS[24], QRcode_t *qrcode); // HORS SUJET : ajoute les données (packed) a un QR code de type M3L
+void ajoute_dataM3M_QRcode(const unsigned char packedbyteDS[24], QRcode_t *qrcode); // HORS SUJET : ajoute les données (packed) a un QR code de type M3M
+void ajoute_dataM4_QRcode( const unsigned char packedbyteDS[24], QRcode_t *qrcode); // Sujet4/M4  : ajoute les données (packed) a un QR code de type M4
+
+// placement commun a toutes les versions par une table précalculée (bit n° k du flux -> module)
+void ajoute_data_QRcode(const unsigned char packedbyteDS[24], QRcode_t *qrcode);   // Sujet4 (complement) : ajoute données + correction (packed) quelle que soit la version
+
+// /////////////////// ENCODAGE COMPLET ET PAR LOTS ////////////////////////
+// un qrcode complet : données -> correction -> placement -> masquage
+int encode_QRcode(const unsigned char *data_string, int longueur,           // encode une chaine dans un qrcode complet, retourne le n° de masque ou -1
+                  unsigned short int version, unsigned short int mode,
+                  int no_masque, QRcode_t *qrcode);
+
+// une demande d'encodage (element d'un lot)
+typedef struct
+{
+    const unsigned char *data_string;   /** chaine a encoder                          */
+    int longueur;                        /** nombre d'octets de la chaine              */
+    unsigned short int version;          /** version parmi M1_ ... M4_Q, ou VERSION_AUTO | niveau minimal */
+    unsigned short int mode;             /** mode parmi NUMERIC, ALPHANUM, ASCII, KANJI, ou MODE_AUTO     */
+} QRdemande_t;
+
+// traitement parallele : un pool de threads avec vol de travail (work stealing)
+typedef void (*QRtache_t)(int index, void *contexte);                                        // tache a executer pour l'element n° index
+int  nb_coeurs(void);                                                                         // nombre de coeurs de la machine
+int  parallele_pour(int nb, int nb_threads, QRtache_t tache, void *contexte);                // execute tache(0..nb-1) sur nb_threads threads (0 = nb_coeurs())
+int  encode_lot_QRcode(const QRdemande_t *demandes, int nb, QRcode_t *qrcodes, int *masques, // encode nb demandes dans qrcodes[0..nb-1] (dans l'ordre)
+                       int no_masque, int nb_threads,
+                       void (*rendu)(const QRcode_t *qrcode, int index, void *contexte), void *contexte);
+
+// /////////////////// MODE FLUX (ligne de commande) ///////////////////////
+// les données sont lues sur l'entrée standard, les images ecrites a la suite sur la sortie standard
+#define FORMAT_PBM   0      /** PBM binaire (P4) : 1 bit par pixel, 1 = NOIR                 */
+#define FORMAT_PGM   1      /** PGM binaire (P5) : 1 octet par pixel                         */
+#define FORMAT_RAW   2      /** bitmap brut sans entete : 1 octet par pixel (NOIR / BLANC)   */
+#define FORMAT_BITMAP 3     /** bitmap brut sans entete : 1 bit par pixel (comme PBM P4)     */
+#define FORMAT_PNG   4      /** PNG en niveaux de gris sur 1 bit                             */
+#define FORMAT_TIFF  5      /** TIFF bilevel compressé CCITT groupe 4                        */
+#define FORMAT_SVG   6      /** SVG : un chemin, un sous-chemin par plage de modules noirs   */
+#define FORMAT_PDF   7      /** PDF d'une page (echelle en points par module)                */
+#define FORMAT_ZPL   8      /** etiquette ZPL, ^GFA en hexadécimal compressé                 */
+#define FORMAT_Z64   9      /** etiquette ZPL, ^GFA en Z64 (base64 du zlib)                  */
+#define FORMAT_ESCPOS 10    /** commandes raster ESC/POS GS v 0                              */
+
+int  QRcode_to_image_memoire(const QRcode_t *qrcode, int format,            // ecrit l'image (PBM/PGM/RAW/BITMAP/PNG/TIFF/SVG/PDF/ZPL/ESCPOS) d'un QRcode dans un tableau, retourne sa taille ou -1
+                             int echelle, int zone_blanche, unsigned char *image, int taille_max);
+int  flux_QRcode(FILE *entree, FILE *sortie, unsigned short int version,    // encode chaque donnée de entree (lignes ou longueur+données) en image sur sortie
+                 unsigned short int mode, int format, int echelle, int zone_blanche, int longueur_prefixee);
+int  main_flux(int argc, char *argv[]);                                      // analyse les options de la ligne de commande et lance flux_QRcode
 
 ////////////////////////////ROUTINES d'AFFFICHAGE ET DE TEST FOURNIES /////////////////////////////////////
 // routines pour creer le fichier image en mode PGM (portable gray map) ou PPN (portable pixmap
-int  QRcode_to_pgm(const unsigned char qrcode[NB_MODULE][NB_MODULE], char *filename);                          // code C fourni :ecrit un QRcode dans un fichier PGM (couleur)
-int  QRcode_to_ppm(const unsigned char qrcode[NB_MODULE][NB_MODULE], char *filename, unsigned long int color); // code C fourni : ecrit un QRcode dans un fichier PPM (N&B)
+int  QRcode_to_pgm(const QRcode_t *qrcode, char *filename);                          // code C fourni :ecrit un QRcode dans un fichier PGM (couleur)
+int  QRcode_to_ppm(const QRcode_t *qrcode, char *filename, unsigned long int color); // code C fourni : ecrit un QRcode dans un fichier PPM (N&B)
+void fixe_rendu_QRcode(int echelle, int zone_blanche);                                                                // fixe la taille d'un module en pixels et la zone blanche de QRcode_to_pgm/ppm
+int  QRcode_to_pgm_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche,                                      // ecrit le PGM dans un tableau, retourne sa taille ou -1
+                           unsigned char *image, int taille_max);
+int  QRcode_to_ppm_memoire(const QRcode_t *qrcode, unsigned long int color, int echelle, int zone_blanche,              // ecrit le PPM dans un tableau, retourne sa taille ou -1
+                           unsigned char *image, int taille_max);
+
+// routines pour creer une image a 1 bit par pixel (1 = NOIR), echelle pixels par module, entourée de zone_blanche modules blancs
+int  QRcode_to_pbm(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche);                          // ecrit un QRcode dans un fichier PBM (P4)
+int  QRcode_to_bitmap(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche);                       // ecrit un QRcode dans un fichier bitmap brut (sans entete)
+int  QRcode_to_pbm_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max);    // ecrit le PBM dans un tableau, retourne sa taille ou -1
+int  QRcode_to_bitmap_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max); // ecrit le bitmap dans un tableau, retourne sa taille ou -1
+
+// rendu direct dans une page (framebuffer) fournie par l'appelant, sans allocation ni copie
+#define PIXEL_GRIS8   0     /** 1 octet par pixel : NOIR / BLANC                          */
+#define PIXEL_RGB24   1     /** 3 octets par pixel : R, G, B                              */
+#define PIXEL_RGBA32  2     /** 4 octets par pixel : R, G, B, A (A = 255)                 */
+#define PIXEL_1BIT    3     /** 1 bit par pixel, poids fort a gauche, 1 = NOIR            */
+int  QRcode_to_page(const QRcode_t *qrcode, unsigned char *page, int largeur_page, int hauteur_page,  // dessine un QRcode (et sa zone blanche) a la position x0,y0 d'une page
+                    int pas, int format_pixel, int x0, int y0, int echelle, int zone_blanche);
+
+// planche (atlas) : nb QRcodes sur une grille dans une seule image PGM ou PBM, rendus en parallele directement dans le fichier
+int  atlas_QRcode(const char *filename, const QRcode_t *qrcodes, int nb, int colonnes,       // ecrit une planche de nb QRcodes, colonnes par ligne
+                  int format, int echelle, int zone_blanche, int nb_threads);
+
+// export PNG (niveaux de gris sur 1 bit) avec CRC32 et deflate intégrés
+int  QRcode_to_png(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche);                          // ecrit un QRcode dans un fichier PNG
+int  QRcode_to_png_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max);    // ecrit le PNG dans un tableau, retourne sa taille ou -1
+
+// export TIFF bilevel compressé CCITT groupe 4, codé directement a partir des modules
+int  QRcode_to_tiff(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche);                         // ecrit un QRcode dans un fichier TIFF G4
+int  QRcode_to_tiff_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max);   // ecrit le TIFF dans un tableau, retourne sa taille ou -1
+
+// export vectoriel (une forme par plage horizontale de modules noirs) : SVG, PDF d'une page, planches d'etiquettes en PDF
+int  QRcode_to_svg(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche);                          // ecrit un QRcode dans un fichier SVG (echelle en pixels par module)
+int  QRcode_to_svg_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max);    // ecrit le SVG dans un tableau, retourne sa taille ou -1
+int  QRcode_to_pdf(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche);                          // ecrit un QRcode dans un fichier PDF (echelle en points par module)
+int  QRcode_to_pdf_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max);    // ecrit le PDF dans un tableau, retourne sa taille ou -1
+int  etiquettes_pdf_QRcode(const char *filename, const QRcode_t *qrcodes, int nb, int colonnes, int lignes,    // ecrit nb QRcodes dans un PDF, colonnes x lignes etiquettes par page
+                           int echelle, int zone_blanche);
+
+// commandes d'imprimantes thermiques, construites a partir des modules (echelle en points d'imprimante par module)
+int  QRcode_to_zpl(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche, int z64);                 // ecrit une etiquette ZPL (^GFA hexadécimal compressé, ou Z64 si z64)
+int  QRcode_to_zpl_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, int z64,                         // ecrit l'etiquette ZPL dans un tableau, retourne sa taille ou -1
+                           unsigned char *image, int taille_max);
+int  QRcode_to_escpos(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche);                       // ecrit les commandes raster ESC/POS (GS v 0)
+int  QRcode_to_escpos_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max); // ecrit les commandes ESC/POS dans un tableau, retourne leur taille ou -1
 
 // affichages console qrcode/chaine a encoder/binarystrema
-void QRcode_to_console(    const unsigned char qrcode[NB_MODULE][NB_MODULE]);                   // code C fourni : affiche un QRcode sur la console
+void QRcode_to_console(    const QRcode_t *qrcode);                   // code C fourni : affiche un QRcode sur la console
 void datastring_to_console(const unsigned char datastring[]);                                   // code C fourni : affiche une datastring sur la console
 void binaryDS_to_console(  const unsigned char binaryDS[]);                                     // code C fourni : affiche une bianry DataString  sur la console
 void packedbyte_to_console(const unsigned char packedbyteDS[]);                                  // code C fourni : affiche une packedbinary sur la console
@@ -122,16 +312,21 @@ void test_unitaire_sujet4(void);
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief le MAIN !!!!
+/// sans argument : les tests unitaires ; avec des arguments : le mode flux (voir main_flux)
 
-int main(void)
+int main(int argc, char *argv[])
 {
+    if(argc > 1)
+    {
+        return main_flux(argc, argv);
+    }
 
     test_unitaire_sujet0();
 
-    //test_unitaire_sujet1();
+    test_unitaire_sujet1();
     test_unitaire_sujet2();
-    //test_unitaire_sujet3();
-    //test_unitaire_sujet4();
+    test_unitaire_sujet3();
+    test_unitaire_sujet4();
 
     return 0;
 }
@@ -142,26 +337,26 @@ int main(void)
 ///
 void test_unitaire_sujet0(void)
 {
-    unsigned char MicroQRcode[NB_MODULE][NB_MODULE];  // le microQRcode sans la Quiet ZONE
+    QRcode_t MicroQRcode;  // le microQRcode sans la Quiet ZONE
     // effacement du microQRcode ==>100% BLANC et verification
-    efface_QRcode(MicroQRcode);
+    cree_QRcode(&MicroQRcode, M1_);
     //printf("\nTest unitaire 0 : MicroQRcode 100% BLANC \n");
-    //QRcode_to_console(MicroQRcode);
+    //QRcode_to_console(&MicroQRcode);
 
     // affichage a la console du QRcode
     printf("\n **");
     printf("\n Test unitaire 0 : MicroQRcode non initialisé \n");
-    QRcode_to_console(MicroQRcode);
+    QRcode_to_console(&MicroQRcode);
 
 
     // initialisation eu microQRcode (finder patterne + synchro pattern) + verification
-    initialise_QRcode(MicroQRcode);
+    initialise_QRcode(&MicroQRcode);
 
     printf("\nTest unitaire 0 : MicroQRcode initialisé ave ses finder et synchronous patterns \n");
-    QRcode_to_console(MicroQRcode);
+    QRcode_to_console(&MicroQRcode);
     printf("\n Test unitaire 0 : Export du microQRcode dans images/Mon_premierQRcode.pgm\n");
-    QRcode_to_pgm(MicroQRcode,"Images/Mon_premierQRcode.pgm");
-    //QRcode_to_ppm( MicroQRcode, "Images/Mon_premierQRcode.pgm",0x00FF0000);  // en rouge
+    QRcode_to_pgm(&MicroQRcode,"Images/Mon_premierQRcode.pgm");
+    //QRcode_to_ppm(&MicroQRcode, "Images/Mon_premierQRcode.pgm",0x00FF0000);  // en rouge
 
     printf("\n** fin Test unitaire 0 **");
     printf("\n***\n\n\n");
@@ -173,12 +368,17 @@ void test_unitaire_sujet0(void)
 ///
 void test_unitaire_sujet1(void)
 {
-    unsigned char MicroQRcode[NB_MODULE][NB_MODULE];  // le microQRcode sans la Quiet ZONE
+    QRcode_t MicroQRcode;  // le microQRcode sans la Quiet ZONE
     unsigned short int mode_microQRcode = M4_L ;    // choix du mode (
     unsigned short int mask_number = 2;             // choix du n° de MASK
     unsigned short int header15bits_microQRcode  ;  // header = mode + numero de masque + 10 bits BCH = 15 bits
 
-    // A COMPLETER
+    cree_QRcode(&MicroQRcode, mode_microQRcode);
+    initialise_QRcode(&MicroQRcode);
+    header15bits_microQRcode = encode_version(mode_microQRcode, mask_number);
+    printf("\nTest unitaire 1 : entete 15 bits de M4_L masque 2 = 0x%04X (attendu 0x1D5B)\n", header15bits_microQRcode);
+    ajoute_version_QRcode(&MicroQRcode, header15bits_microQRcode);
+    QRcode_to_console(&MicroQRcode);
 }
 
 ///////////////////////////////////////////////////////////
@@ -188,28 +388,30 @@ void test_unitaire_sujet1(void)
 void test_unitaire_sujet2(void)
 {
     printf("Void test_unitaire_sujet2\n\n\n");
-    unsigned char MicroQRcode[NB_MODULE][NB_MODULE];  // le microQRcode sans la Quiet ZONE
-    unsigned char MicroQRmask[NB_MODULE][NB_MODULE];  // le mask
+    QRcode_t MicroQRcode;  // le microQRcode sans la Quiet ZONE
+    QRcode_t MicroQRmask;  // le mask
+    QRbits_t MicroQRbits;  // le microQRcode compacté (1 bit par module)
     unsigned short int mode_microQRcode = M4_L ;    // choix du mode
     unsigned short int mask_number = 0;             // choix du n° de MASK
     int score, score_max =0, mask; //Initialisation des
     //fonctions score, score_max et mask
 
-    efface_QRcode(MicroQRmask); //Effacement du MicroQRmask afin
+    cree_QRcode(&MicroQRcode, mode_microQRcode);
+    cree_QRcode(&MicroQRmask, mode_microQRcode); //Effacement du MicroQRmask afin
     //de pouvoir en généré un sans problème de génération
     printf("\n\n\n**********Selection du meilleur mask**********************\n\n\n\n");
 
     for(mask_number=0; mask_number<=3; mask_number++) //Boucle permettant de générer
     {
         //tout les masques avec leurs QRCODES afin de sélectionner le mask meilleur mask.
-        genere_QRmask(MicroQRmask,mask_number);
-        efface_QRcode(MicroQRcode);
-        initialise_QRcode(MicroQRcode);
-        xor_QRcode_QRmask(MicroQRcode, MicroQRmask);
+        genere_QRmask(&MicroQRmask,mask_number);
+        efface_QRcode(&MicroQRcode);
+        initialise_QRcode(&MicroQRcode);
+        xor_QRcode_QRmask(&MicroQRcode, &MicroQRmask);
 
         printf("*********************Score masque numéro %d******************\n\n\n", mask_number);
         //Affichage des différents scores de chaque masque.
-        score = score_masquage_QRcode(MicroQRcode);
+        score = score_masquage_QRcode(&MicroQRcode);
         printf("\nscore du masque %d : \n", score);
         //Maintenant réalisons une boucle mémorisant le score le plus grand
         if(score>=score_max)
@@ -230,15 +432,24 @@ void test_unitaire_sujet2(void)
     printf("\nMeilleur mask : %d \nScore atteint : %d", mask, score_max);
 
     printf("\n\n\n****************Génération QRCODE final**************");
-    genere_QRmask(MicroQRmask,mask);
+    genere_QRmask(&MicroQRmask,mask);
     printf("\n\n\n*************Affichage QRCODE sur la console****************\n");
-    QRcode_to_console(MicroQRmask);
-    efface_QRcode(MicroQRcode);
-    initialise_QRcode(MicroQRcode);
-    xor_QRcode_QRmask(MicroQRcode, MicroQRmask);
-    QRcode_to_console(MicroQRcode);
+    QRcode_to_console(&MicroQRmask);
+    efface_QRcode(&MicroQRcode);
+    initialise_QRcode(&MicroQRcode);
+    xor_QRcode_QRmask(&MicroQRcode, &MicroQRmask);
+    QRcode_to_console(&MicroQRcode);
+
+    // meme score avec la representation compacte (1 bit par module)
+    QRcode_to_QRbits(&MicroQRcode, &MicroQRbits);
+    printf("\nScore en representation compacte : %d (attendu %d)\n", score_masquage_QRbits(&MicroQRbits), score_max);
+
+    // meme choix sans construire les 4 qrcodes masqués
+    efface_QRcode(&MicroQRcode);
+    initialise_QRcode(&MicroQRcode);
+    printf("\nMasque choisi sans construire les 4 QRcodes : %d (attendu %d)\n", choisit_masque_QRcode(&MicroQRcode, MASQUE_AUTO), mask);
     printf("\n Test unitaire 2 : Export du microQRcode dans images/Mon_premierQRcode.pgm\n");
-    QRcode_to_pgm(MicroQRcode,"Images/Mon_premierQRcode.pgm");
+    QRcode_to_pgm(&MicroQRcode,"Images/Mon_premierQRcode.pgm");
 }
 
 ///////////////////////////////////////////////////////////
@@ -258,10 +469,175 @@ void test_unitaire_sujet3(void)
     unsigned char packedbyteDS[24];      //Flux binaire compacté en paquet de 8 bits (initalisé uniquement pour les tests)
     unsigned short int mode_microQRcode = M4_L ;    // choix du mode (
     unsigned short int mask_number = 2;             // choix du n° de MASK
+    int i;
 
     printf("Affichage de la binary data string \n ");
     binaryDS_to_console(binaryDS);
     // A COMPLETER
+
+    // flux en octets et code correcteur : exemple de l'ISO18004/2015 ("01234567" en M2_L)
+    // octets de données attendus : 0x40 0x18 0xAC 0xC3 0x00
+    // octets de correction attendus : 0x86 0x0D 0x22 0xAE 0x30
+    unsigned char packed_iso[24];
+    unsigned char chaine_iso[24+1] = "01234567";
+    unsigned char chaine_numerique[24+1] = "534956";
+    unsigned char chaine_alphanum[24+1] = "TEXTE +/1234";
+    unsigned char chaine_mixte[24+1] = "AB-123456789";
+    unsigned char chaine_kanji[24+1] = "\xE7\x82\xB9\xE8\x8C\x97";      // "点茗" en UTF-8 (Shift-JIS 0x935F 0xE4AA)
+    QRflux_t flux;
+    demarre_flux(&flux, packed_iso);
+    ecrit_entete_flux(&flux, M2_L, NUMERIC, 8);
+    ecrit_bits_flux(&flux, 12, 10);     // "012"
+    ecrit_bits_flux(&flux, 345, 10);    // "345"
+    ecrit_bits_flux(&flux, 67, 7);      // "67"
+    termine_flux(&flux, M2_L);
+    printf("\nOctets de données M2_L de l'exemple ISO (attendu 0x40 0x18 0xac 0xc3 0x0) :\n");
+    for(i=0; i<5; i++)
+    {
+        printf("0x%x ", packed_iso[i]);
+    }
+    ajoute_correction_packedbyteDS(packed_iso, M2_L);
+    printf("\nCode correcteur M2_L de l'exemple ISO (attendu 0x86 0xd 0x22 0xae 0x30) :\n");
+    for(i=5; i<10; i++)
+    {
+        printf("0x%x ", packed_iso[i]);
+    }
+    putchar('\n');
+
+    // le meme exemple par l'encodeur numerique
+    data_string_to_packedbyteDS(chaine_iso, 8, packed_iso, M2_L, NUMERIC);
+    printf("Octets de données de \"01234567\" par numeric_to_flux (attendu 0x40 0x18 0xac 0xc3 0x0) :\n");
+    for(i=0; i<5; i++)
+    {
+        printf("0x%x ", packed_iso[i]);
+    }
+    printf("\nEncodage numerique de \"%s\" en M4_L (%d bits) :", chaine_numerique, numeric_to_binaryDS(chaine_numerique, binaryDS, M4_L));
+    binaryDS_to_console(binaryDS);
+    printf("\nEncodage alphanumerique de \"%s\" en M4_L (%d bits) :", chaine_alphanum, alphanum_to_binaryDS(chaine_alphanum, binaryDS, M4_L));
+    binaryDS_to_console(binaryDS);
+    printf("\nEncodage octets de \"%s\" en M4_L (%d bits) :", data_string, ascii_to_binaryDS(data_string, binaryDS, M4_L));
+    binaryDS_to_console(binaryDS);
+
+    // découpage automatique : "AB-" en alphanum puis 9 chiffres (23+37 = 60 bits en M3) au lieu de 12 caracteres alphanum (72 bits)
+    // la chaine passe ainsi de M3_L (84 bits) a M3_M (68 bits), meme taille mais mieux corrigée
+    printf("\nEncodage alphanumerique de \"%s\" en M3_L : %d bits, par segments : %d bits (attendu 72 et 60)\n", chaine_mixte,
+           alphanum_to_binaryDS(chaine_mixte, binaryDS, M3_L), data_string_to_binaryDS(chaine_mixte, binaryDS, M3_L, MODE_AUTO));
+    printf("Plus petite version : %d en alphanum, %d par segments (attendu %d et %d)\n",
+           choisit_version_QRcode(chaine_mixte, 12, ALPHANUM, NIVEAU_DETECTION),
+           choisit_version_QRcode(chaine_mixte, 12, MODE_AUTO, NIVEAU_DETECTION), M3_L, M3_M);
+
+    // exemple de l'ISO18004/2015 (§7.4.6) : 2 caracteres kanji de valeurs 0x0D9F et 0x1AAA sur 13 bits
+    printf("Encodage kanji de \"%s\" en M3_L (%d bits, attendu 11 010 0110110011111 1101010101010) :", chaine_kanji,
+           data_string_to_binaryDS(chaine_kanji, binaryDS, M3_L, KANJI));
+    binaryDS_to_console(binaryDS);
+}
+
+///////////////////////////////////////////////////////////
+///\fn static int test_flux(const unsigned char *octets_entree, int taille_entree, int longueur_prefixee, const char *donnees[], int nb, int *nb_erreurs)
+///\brief passe octets_entree dans le mode flux (M2_L, numerique, PBM) et compare la sortie aux images des nb donnees attendues
+///\return 1 si la sortie est identique, 0 si non
+static int test_flux(const unsigned char *octets_entree, int taille_entree, int longueur_prefixee,
+                     const char *donnees[], int nb, int *nb_erreurs)
+{
+    unsigned char attendu[1024], obtenu[1024 + 1];
+    QRcode_t qrcode;
+    FILE *entree = tmpfile();
+    FILE *sortie = tmpfile();
+    int k, taille = 0, nb_lus = -1;
+
+    *nb_erreurs = -1;
+    if(entree != NULL && sortie != NULL)
+    {
+        fwrite(octets_entree, 1, taille_entree, entree);
+        rewind(entree);
+        *nb_erreurs = flux_QRcode(entree, sortie, M2_L, NUMERIC, FORMAT_PBM, 1, ZONE_BLANCHE, longueur_prefixee);
+        for(k=0; k<nb; k++)
+        {
+            encode_QRcode((const unsigned char *)donnees[k], (int)strlen(donnees[k]), M2_L, NUMERIC, MASQUE_AUTO, &qrcode);
+            taille += QRcode_to_image_memoire(&qrcode, FORMAT_PBM, 1, ZONE_BLANCHE, attendu + taille, (int)sizeof(attendu) - taille);
+        }
+        rewind(sortie);
+        nb_lus = (int)fread(obtenu, 1, sizeof(obtenu), sortie);
+    }
+    if(entree != NULL)
+    {
+        fclose(entree);
+    }
+    if(sortie != NULL)
+    {
+        fclose(sortie);
+    }
+    return nb_lus == taille && memcmp(obtenu, attendu, taille) == 0;
+}
+
+static void QRcode_to_gris(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *pixels);   // voir les exports d'images
+
+///////////////////////////////////////////////////////////
+///\fn static int test_page(const QRcode_t *qrcode, int format_pixel, int x0, int y0)
+///\brief dessine le QRcode (echelle 2, zone blanche) en x0, y0 dans une page 40x40 préremplie d'un motif différent a chaque
+///       ligne, puis compare chaque pixel a QRcode_to_gris dans le QRcode et au motif en dehors (PIXEL_GRIS8 ou PIXEL_1BIT)
+///\return le nombre de pixels faux, -1 si QRcode_to_page echoue
+static int test_page(const QRcode_t *qrcode, int format_pixel, int x0, int y0)
+{
+    unsigned char gris[(NB_MODULE_MAX + 2*ZONE_BLANCHE) * 2 * (NB_MODULE_MAX + 2*ZONE_BLANCHE) * 2];
+    unsigned char page[40 * 40];
+    int largeur = (qrcode->nb_module + 2*ZONE_BLANCHE) * 2;
+    int pas = (format_pixel == PIXEL_1BIT) ? 40 / 8 : 40;
+    int x, y, pixel, attendu, nb_faux = 0;
+
+    QRcode_to_gris(qrcode, 2, ZONE_BLANCHE, gris);
+    for(y=0; y<40; y++)
+    {
+        memset(page + y*pas, (0xA5 + 7*y) & 0xFF, pas);    // les bits voisins different d'une ligne a l'autre
+    }
+    if(QRcode_to_page(qrcode, page, 40, 40, pas, format_pixel, x0, y0, 2, ZONE_BLANCHE) != 0)
+    {
+        return -1;
+    }
+    for(y=0; y<40; y++)
+    {
+        for(x=0; x<40; x++)
+        {
+            if(format_pixel == PIXEL_1BIT)
+            {
+                pixel   = (page[y*pas + x/8] >> (7 - x%8)) & 1;
+                attendu = (((0xA5 + 7*y) & 0xFF) >> (7 - x%8)) & 1;
+            }
+            else
+            {
+                pixel   = page[y*pas + x];
+                attendu = (0xA5 + 7*y) & 0xFF;
+            }
+            if(x >= x0 && x < x0 + largeur && y >= y0 && y < y0 + largeur)
+            {
+                attendu = gris[(y - y0)*largeur + (x - x0)];
+                if(format_pixel == PIXEL_1BIT)
+                {
+                    attendu = (attendu == NOIR);
+                }
+            }
+            nb_faux += (pixel != attendu);
+        }
+    }
+    return nb_faux;
+}
+
+///////////////////////////////////////////////////////////
+///\fn static int lit_fichier(const char *filename, unsigned char *octets, int taille_max)
+///\brief relit un fichier ecrit par un test (au plus taille_max octets)
+///\return le nombre d'octets lus, -1 si le fichier ne s'ouvre pas
+static int lit_fichier(const char *filename, unsigned char *octets, int taille_max)
+{
+    FILE *fichier = fopen(filename, "rb");
+    int nb_lus;
+
+    if(fichier == NULL)
+    {
+        return -1;
+    }
+    nb_lus = (int)fread(octets, 1, taille_max, fichier);
+    fclose(fichier);
+    return nb_lus;
 }
 
 ///////////////////////////////////////////////////////////
@@ -270,71 +646,182 @@ void test_unitaire_sujet3(void)
 ///
 void test_unitaire_sujet4(void)
 {
-    unsigned char MicroQRcode[NB_MODULE][NB_MODULE];  // le microQRcode sans la Quiet ZONE
+    QRcode_t MicroQRcode;  // le microQRcode sans la Quiet ZONE
     unsigned char packedbyteDS[24] = {0xFF,0xAA,0xFE,0x11,0x00,0x53,0x72,0xF0,0xFE};
 
     unsigned short int mode_microQRcode = M4_L ;    // choix du mode (
+    int mask_number;
+    QRdemande_t demandes[64];               // encodage par lots
+    unsigned char chaines[64][8];
+    QRcode_t lot[64], seul;
+    int masques[64];
+    int i, nb_erreurs, nb_differents;
+    static const char *donnees_flux[3] = { "12345", "678", "90" };     // mode flux
+    static const unsigned char lignes_flux[] = "12345\n678\r\n90";     // \n, \r\n, derniere ligne sans \n
+    unsigned char prefixe_flux[4*5 + 5 + 4097 + 3 + 2 + 2];
+    int taille_prefixe;
+    QRcode_t planche_codes[3];              // planche (atlas) de versions mélangées
+    unsigned char planche[2048], gris[21*21];
+    int retour_pgm, retour_pbm, taille_pgm, taille_pbm, k, y;
 
-    // A COMPLETER
-    printf("Un block de 8 bits ecrit dans le QRcode ");
-    QRcode_to_console(MicroQRcode);
+    // patterns + format, puis données + correction, puis masquage et mise a jour du format
+    demarre_QRcode(&MicroQRcode, mode_microQRcode, 0);
+    ajoute_correction_packedbyteDS(packedbyteDS, mode_microQRcode);
+    ajoute_data_QRcode(packedbyteDS, &MicroQRcode);
+    printf("Les octets de données et de correction ecrits dans le QRcode (non masqué) ");
+    QRcode_to_console(&MicroQRcode);
+
+    mask_number = choisit_masque_QRcode(&MicroQRcode, MASQUE_AUTO);
+    ajoute_version_QRcode(&MicroQRcode, encode_version(mode_microQRcode, mask_number));
+    printf("Le QRcode final avec le masque %d ", mask_number);
+    QRcode_to_console(&MicroQRcode);
+    printf("\n Test unitaire 4 : Export du microQRcode dans images/Mon_premierQRcode.pgm\n");
+    QRcode_to_pgm(&MicroQRcode,"Images/Mon_premierQRcode.pgm");
+    printf(" et en 1 bit par pixel, avec la zone blanche de 2 modules, dans images/Mon_premierQRcode.pbm\n");
+    QRcode_to_pbm(&MicroQRcode,"Images/Mon_premierQRcode.pbm", PIX_BY_MODULE, ZONE_BLANCHE);
+    printf(" et en PNG dans images/Mon_premierQRcode.png\n");
+    QRcode_to_png(&MicroQRcode,"Images/Mon_premierQRcode.png", PIX_BY_MODULE, ZONE_BLANCHE);
+    printf(" et en TIFF G4 dans images/Mon_premierQRcode.tif\n");
+    QRcode_to_tiff(&MicroQRcode,"Images/Mon_premierQRcode.tif", PIX_BY_MODULE, ZONE_BLANCHE);
+    printf(" et en vectoriel dans images/Mon_premierQRcode.svg et images/Mon_premierQRcode.pdf\n");
+    QRcode_to_svg(&MicroQRcode,"Images/Mon_premierQRcode.svg", PIX_BY_MODULE, ZONE_BLANCHE);
+    QRcode_to_pdf(&MicroQRcode,"Images/Mon_premierQRcode.pdf", PIX_BY_MODULE, ZONE_BLANCHE);
+    printf(" et pour les imprimantes d'etiquettes dans images/Mon_premierQRcode.zpl et images/Mon_premierQRcode.escpos\n");
+    QRcode_to_zpl(&MicroQRcode,"Images/Mon_premierQRcode.zpl", PIX_BY_MODULE, ZONE_BLANCHE, 0);
+    QRcode_to_escpos(&MicroQRcode,"Images/Mon_premierQRcode.escpos", PIX_BY_MODULE, ZONE_BLANCHE);
+    printf(" export dans un dossier inexistant : PNG %d, PBM %d (attendu -1 -1)\n",
+           QRcode_to_png(&MicroQRcode,"Dossier_inexistant/QRcode.png", PIX_BY_MODULE, ZONE_BLANCHE),
+           QRcode_to_pbm(&MicroQRcode,"Dossier_inexistant/QRcode.pbm", PIX_BY_MODULE, ZONE_BLANCHE));
+
+    // dessin dans une page 40x40 : découpé a gauche et en haut (x0 = -7), puis a droite et en bas (x0 = 13, impair :
+    // en PIXEL_1BIT les bits voisins des octets du bord doivent etre conservés)
+    printf("Dessin dans une page en gris 8 bits : %d et %d pixels faux, en 1 bit : %d et %d pixels faux (attendu 0 0 0 0)\n",
+           test_page(&MicroQRcode, PIXEL_GRIS8, -7, -3), test_page(&MicroQRcode, PIXEL_GRIS8, 13, 5),
+           test_page(&MicroQRcode, PIXEL_1BIT, -7, -3), test_page(&MicroQRcode, PIXEL_1BIT, 13, 5));
+
+    // encodage par lots sur 4 threads : chaque qrcode est a sa place et identique a celui d'un encodage seul
+    for(i=0; i<64; i++)
+    {
+        snprintf((char *)chaines[i], sizeof(chaines[i]), "%0*d", i%5 + 1, (i*7919) % 100000);
+        demandes[i].data_string = chaines[i];
+        demandes[i].longueur    = i%5 + 1;
+        demandes[i].version     = i % 8;        // M1 a M4 mélangés
+        demandes[i].mode        = NUMERIC;
+    }
+    nb_erreurs = encode_lot_QRcode(demandes, 64, lot, masques, MASQUE_AUTO, 4, NULL, NULL);
+    nb_differents = 0;
+    for(i=0; i<64; i++)
+    {
+        if(encode_QRcode(chaines[i], i%5 + 1, i % 8, NUMERIC, MASQUE_AUTO, &seul) != masques[i] ||
+           seul.version != lot[i].version || memcmp(seul.module, lot[i].module, sizeof(seul.module)) != 0)
+        {
+            nb_differents++;
+        }
+    }
+    printf("Encodage par lots de 64 chaines numeriques sur 4 threads : %d erreurs, %d qrcodes differents de l'encodage seul (attendu 0 et 0)\n",
+           nb_erreurs, nb_differents);
+
+    // mode flux : les memes images que par encode_QRcode, dans l'ordre
+    i = test_flux(lignes_flux, (int)sizeof(lignes_flux) - 1, 0, donnees_flux, 3, &nb_erreurs);
+    printf("Mode flux par lignes \"12345\\n678\\r\\n90\" : sortie %s, %d erreurs (attendu identique, 0)\n", i ? "identique" : "differente", nb_erreurs);
+    // longueur + données : "12345", une donnée de 4097 octets (ignorée), "678", "90", puis 9 octets annoncés dont 2 seulement présents
+    taille_prefixe = 0;
+    memcpy(prefixe_flux + taille_prefixe, "\0\0\0\x05" "12345", 9);
+    taille_prefixe += 9;
+    memcpy(prefixe_flux + taille_prefixe, "\0\0\x10\x01", 4);
+    memset(prefixe_flux + taille_prefixe + 4, '1', 4097);
+    taille_prefixe += 4 + 4097;
+    memcpy(prefixe_flux + taille_prefixe, "\0\0\0\x03" "678" "\0\0\0\x02" "90" "\0\0\0\x09" "12", 19);
+    taille_prefixe += 19;
+    i = test_flux(prefixe_flux, taille_prefixe, 1, donnees_flux, 3, &nb_erreurs);
+    printf("Mode flux longueur + donnees (une trop longue, une tronquee) : sortie %s, %d erreurs (attendu identique, 2)\n", i ? "identique" : "differente", nb_erreurs);
+
+    // planche de 3 QRcodes M1, M2, M4 sur 2 colonnes, echelle 1 : cases de 17+2*2 = 21 pixels,
+    // M1 et M2 centrés (zone blanche de 5 et 4 modules), 4e case blanche
+    // PGM : "P5\n42 42\n255\n" + 42*42 = 1777 octets ; PBM : lignes de 48 bits, "P4\n48 42\n" + 6*42 = 261 octets
+    encode_QRcode((const unsigned char *)"1", 1, M1_, NUMERIC, MASQUE_AUTO, &planche_codes[0]);
+    encode_QRcode((const unsigned char *)"12345", 5, M2_L, NUMERIC, MASQUE_AUTO, &planche_codes[1]);
+    encode_QRcode((const unsigned char *)"MICROQR", 7, M4_L, ALPHANUM, MASQUE_AUTO, &planche_codes[2]);
+    retour_pbm = atlas_QRcode("Images/Mes_QRcodes.pbm", planche_codes, 3, 2, FORMAT_PBM, 1, ZONE_BLANCHE, 2);
+    taille_pbm = lit_fichier("Images/Mes_QRcodes.pbm", planche, (int)sizeof(planche));
+    retour_pgm = atlas_QRcode("Images/Mes_QRcodes.pgm", planche_codes, 3, 2, FORMAT_PGM, 1, ZONE_BLANCHE, 2);
+    taille_pgm = lit_fichier("Images/Mes_QRcodes.pgm", planche, (int)sizeof(planche));
+    nb_differents = 0;
+    for(k=0; k<3 && taille_pgm == 1777; k++)
+    {
+        QRcode_to_gris(&planche_codes[k], 1, ZONE_BLANCHE + (NB_MODULE_M4 - planche_codes[k].nb_module) / 2, gris);
+        for(y=0; y<21; y++)
+        {
+            nb_differents += memcmp(planche + 13 + ((k/2)*21 + y)*42 + (k%2)*21, gris + y*21, 21) != 0;
+        }
+    }
+    printf("Planche M1/M2/M4 : PBM retour %d, %d octets ; PGM retour %d, %d octets, %d lignes de cases fausses (attendu 0 261 0 1777 0)\n",
+           retour_pbm, taille_pbm, retour_pgm, taille_pgm, nb_differents);
 }
 // FIN DES TESTS UNITAIRES
 //////////////////////////////////////////////////////////////////////////
 
 /////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////
-/// \fn void efface_QRcode(unsigned char qrcode[NB_MODULE][NB_MODULE]){
-/// \brief Sujet 0 (commun tous sujets 1,2,3,4) :  efface entierement un qrcode (ou un qrmask) et positione tous ses modules a 255 (BLANC)
-/// \param[out] qrcode[][]   qrcode (ou qrmask) a effacer
-void efface_QRcode(unsigned char qrcode[NB_MODULE][NB_MODULE])
+/// \fn int nb_module_version(unsigned short int version)
+/// \brief Sujet 0 (commun tous sujets 1,2,3,4) : largeur d'un microQRcode selon sa version
+/// \param[in] version : parmi M1_, M2_L, M2_M ... M4_Q
+/// \return NB_MODULE_M1 (11) a NB_MODULE_M4 (17)
+int nb_module_version(unsigned short int version)
 {
-//MISE A 0 DU QRCODE DONC TOUT LES MODULES EN BLANC
-    printf("reinitialisation en cour");
-    int i,j;
-    for(i=0; i<NB_MODULE; i++)
-    {
+    // M1_ -> 11, M2_L/M2_M -> 13, M3_L/M3_M -> 15, M4_L/M4_M/M4_Q -> 17
+    return (version == M4_Q) ? NB_MODULE_M4 : NB_MODULE_M1 + 2*((version+1)/2);
+}
 
-        for(j=0; j<NB_MODULE; j++)
-        {
-            qrcode[i][j]=BLANC;
-        }
-    }
+///////////////////////////////////////////////////////////////
+/// \fn void cree_QRcode(QRcode_t *qrcode, unsigned short int version)
+/// \brief Sujet 0 (commun tous sujets 1,2,3,4) : fixe la version (et donc la largeur) d'un qrcode (ou d'un qrmask) puis l'efface
+/// \param[out] qrcode   qrcode (ou qrmask) a creer
+/// \param[in]  version : parmi M1_, M2_L, M2_M ... M4_Q
+void cree_QRcode(QRcode_t *qrcode, unsigned short int version)
+{
+    qrcode->version   = version;
+    qrcode->nb_module = nb_module_version(version);
+    efface_QRcode(qrcode);
+}
 
-    printf("\nReinitialisation fini\n\n\n");
+///////////////////////////////////////////////////////////////
+/// \fn void efface_QRcode(QRcode_t *qrcode){
+/// \brief Sujet 0 (commun tous sujets 1,2,3,4) :  efface entierement un qrcode (ou un qrmask) et positione tous ses modules a 255 (BLANC)
+/// \param[out] qrcode   qrcode (ou qrmask) a effacer (sa version doit etre fixée, voir cree_QRcode)
+void efface_QRcode(QRcode_t *qrcode)
+{
+//MISE A 0 DU QRCODE DONC TOUT LES MODULES EN BLANC
+    memset(qrcode->module, BLANC, sizeof(qrcode->module));
 }
 
 ///////////////////////////////////////////////////////////////////
-/// \fn void initialise_QRcode(unsigned char qrcode[NB_MODULE][NB_MODULE]){
+/// \fn void initialise_QRcode(QRcode_t *qrcode){
 /// \brief Sujet 0 (commun tous sujets 1,2,3,4) : initialise les pattern  obligatoires d'un QRCODE
 ///             finder pattern de 7x7 module en haut a gauche
 ///            + synchonous pattern coté haut et coté gauche
 ///             le qrcode doit etre préalablement effacé (100% blanc)
-/// \param[in,out] qrcode[][]    qrcode à initialiser
+///             pour demarrer un nouveau qrcode, demarre_QRcode() recopie directement un modele complet
+/// \param[in,out] qrcode    qrcode à initialiser
 
-void initialise_QRcode(unsigned char qrcode[NB_MODULE][NB_MODULE])
+void initialise_QRcode(QRcode_t *qrcode)
 {
     int i, j=0, finder=7;
-    printf("YANN CAMPION :\n");
-    for(i=0; i<NB_MODULE; i++)
+    for(i=0; i<qrcode->nb_module; i++)
     {
-        for(j=0; j<NB_MODULE; j++)
+        for(j=0; j<qrcode->nb_module; j++)
         {
             //DECLARATION DU CONTOUR DU FINDER PATTERN
             if(i==0 &&j<=finder-1|| i==finder-1&&j<=finder-1 ||j==0 && i<=finder-1 ||j==finder-1&&i<=finder-1)
-                qrcode[i][j]=NOIR;
+                qrcode->module[i][j]=NOIR;
             //DECLARATION DU CARREE CENTRAL DU FINDER PATTERN
             if(i==2|| i==3|| i==4)
             {
                 if(j==2||j==3|| j==4)
-                    qrcode[i][j]=NOIR;
+                    qrcode->module[i][j]=NOIR;
             }//DECLARATION DU TIMING PATTERN HORIZONTAL ET VERTICALE
             if(i==0&&j>finder&&j%2==0 ||j==0&&i>finder&&i%2==0)
-                qrcode[i][j]=NOIR;
-            if(j==3&&i==8||j==9&&i==5||j==5&&i==9||j==9&&i==8)
-            {
-                qrcode[i][j]=NOIR;
-            }
+                qrcode->module[i][j]=NOIR;
 
         }
     }
@@ -342,134 +829,211 @@ void initialise_QRcode(unsigned char qrcode[NB_MODULE][NB_MODULE])
 
 }
 
-///////////////////////////////////////////////////////////////////////////
-/// \fn genere_QRmask(unsigned char qrmask[NB_MODULE][NB_MODULE],int no_masque)
-/// \brief Sujet2 : Generation des qrmask pour masquage final une fois le qrcode complet
-/// \param[out] qrmask[][] : le qrmak a remplir
-/// \param[in] no_masque  : n° de masque de 0 a 3 (cf masque dans ISO18004/2015 p52 et 54)
+///////////////////////////////////////////////////////////////////
+// Modeles précalculés : patterns obligatoires + 15 bits de format
+// pour chacune des 32 combinaisons (version M1_ ... M4_Q, n° de masque 0 a 3)
+// tout est calculé a la compilation, comme les tables de masques :
+// demarrer un nouveau qrcode revient a recopier un modele (un seul memcpy)
+
+#define NB_MODULE_VERSION(v)   ((v)==M4_Q ? NB_MODULE_M4 : NB_MODULE_M1 + 2*(((v)+1)/2))   /** comme nb_module_version() */
+
+// finder pattern 7x7 : contour + carré central 3x3
+#define FINDER_NOIR(i,j)    ((i)<=6 && (j)<=6 && ((i)==0 || (i)==6 || (j)==0 || (j)==6 || ((i)>=2 && (i)<=4 && (j)>=2 && (j)<=4)))
+// timing pattern sur la ligne 0 et la colonne 0, a partir du module 8, NOIR sur les indices pairs
+#define TIMING_NOIR(n,i,j)  ((i)<(n) && (j)<(n) && (((i)==0 && (j)>=8) || ((j)==0 && (i)>=8)) && ((i)+(j))%2==0)
+
+// mot de format de 15 bits calculé par le préprocesseur : le code BCH(15,5) est linéaire,
+// c'est donc le XOR des restes de chacun des 5 bits de données (voir table_format)
+#define FORMAT_MICROQR(d)   ((((d)<<10) ^ ((d)&1 ? 0x137 : 0) ^ ((d)&2 ? 0x26E : 0) ^ ((d)&4 ? 0x1EB : 0) \
+                              ^ ((d)&8 ? 0x3D6 : 0) ^ ((d)&16 ? 0x29B : 0)) ^ 0x4445)
+// bits 0 a 7 en colonne 8 (lignes 1 a 8), bits 8 a 14 en ligne 8 (colonnes 7 a 1), voir position_format
+#define FORMAT_NOIR(f,i,j)  (((j)==8 && (i)>=1 && (i)<=8 && (((f) >> ((i)>=1 ? (i)-1 : 0)) & 1)) \
+                             || ((i)==8 && (j)>=1 && (j)<=7 && (((f) >> (15-(j))) & 1)))
 
-void genere_QRmask(unsigned char qrmask[NB_MODULE][NB_MODULE],int no_masque)
+#define MODULE_MODELE(n,f,i,j)   ((FINDER_NOIR(i,j) || TIMING_NOIR(n,i,j) || FORMAT_NOIR(f,i,j)) ? NOIR : BLANC)
+#define LIGNE_MODELE(n,f,i) { \
+    MODULE_MODELE(n,f,i,0), MODULE_MODELE(n,f,i,1), MODULE_MODELE(n,f,i,2), MODULE_MODELE(n,f,i,3), MODULE_MODELE(n,f,i,4), MODULE_MODELE(n,f,i,5), MODULE_MODELE(n,f,i,6), MODULE_MODELE(n,f,i,7), MODULE_MODELE(n,f,i,8), MODULE_MODELE(n,f,i,9), MODULE_MODELE(n,f,i,10), MODULE_MODELE(n,f,i,11), MODULE_MODELE(n,f,i,12), MODULE_MODELE(n,f,i,13), MODULE_MODELE(n,f,i,14), MODULE_MODELE(n,f,i,15), MODULE_MODELE(n,f,i,16) }
+#define MODULES_MODELE(n,f) { \
+    LIGNE_MODELE(n,f,0), LIGNE_MODELE(n,f,1), LIGNE_MODELE(n,f,2), LIGNE_MODELE(n,f,3), LIGNE_MODELE(n,f,4), LIGNE_MODELE(n,f,5), LIGNE_MODELE(n,f,6), LIGNE_MODELE(n,f,7), LIGNE_MODELE(n,f,8), \
+    LIGNE_MODELE(n,f,9), LIGNE_MODELE(n,f,10), LIGNE_MODELE(n,f,11), LIGNE_MODELE(n,f,12), LIGNE_MODELE(n,f,13), LIGNE_MODELE(n,f,14), LIGNE_MODELE(n,f,15), LIGNE_MODELE(n,f,16) }
+#define MODELE(v,m)      { (v), NB_MODULE_VERSION(v), MODULES_MODELE(NB_MODULE_VERSION(v), FORMAT_MICROQR(((v)<<2)|(m))) }
+#define MODELES(v)       { MODELE(v,0), MODELE(v,1), MODELE(v,2), MODELE(v,3) }
+
+/// modeles complets [version M1_ ... M4_Q][n° de masque]
+static const QRcode_t table_modeles[8][4] =
 {
+    MODELES(M1_),  MODELES(M2_L), MODELES(M2_M), MODELES(M3_L),
+    MODELES(M3_M), MODELES(M4_L), MODELES(M4_M), MODELES(M4_Q)
+};
 
+///////////////////////////////////////////////////////////////////
+/// \fn void demarre_QRcode(QRcode_t *qrcode, unsigned short int version, int no_masque)
+/// \brief Sujet 0 (complement) : demarre un nouveau qrcode en recopiant le modele précalculé
+///        (finder, séparateurs, timing patterns et format) de la version et du masque choisis
+///        remplace cree_QRcode + initialise_QRcode + ajoute_version_QRcode
+/// \param[out] qrcode : le qrcode a demarrer
+/// \param[in] version : parmi M1_, M2_L ... M4_Q
+/// \param[in] no_masque : n° du masque (0 a 3) inscrit dans le format
+void demarre_QRcode(QRcode_t *qrcode, unsigned short int version, int no_masque)
+{
+    memcpy(qrcode, &table_modeles[version & 7][no_masque & 3], sizeof(QRcode_t));
+}
 
-    printf("\n donnee Utile : \tNumero du masque :%d \t Nombre de module : %d \n", no_masque, NB_MODULE);
-    //Afin d'avoir un aperçu sur la console des valeurs transmissent dans la boucle.
+///////////////////////////////////////////////////////////////////////////
+// Tables des masques calculées a la compilation
+// les 4 masques des microQRcode ne dependent que de la largeur du QRcode (donc de la version)
+// et du n° de masque : ils sont calculés une fois pour toutes par le préprocesseur/compilateur
+// pour les 4 largeurs (M1 a M4) x 4 masques, en version compacte (bits) et en version octets (NOIR/BLANC).
+// les modules hors zone de données (finder, séparateurs, timing, format) ne sont jamais masqués
 
-    int i,j, finder =9;
-    //Envoie de donnée dans un tableaux, avec la formules
-    //des masks
-    for(i=1; i<NB_MODULE; i++)
-    {
-        for(j=1; j<NB_MODULE; j++)
-        {
+#define TAILLE_VERSION(version)  ((version)==M4_Q ? 3 : ((version)+1)/2)    /** indice de largeur 0..3 (M1..M4) d'une version M1_ ... M4_Q */
 
-            switch (no_masque)
-            {
-            case 0: //Si le masque 0 est sélectionner
-                if(i%2==0)
-                    qrmask[i][j]=NOIR;
-                if(i%2!=0)
-                    qrmask[i][j]=BLANC;
-                break;
+// le module (i,j) d'un QRcode de largeur n est dans la zone de données (donc masquable)
+#define ZONE_DONNEES(n,i,j)   ((i)<(n) && (j)<(n) && (i)>=1 && (j)>=1 && ((i)>8 || (j)>8))
 
-            case 1: //Si le masque 1 est sélectionner
-                if((i/2+j/3)%2==0)
-                    qrmask[i][j]=NOIR;
-                if((i/2+j/3)%2==0)
-                    qrmask[i][j]=BLANC;
-                break;
+// conditions de masquage des microQRcode (ISO18004/2015 table 10, p52)
+#define CONDITION_MASQUE_0(i,j)  ((i)%2==0)
+#define CONDITION_MASQUE_1(i,j)  (((i)/2+(j)/3)%2==0)
+#define CONDITION_MASQUE_2(i,j)  ((((i)*(j))%2+((i)*(j))%3)%2==0)
+#define CONDITION_MASQUE_3(i,j)  ((((i)+(j))%2+((i)*(j))%3)%2==0)
 
-            case 2: //Si le masque 2 est sélectionner
-                if(((i*j)%2+(i*j)%3)%2==0)
-                    qrmask[i][j]=NOIR;
-                if(((i*j)%2+(i*j)%3)%2!=0)
-                    qrmask[i][j]=BLANC;
-                break;
+#define MASQUE_NOIR(n,m,i,j)    (ZONE_DONNEES(n,i,j) && CONDITION_MASQUE_##m(i,j))
 
-            case 3: //Si le masque 3 est sélectionner
-                if(((i+j)%2+(i*j)%3)%2==0)
-                    qrmask[i][j]=NOIR;
-                if(((i+j)%2+(i*j)%3)%2!=0)
-                    qrmask[i][j]=BLANC;
-                break;
-            }
-            if(i< finder && j<finder ||j==0 && i<NB_MODULE ||i==0 && j<NB_MODULE)
-                qrmask[i][j]=BLANC;
-        }
+// version compacte : 1 mot par ligne, bit j = colonne j
+#define BIT_MASQUE(n,m,i,j)     ((uint32_t)MASQUE_NOIR(n,m,i,j) << (j))
+#define LIGNE_BITS_MASQUE(n,m,i) ( \
+    BIT_MASQUE(n,m,i,0)|BIT_MASQUE(n,m,i,1)|BIT_MASQUE(n,m,i,2)|BIT_MASQUE(n,m,i,3)|BIT_MASQUE(n,m,i,4)|BIT_MASQUE(n,m,i,5)|BIT_MASQUE(n,m,i,6)|BIT_MASQUE(n,m,i,7)|BIT_MASQUE(n,m,i,8)|BIT_MASQUE(n,m,i,9)|BIT_MASQUE(n,m,i,10)|BIT_MASQUE(n,m,i,11)|BIT_MASQUE(n,m,i,12)|BIT_MASQUE(n,m,i,13)|BIT_MASQUE(n,m,i,14)|BIT_MASQUE(n,m,i,15)|BIT_MASQUE(n,m,i,16) )
+#define BITS_MASQUE(n,m) { \
+    LIGNE_BITS_MASQUE(n,m,0), LIGNE_BITS_MASQUE(n,m,1), LIGNE_BITS_MASQUE(n,m,2), LIGNE_BITS_MASQUE(n,m,3), LIGNE_BITS_MASQUE(n,m,4), LIGNE_BITS_MASQUE(n,m,5), LIGNE_BITS_MASQUE(n,m,6), LIGNE_BITS_MASQUE(n,m,7), LIGNE_BITS_MASQUE(n,m,8), \
+    LIGNE_BITS_MASQUE(n,m,9), LIGNE_BITS_MASQUE(n,m,10), LIGNE_BITS_MASQUE(n,m,11), LIGNE_BITS_MASQUE(n,m,12), LIGNE_BITS_MASQUE(n,m,13), LIGNE_BITS_MASQUE(n,m,14), LIGNE_BITS_MASQUE(n,m,15), LIGNE_BITS_MASQUE(n,m,16) }
+#define BITS_MASQUES(n) { BITS_MASQUE(n,0), BITS_MASQUE(n,1), BITS_MASQUE(n,2), BITS_MASQUE(n,3) }
 
-    }
+// version octets : NOIR/BLANC comme un QRcode_t
+#define OCTET_MASQUE(n,m,i,j)   (MASQUE_NOIR(n,m,i,j) ? NOIR : BLANC)
+#define LIGNE_OCTETS_MASQUE(n,m,i) { \
+    OCTET_MASQUE(n,m,i,0), OCTET_MASQUE(n,m,i,1), OCTET_MASQUE(n,m,i,2), OCTET_MASQUE(n,m,i,3), OCTET_MASQUE(n,m,i,4), OCTET_MASQUE(n,m,i,5), OCTET_MASQUE(n,m,i,6), OCTET_MASQUE(n,m,i,7), OCTET_MASQUE(n,m,i,8), OCTET_MASQUE(n,m,i,9), OCTET_MASQUE(n,m,i,10), OCTET_MASQUE(n,m,i,11), OCTET_MASQUE(n,m,i,12), OCTET_MASQUE(n,m,i,13), OCTET_MASQUE(n,m,i,14), OCTET_MASQUE(n,m,i,15), OCTET_MASQUE(n,m,i,16) }
+#define OCTETS_MASQUE(n,m) { \
+    LIGNE_OCTETS_MASQUE(n,m,0), LIGNE_OCTETS_MASQUE(n,m,1), LIGNE_OCTETS_MASQUE(n,m,2), LIGNE_OCTETS_MASQUE(n,m,3), LIGNE_OCTETS_MASQUE(n,m,4), LIGNE_OCTETS_MASQUE(n,m,5), LIGNE_OCTETS_MASQUE(n,m,6), LIGNE_OCTETS_MASQUE(n,m,7), LIGNE_OCTETS_MASQUE(n,m,8), \
+    LIGNE_OCTETS_MASQUE(n,m,9), LIGNE_OCTETS_MASQUE(n,m,10), LIGNE_OCTETS_MASQUE(n,m,11), LIGNE_OCTETS_MASQUE(n,m,12), LIGNE_OCTETS_MASQUE(n,m,13), LIGNE_OCTETS_MASQUE(n,m,14), LIGNE_OCTETS_MASQUE(n,m,15), LIGNE_OCTETS_MASQUE(n,m,16) }
+#define OCTETS_MASQUES(n) { OCTETS_MASQUE(n,0), OCTETS_MASQUE(n,1), OCTETS_MASQUE(n,2), OCTETS_MASQUE(n,3) }
+
+// derniere colonne du masque regroupée dans un mot : bit i = ligne i (la derniere ligne est dans table_masques_bits)
+#define BIT_COLONNE_MASQUE(n,m,i)  ((uint32_t)MASQUE_NOIR(n,m,i,(n)-1) << (i))
+#define COLONNE_MASQUE(n,m) ( \
+    BIT_COLONNE_MASQUE(n,m,0)|BIT_COLONNE_MASQUE(n,m,1)|BIT_COLONNE_MASQUE(n,m,2)|BIT_COLONNE_MASQUE(n,m,3)|BIT_COLONNE_MASQUE(n,m,4)|BIT_COLONNE_MASQUE(n,m,5)|BIT_COLONNE_MASQUE(n,m,6)|BIT_COLONNE_MASQUE(n,m,7)|BIT_COLONNE_MASQUE(n,m,8)|BIT_COLONNE_MASQUE(n,m,9)|BIT_COLONNE_MASQUE(n,m,10)|BIT_COLONNE_MASQUE(n,m,11)|BIT_COLONNE_MASQUE(n,m,12)|BIT_COLONNE_MASQUE(n,m,13)|BIT_COLONNE_MASQUE(n,m,14)|BIT_COLONNE_MASQUE(n,m,15)|BIT_COLONNE_MASQUE(n,m,16) )
+#define COLONNES_MASQUES(n) { COLONNE_MASQUE(n,0), COLONNE_MASQUE(n,1), COLONNE_MASQUE(n,2), COLONNE_MASQUE(n,3) }
 
+/// masques compactés [largeur M1..M4][n° de masque][ligne]
+static const uint32_t table_masques_bits[4][4][NB_MODULE_MAX] =
+{
+    BITS_MASQUES(NB_MODULE_M1), BITS_MASQUES(NB_MODULE_M2), BITS_MASQUES(NB_MODULE_M3), BITS_MASQUES(NB_MODULE_M4)
+};
+
+/// masques en octets NOIR/BLANC [largeur M1..M4][n° de masque][ligne][colonne]
+static const unsigned char table_masques[4][4][NB_MODULE_MAX][NB_MODULE_MAX] =
+{
+    OCTETS_MASQUES(NB_MODULE_M1), OCTETS_MASQUES(NB_MODULE_M2), OCTETS_MASQUES(NB_MODULE_M3), OCTETS_MASQUES(NB_MODULE_M4)
+};
+
+/// derniere colonne des masques [largeur M1..M4][n° de masque], bit i = ligne i
+static const uint32_t table_colonnes_masques[4][4] =
+{
+    COLONNES_MASQUES(NB_MODULE_M1), COLONNES_MASQUES(NB_MODULE_M2), COLONNES_MASQUES(NB_MODULE_M3), COLONNES_MASQUES(NB_MODULE_M4)
+};
+
+///////////////////////////////////////////////////////////////////////////
+/// \fn genere_QRmask(QRcode_t *qrmask,int no_masque)
+/// \brief Sujet2 : Generation des qrmask pour masquage final une fois le qrcode complet
+///        le masque est recopié depuis la table précalculée table_masques
+/// \param[in,out] qrmask : le qrmak a remplir (sa version doit etre fixée, voir cree_QRcode)
+/// \param[in] no_masque  : n° de masque de 0 a 3 (cf masque dans ISO18004/2015 p52 et 54)
+
+void genere_QRmask(QRcode_t *qrmask,int no_masque)
+{
+    memcpy(qrmask->module, table_masques[TAILLE_VERSION(qrmask->version)][no_masque & 3], sizeof(qrmask->module));
+}
 
+///////////////////////////////////////////////////////////////////////////
+/// \fn void genere_QRmask_QRbits(QRbits_t *qrmask,int no_masque)
+/// \brief Sujet2 (complement) : Generation d'un qrmask compacté, recopié depuis la table précalculée table_masques_bits
+/// \param[in,out] qrmask : le qrmak compacté a remplir (sa version doit etre fixée)
+/// \param[in] no_masque  : n° de masque de 0 a 3
+
+void genere_QRmask_QRbits(QRbits_t *qrmask,int no_masque)
+{
+    qrmask->nb_module = nb_module_version(qrmask->version);
+    memcpy(qrmask->ligne, table_masques_bits[TAILLE_VERSION(qrmask->version)][no_masque & 3], sizeof(qrmask->ligne));
 }
 
 ///////////////////////////////////////////////////////////////////////
-/// void Black_And_Whitise_QRcode(unsigned char qrcode[NB_MODULE][NB_MODULE])
+/// void Black_And_Whitise_QRcode(QRcode_t *qrcode)
 /// \brief  Code C fourni : cette fonction transforme tout ce qui n'est pas BLANC  (=255) en NOIR (=0) ,
 ///         Pour le debug, on a utilisé les majuscules F, S, V... pour reperer les zone finder, synchro, version
-/// \param[in,out] qrcode[][] : le qrcode a mettre en noir et blanc
-void Black_And_Whitise_QRcode(unsigned char qrcode[NB_MODULE][NB_MODULE])
+/// \param[in,out] qrcode : le qrcode a mettre en noir et blanc
+void Black_And_Whitise_QRcode(QRcode_t *qrcode)
 {
     int i,j;
-    for(i=0; i<NB_MODULE; i++)
+    for(i=0; i<qrcode->nb_module; i++)
     {
-        for(j=0; j<NB_MODULE; j++)
+        for(j=0; j<qrcode->nb_module; j++)
         {
-            if(qrcode[i][j] < BLANC)
+            if(qrcode->module[i][j] < BLANC)
             {
-                qrcode[i][j] = NOIR; // tout ce qui n'est pas blanc est NOIR !
+                qrcode->module[i][j] = NOIR; // tout ce qui n'est pas blanc est NOIR !
             };                      // cad : efface le detail des zone finder/syncrho Version
         }
     }
 
 }
 ///////////////////////////////////////////////////////////////////////
-/// void void xor_QRcode_QRmask(unsigned char qrcode[NB_MODULE][NB_MODULE],const unsigned char qrmask[NB_MODULE][NB_MODULE])
+/// void void xor_QRcode_QRmask(QRcode_t *qrcode,const QRcode_t *qrmask)
 /// \brief Sujet2 :  Réalise le masquage/demasquage du QRcode avec le masque fourni
-/// \param[in,out] qrcode[][] : le qrcode a masquer
-/// \param[in] qrmask[][] : le qrmask a utiliser
+/// \param[in,out] qrcode : le qrcode a masquer
+/// \param[in] qrmask : le qrmask a utiliser (de meme largeur que le qrcode)
 
-void xor_QRcode_QRmask(unsigned char qrcode[NB_MODULE][NB_MODULE],const unsigned char qrmask[NB_MODULE][NB_MODULE])
+void xor_QRcode_QRmask(QRcode_t *qrcode,const QRcode_t *qrmask)
 {
     int i,j;
 //appel des deux tableaux
-    for(i=0; i<NB_MODULE; i++)
+    for(i=0; i<qrcode->nb_module; i++)
     {
-        for(j=0; j<NB_MODULE; j++)
+        for(j=0; j<qrcode->nb_module; j++)
         {
             //mettre les cases noirs du masque sur les cases blanches du qrcode
-            if(qrmask[i][j]==NOIR && qrcode[i][j]==BLANC)
-                qrcode[i][j]=NOIR;
+            if(qrmask->module[i][j]==NOIR && qrcode->module[i][j]==BLANC)
+                qrcode->module[i][j]=NOIR;
             //sinon si le masque a les mêmes cases que le qrcode en noir mettre dans le qrcode
             //final la case en blanc
-            else if (qrmask[i][j]==NOIR && qrcode[i][j]==NOIR)
-                qrcode[i][j]=BLANC;
+            else if (qrmask->module[i][j]==NOIR && qrcode->module[i][j]==NOIR)
+                qrcode->module[i][j]=BLANC;
         }
     }
 }
 ////////////////////////////////////////////////////////////////
-/// \fn int score_masquage_QRcode(const unsigned char qrcode[NB_MODULE][NB_MODULE]){
+/// \fn int score_masquage_QRcode(const QRcode_t *qrcode){
 /// \brief  Sujet 2 (facultatif)  : calcul du score apres masquage (ISO18004 page papier 53/54)
 /// le principe est de tester les 4 masques definis pour les microQRcode et de choisir celui qui maximise ce score.
 /// dans un 1er temps on n'optimisera pas ce masquage, mais on appliquera un masque fixe au choix du programmeur
 ///  toutefois la fonction de calcul du score est ci dessous
-/// \param[in] qrcode[][] : le qrcode dont on doit calculer le score
+/// \param[in] qrcode : le qrcode dont on doit calculer le score
 /// \return Le score calculé
 
-int score_masquage_QRcode(const unsigned char qrcode[NB_MODULE][NB_MODULE])
+int score_masquage_QRcode(const QRcode_t *qrcode)
 {
     int som_1=0, som_2=0, i,j;
     int score=0;
-    for(i=0; i<NB_MODULE; i++)
+    int dernier = qrcode->nb_module-1;   // indice de la derniere ligne/colonne
+    for(i=0; i<qrcode->nb_module; i++)
     {
 
-        for(j=0; j<NB_MODULE; j++)
+        for(j=0; j<qrcode->nb_module; j++)
         {
-            //j==10 Dernière colone du qrcode+Comptage case noir
+            //j==dernier Dernière colone du qrcode+Comptage case noir
             //dans cette colone
-            if(j==10 && qrcode[i][j]==NOIR )
+            if(j==dernier && qrcode->module[i][j]==NOIR )
                 som_1=som_1+1;
-            //i==10 Dernière ligne du QRcode+comptage case noir
-            if(i==10 && qrcode[i][j]==NOIR)
+            //i==dernier Dernière ligne du QRcode+comptage case noir
+            if(i==dernier && qrcode->module[i][j]==NOIR)
                 som_2=som_2+1;
             //Calcule du score final
             if(som_1<=som_2)
@@ -484,6 +1048,183 @@ int score_masquage_QRcode(const unsigned char qrcode[NB_MODULE][NB_MODULE])
     //Renvoie dans le test unitaire 2 la valeur du score
     return score;
 }
+
+//////////////////////////////////////////////////////////////////////
+/// \fn void QRcode_to_QRbits(const QRcode_t *qrcode, QRbits_t *qrbits)
+/// \brief Sujet 2 (complement) : compacte un qrcode en bitboard (1 bit par module)
+///        comme Black_And_Whitise_QRcode, tout ce qui n'est pas BLANC est considéré NOIR
+/// \param[in]  qrcode : le qrcode a compacter
+/// \param[out] qrbits : le qrcode compacté
+void QRcode_to_QRbits(const QRcode_t *qrcode, QRbits_t *qrbits)
+{
+    int i,j;
+    uint32_t ligne;
+    qrbits->version   = qrcode->version;
+    qrbits->nb_module = qrcode->nb_module;
+    for(i=0; i<NB_MODULE_MAX; i++)
+    {
+        ligne = 0;
+        if(i < qrcode->nb_module)
+        {
+            for(j=0; j<qrcode->nb_module; j++)
+            {
+                ligne |= (uint32_t)(qrcode->module[i][j] < BLANC) << j;  // sans branchement
+            }
+        }
+        qrbits->ligne[i] = ligne;    // les lignes hors du QRcode restent a 0
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn void QRbits_to_QRcode(const QRbits_t *qrbits, QRcode_t *qrcode)
+/// \brief Sujet 2 (complement) : decompacte un bitboard en qrcode NOIR (0) / BLANC (255)
+/// \param[in]  qrbits : le qrcode compacté
+/// \param[out] qrcode : le qrcode
+void QRbits_to_QRcode(const QRbits_t *qrbits, QRcode_t *qrcode)
+{
+    int i,j;
+    qrcode->version   = qrbits->version;
+    qrcode->nb_module = qrbits->nb_module;
+    for(i=0; i<qrbits->nb_module; i++)
+    {
+        for(j=0; j<qrbits->nb_module; j++)
+        {
+            // bit a 1 : 1-1 = 0 = NOIR, bit a 0 : 0-1 = 255 = BLANC
+            qrcode->module[i][j] = (unsigned char)(((qrbits->ligne[i] >> j) & 1) - 1);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn void xor_QRbits_QRmask(QRbits_t *qrbits, const QRbits_t *qrmask)
+/// \brief Sujet 2 (complement) : masquage/demasquage d'un qrcode compacté : un XOR par ligne
+/// \param[in,out] qrbits : le qrcode compacté a masquer
+/// \param[in] qrmask : le qrmask compacté (de meme largeur)
+void xor_QRbits_QRmask(QRbits_t *qrbits, const QRbits_t *qrmask)
+{
+    int i;
+    for(i=0; i<NB_MODULE_MAX; i++)
+    {
+        qrbits->ligne[i] ^= qrmask->ligne[i];
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn int score_masquage_QRbits(const QRbits_t *qrbits)
+/// \brief Sujet 2 (complement) : meme score que score_masquage_QRcode (SUM1/SUM2) sur un qrcode compacté
+///        la derniere ligne est comptée en un seul popcount, la derniere colonne est
+///        d'abord regroupée dans un mot puis comptée de la meme facon
+/// \param[in] qrbits : le qrcode compacté dont on doit calculer le score
+/// \return Le score calculé
+int score_masquage_QRbits(const QRbits_t *qrbits)
+{
+    int i, som_1, som_2;
+    int dernier = qrbits->nb_module-1;   // indice de la derniere ligne/colonne
+    uint32_t colonne = 0;
+    for(i=0; i<qrbits->nb_module; i++)
+    {
+        colonne |= ((qrbits->ligne[i] >> dernier) & 1) << i;
+    }
+    som_1 = __builtin_popcount(colonne);                  // derniere colonne
+    som_2 = __builtin_popcount(qrbits->ligne[dernier]);  // derniere ligne
+    return (som_1 <= som_2) ? som_1*16+som_2 : som_2*16+som_1;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn static int meilleur_masque(unsigned short int version, uint32_t colonne, uint32_t ligne)
+/// \brief Sujet 2 (complement) : calcule les 4 scores (SUM1/SUM2) a partir des seuls bords du qrcode non masqué
+///        le score ne porte que sur la derniere colonne et la derniere ligne : il suffit de les masquer
+///        avec les bords précalculés de chaque masque (table_colonnes_masques et table_masques_bits)
+/// \param[in] version : parmi M1_ ... M4_Q
+/// \param[in] colonne : derniere colonne du qrcode non masqué (bit i = ligne i, 1 = NOIR)
+/// \param[in] ligne   : derniere ligne du qrcode non masqué (bit j = colonne j, 1 = NOIR)
+/// \return le n° du masque de meilleur score (le plus grand n° en cas d'égalité, comme test_unitaire_sujet2)
+static int meilleur_masque(unsigned short int version, uint32_t colonne, uint32_t ligne)
+{
+    int t = TAILLE_VERSION(version);
+    int dernier = nb_module_version(version)-1;
+    int no_masque, som_1, som_2, score, score_max = -1, masque = 0;
+    for(no_masque=0; no_masque<4; no_masque++)
+    {
+        som_1 = __builtin_popcount(colonne ^ table_colonnes_masques[t][no_masque]);
+        som_2 = __builtin_popcount(ligne   ^ table_masques_bits[t][no_masque][dernier]);
+        score = (som_1 <= som_2) ? som_1*16+som_2 : som_2*16+som_1;
+        if(score >= score_max)
+        {
+            score_max = score;
+            masque    = no_masque;
+        }
+    }
+    return masque;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn int choisit_masque_QRcode(QRcode_t *qrcode, int no_masque)
+/// \brief Sujet 2 (complement) : choisit le meilleur masque sans construire les 4 qrcodes masqués, puis l'applique une seule fois
+///        en mode rapide (no_masque entre 0 et 3), le masque imposé est appliqué directement, sans calcul de score
+/// \param[in,out] qrcode : le qrcode complet (patterns + données) non masqué
+/// \param[in] no_masque : MASQUE_AUTO pour choisir le meilleur masque, ou n° de masque imposé (0 a 3)
+/// \return le n° du masque appliqué
+int choisit_masque_QRcode(QRcode_t *qrcode, int no_masque)
+{
+    int i,j;
+    int dernier = qrcode->nb_module-1;
+    const unsigned char (*masque)[NB_MODULE_MAX];
+    uint32_t colonne = 0, ligne = 0;
+
+    if(no_masque == MASQUE_AUTO)
+    {
+        for(i=0; i<qrcode->nb_module; i++)
+        {
+            colonne |= (uint32_t)(qrcode->module[i][dernier] == NOIR) << i;
+            ligne   |= (uint32_t)(qrcode->module[dernier][i] == NOIR) << i;
+        }
+        no_masque = meilleur_masque(qrcode->version, colonne, ligne);
+    }
+    no_masque &= 3;
+
+    // application du masque retenu : les modules NOIR du masque inversent le qrcode
+    masque = table_masques[TAILLE_VERSION(qrcode->version)][no_masque];
+    for(i=0; i<qrcode->nb_module; i++)
+    {
+        for(j=0; j<qrcode->nb_module; j++)
+        {
+            qrcode->module[i][j] ^= (unsigned char)~masque[i][j];   // masque NOIR (0) -> inversion NOIR <-> BLANC
+        }
+    }
+    return no_masque;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn int choisit_masque_QRbits(QRbits_t *qrbits, int no_masque)
+/// \brief Sujet 2 (complement) : comme choisit_masque_QRcode sur un qrcode compacté
+/// \param[in,out] qrbits : le qrcode compacté complet non masqué
+/// \param[in] no_masque : MASQUE_AUTO pour choisir le meilleur masque, ou n° de masque imposé (0 a 3)
+/// \return le n° du masque appliqué
+int choisit_masque_QRbits(QRbits_t *qrbits, int no_masque)
+{
+    int i;
+    int dernier = qrbits->nb_module-1;
+    const uint32_t *masque;
+    uint32_t colonne = 0;
+
+    if(no_masque == MASQUE_AUTO)
+    {
+        for(i=0; i<qrbits->nb_module; i++)
+        {
+            colonne |= ((qrbits->ligne[i] >> dernier) & 1) << i;
+        }
+        no_masque = meilleur_masque(qrbits->version, colonne, qrbits->ligne[dernier]);
+    }
+    no_masque &= 3;
+
+    masque = table_masques_bits[TAILLE_VERSION(qrbits->version)][no_masque];
+    for(i=0; i<NB_MODULE_MAX; i++)
+    {
+        qrbits->ligne[i] ^= masque[i];
+    }
+    return no_masque;
+}
 /////////////////////////////////////////////////////////////////////////
 /// \fn unsigned short int  encode_version(int type, int no_masque)
 /// \brief Sujet 1 : Fonction qui calcul les  15 bits du n° d'encodage  a partir du mode et
@@ -498,86 +1239,120 @@ int score_masquage_QRcode(const unsigned char qrcode[NB_MODULE][NB_MODULE])
 //
 // appel header = encode_version(M4_L, 2);
 //
+// les 5 bits d'entrée (type<<2 | no_masque) ne donnent que 32 combinaisons : les 32 mots de 15 bits
+// (5 bits de données, 10 bits BCH(15,5) de polynome 0x537, XOR 0x4445) sont précalculés dans table_format
+
+/// mots de format finaux (BCH + masquage 0x4445) indexés par (type<<2) | no_masque
+static const unsigned short int table_format[32] =
+{
+    0x4445, 0x4172, 0x4E2B, 0x4B1C,    // M1_
+    0x55AE, 0x5099, 0x5FC0, 0x5AF7,    // M2_L
+    0x6793, 0x62A4, 0x6DFD, 0x68CA,    // M2_M
+    0x7678, 0x734F, 0x7C16, 0x7921,    // M3_L
+    0x06DE, 0x03E9, 0x0CB0, 0x0987,    // M3_M
+    0x1735, 0x1202, 0x1D5B, 0x186C,    // M4_L
+    0x2508, 0x203F, 0x2F66, 0x2A51,    // M4_M
+    0x34E3, 0x31D4, 0x3E8D, 0x3BBA     // M4_Q
+};
+
 unsigned short int  encode_version(int type, int no_masque)
 {
-    unsigned short int header15bits  = 0;
-    // A COMPLETER
-    return header15bits;
+    return table_format[((type & 7) << 2) | (no_masque & 3)];
 }
 
 ////////////////////////////////////////////////////
-/// \fn void ajoute_version_QRcode(unsigned char qrcode[NB_MODULE][NB_MODULE],unsigned short int header15bits){ajoute l'information de version sur le QRCODE
-/// \param[in,out]  qrcode[][]  LE qrcode !
+/// \fn void ajoute_version_QRcode(QRcode_t *qrcode,unsigned short int header15bits){ajoute l'information de version sur le QRCODE
+/// \param[in,out]  qrcode  LE qrcode !
 /// \param[in] : header15bits   entete a ecrire (version + n°mack + 10 bits BCH) précalculées
 /// \brief Sujet 1 :  ajoute les 15 bits de version (deja calculés) dans la zone de 15 bits reservées qui entourent le FINDER PATTERN
 
-void ajoute_version_QRcode(unsigned char qrcode[NB_MODULE][NB_MODULE],unsigned short int header15bits)
+// position [ligne][colonne] de chaque bit du format (bit0 = poids faible) :
+// bits 0 a 7 dans la colonne 8 (lignes 1 a 8), bits 8 a 14 dans la ligne 8 (colonnes 7 a 1)
+static const unsigned char position_format[15][2] =
 {
-//A COMPLETER
+    {1,8}, {2,8}, {3,8}, {4,8}, {5,8}, {6,8}, {7,8}, {8,8},
+    {8,7}, {8,6}, {8,5}, {8,4}, {8,3}, {8,2}, {8,1}
+};
+
+void ajoute_version_QRcode(QRcode_t *qrcode,unsigned short int header15bits)
+{
+    int k;
+    for(k=0; k<15; k++)
+    {
+        // bit a 1 : 1-1 = 0 = NOIR, bit a 0 : 0-1 = 255 = BLANC
+        qrcode->module[position_format[k][0]][position_format[k][1]] = (unsigned char)(((header15bits >> k) & 1) - 1);
+    }
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// \fn int numeric_to_binaryDS(const unsigned char data_string[24+1], unsigned char binaryDS[24*8], unsigned short int version)
 /// \brief Sujet 3c (version M1) : Encode une datastring de type numérique  en chaine binaire (dont entete longuer/mode)
-///      OBLIGATOIRE : longueur de chaine multiple de 3, facultatif (toute longueur)
+///      toute longueur : les chiffres sont encodés par numeric_to_flux (directement en octets), puis recopiés 1 bit par octet
 /// \param[in]  data_string[] Chaine de caracteres a encoder dans le QRcode
 /// \param[out] binaryDS[]    Chaine binaire encodée
 /// \param[in]  version parmi M1_, M2_L, M2_M, M3....
 ///         toutes les versions (M1,M2,M3,M4) supportent le mode numérique
-/// \return Retourne la longueur du datastream ou -1 si mode non supporté
+/// \return Retourne la longueur du datastream ou -1 si mode non supporté (ou chaine invalide, ou trop longue)
 
 
 int numeric_to_binaryDS(const unsigned char data_string[24+1], unsigned char binaryDS[24*8], unsigned short int version)
 {
-    //int index_s =0; // index de la chaine de caractere a encoder
-    //int index_b =0; // index de la chaine binaire à remplir
-    //int nb_chiffres;        // nombre de chiffres dans la chaine numérique a encoder
-    int binaryDS_length;    // longueur du flux binaire
+    unsigned char packedbyteDS[24];
+    QRflux_t flux;
 
-    return binaryDS_length;
+    demarre_flux(&flux, packedbyteDS);
+    if(numeric_to_flux(data_string, (int)strlen((const char *)data_string), &flux, version) < 0)
+    {
+        return -1;
+    }
+    return flux_to_binaryDS(&flux, binaryDS);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// \fn int alphanum_to_binaryDS(const unsigned char data_string[24+1], unsigned char binaryDS[24µ8], unsigned short int version){
 /// \brief  Sujet 3b (version M2) : encode une datastring de type alphanumérique (45 lettres/chiffres/signes)  en chaine binaire (dont entete longuer/mode)
-///         Obligatoire longueur de chaine multiple de 2, facultatif (toute longueur)
+///         toute longueur : les caracteres sont encodés par alphanum_to_flux (directement en octets), puis recopiés 1 bit par octet
 /// \param[in] data_string[] Chaine de caracteres a encoder dans le QRcode
 /// \param[out] binaryDS[]    Chaine binaire encodée
 /// \param[in] version parmis M1_, M2_L, M2_M, M3....
 ///         ATTENTION M1 ne supporte pas le mode alphanumérique
-/// \return Retourne la longueur du datastream ou -1 si mode non supporté
+/// \return Retourne la longueur du datastream ou -1 si mode non supporté (ou chaine invalide, ou trop longue)
 
 int alphanum_to_binaryDS(const unsigned char data_string[24+1], unsigned char binaryDS[24*8], unsigned short int version)
 {
-    //int index_s =0; // index de la chaine de caractere a encoder
-    //int index_b =0; // index de la chaine binaire à remplir
-    int binaryDS_length;    // longueur du flux binaire
-    //unsigned char car1, car2;          // 2 caracteres consécutif (parmi 45)
-    //unsigned int double_car_alphanum;  // forment un double caractere encodé sur 11bits (0 a 2047
-
-    // A COMPLETER
+    unsigned char packedbyteDS[24];
+    QRflux_t flux;
 
-    return binaryDS_length;
+    demarre_flux(&flux, packedbyteDS);
+    if(alphanum_to_flux(data_string, (int)strlen((const char *)data_string), &flux, version) < 0)
+    {
+        return -1;
+    }
+    return flux_to_binaryDS(&flux, binaryDS);
 }
 
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// \fn int ascii_to_binaryDS(const unsigned char data_string[24+1], unsigned char binaryDS[24*8], unsigned short int version){
 /// \brief  Sujet 3a (version M4) : Encode une datastring de type ascii  en chaine binaire (dont entete longueur/mode)
+///         les octets sont encodés par ascii_to_flux (directement en octets), puis recopiés 1 bit par octet
 /// \param[in]  data_string[] Chaine de caracteres a encoder dans le QRcode
 /// \param[out] binaryDS[]    Chaine binaire encodée
 /// \param[in]  version parmis M1_, M2_L, M2_M, M3....
 ///         ATTENTION M1 et M2  ne supportent pas le mode ascii
-/// \return Retourne la longueur du datastream ou -1 si mode non supporté
+/// \return Retourne la longueur du datastream ou -1 si mode non supporté (ou chaine trop longue)
 
 int ascii_to_binaryDS(const unsigned char data_string[24+1], unsigned char binaryDS[24*8], unsigned short int version)
 {
-    //int index_s = 0; // index de la chaine de caractere a encoder
-    //int index_b = 0; // index de la chaine binaire à remplir
-    int binaryDS_length = 0 ;    // longueur du flux binaire
+    unsigned char packedbyteDS[24];
+    QRflux_t flux;
 
-    //A COMPLETER
-    return binaryDS_length;
+    demarre_flux(&flux, packedbyteDS);
+    if(ascii_to_flux(data_string, (int)strlen((const char *)data_string), &flux, version) < 0)
+    {
+        return -1;
+    }
+    return flux_to_binaryDS(&flux, binaryDS);
 }
 
 // ////////////////////////////////////////////////////////////////////
@@ -587,17 +1362,42 @@ int ascii_to_binaryDS(const unsigned char data_string[24+1], unsigned char binar
 /// \param[in]  data_string[] : chaine de caractere a encoder
 /// \param[out] binaryDS[]    : chaine binaire encodée (incluant l'entete)
 /// \param[in]  version : parmi M1_, M2_L, ... M3_Q
-/// \param[in]  mode : parmi NUMERIC, ALPHANUM, ASCII
+/// \param[in]  mode : parmi NUMERIC, ALPHANUM, ASCII, KANJI, ou MODE_AUTO (découpage en segments, voir mixte_to_flux)
 /// \return -1 si incompatibilité entre le mode et la version, nb de bit dans la chaine binaire si non
 int data_string_to_binaryDS(const unsigned char data_string[24+1],
                             unsigned char binaryDS[24*8],
                             unsigned short int version,
                             unsigned short int mode )
 {
-    // TODO : controle de cohérence mode/version et aiguillage vers l'eune des 3 fonctions
+    unsigned char packedbyteDS[24];
+    QRflux_t flux;
 
-
-    return 0;
+    // la cohérence mode/version (et la capacité) est controlée par chacune des fonctions
+    switch(mode)
+    {
+    case NUMERIC :
+        return numeric_to_binaryDS(data_string, binaryDS, version);
+    case ALPHANUM :
+        return alphanum_to_binaryDS(data_string, binaryDS, version);
+    case ASCII :
+        return ascii_to_binaryDS(data_string, binaryDS, version);
+    case KANJI :
+        demarre_flux(&flux, packedbyteDS);
+        if(kanji_to_flux(data_string, (int)strlen((const char *)data_string), &flux, version) < 0)
+        {
+            return -1;
+        }
+        return flux_to_binaryDS(&flux, binaryDS);
+    case MODE_AUTO :
+        demarre_flux(&flux, packedbyteDS);
+        if(mixte_to_flux(data_string, (int)strlen((const char *)data_string), &flux, version, MODE_AUTO) < 0)
+        {
+            return -1;
+        }
+        return flux_to_binaryDS(&flux, binaryDS);
+    default :
+        return -1;
+    }
 }
 
 // ////////////////////////////////////////////////////////////////////
@@ -611,233 +1411,4760 @@ int data_string_to_binaryDS(const unsigned char data_string[24+1],
 
 void binaryDS_to_packedbyteDS(const unsigned char binaryDS[24*8], unsigned char packedbyteDS[24],unsigned short int version)
 {
-    //int i,index_binDS=0,bit;
-    //unsigned char byte=0;
-    int nb_packed[8] = { 5,10,10,17,17,24,24,24}; //
-    int longueur_packed;
-    longueur_packed = nb_packed[version]; // "calcul de la longueur"                                                              ;;
-    // A completer
+    int index_binDS=0;
+    QRflux_t flux;
+    // les octets de données sont complétés (terminateur + bourrage) par termine_flux,
+    // les octets de correction (jusqu'a nb_packed[version]) par ajoute_correction_packedbyteDS
+    demarre_flux(&flux, packedbyteDS);
+    while((index_binDS < 24*8) && (binaryDS[index_binDS] < 255))
+    {
+        ecrit_bits_flux(&flux, binaryDS[index_binDS++], 1);
+    }
+    termine_flux(&flux, version);
 }
 
-//////////////////////////////////////////////////////////////////////
-/// \fn void ajoute_dataM1_QRcode(const unsigned char packedbyteDS[24],unsigned char qrcode[NB_MODULE][NB_MODULE])
-/// \brief Sujet 4 version M1 : Ajoute les données (packed) dans un microQRcode M1
+//////////////////////////////////////////////////////////////////////////////////////
+// Code correcteur Reed-Solomon (ISO18004/2015 §7.5)
+// les octets de données (packedbyteDS) sont suivis des octets de correction : pour les microQRcode
+// il n'y a qu'un seul bloc, le total d'octets est donné par nb_packed (voir binaryDS_to_packedbyteDS)
+// rappel : en M1 et M3 le dernier octet de données n'a que 4 bits, calés sur le MSB (bits 3 a 0 a zero)
+
+/// nombre d'octets de données (y compris l'octet de 4 bits en M1/M3) selon la version M1_ ... M4_Q
+static const unsigned char nb_octets_donnees[8]    = { 3, 5, 4, 11, 9, 16, 14, 10 };
+/// nombre d'octets de correction selon la version M1_ ... M4_Q (ISO18004/2015 table 9)
+static const unsigned char nb_octets_correction[8] = { 2, 5, 6,  6, 8,  8, 10, 14 };
+
+/// antilogarithmes dans GF(256) : gf_exp[i] = alpha^i, dupliqué sur 512 entrées pour eviter le modulo 255
+static const unsigned char gf_exp[512] =
+{
+      1,   2,   4,   8,  16,  32,  64, 128,  29,  58, 116, 232, 205, 135,  19,  38,
+     76, 152,  45,  90, 180, 117, 234, 201, 143,   3,   6,  12,  24,  48,  96, 192,
+    157,  39,  78, 156,  37,  74, 148,  53, 106, 212, 181, 119, 238, 193, 159,  35,
+     70, 140,   5,  10,  20,  40,  80, 160,  93, 186, 105, 210, 185, 111, 222, 161,
+     95, 190,  97, 194, 153,  47,  94, 188, 101, 202, 137,  15,  30,  60, 120, 240,
+    253, 231, 211, 187, 107, 214, 177, 127, 254, 225, 223, 163,  91, 182, 113, 226,
+    217, 175,  67, 134,  17,  34,  68, 136,  13,  26,  52, 104, 208, 189, 103, 206,
+    129,  31,  62, 124, 248, 237, 199, 147,  59, 118, 236, 197, 151,  51, 102, 204,
+    133,  23,  46,  92, 184, 109, 218, 169,  79, 158,  33,  66, 132,  21,  42,  84,
+    168,  77, 154,  41,  82, 164,  85, 170,  73, 146,  57, 114, 228, 213, 183, 115,
+    230, 209, 191,  99, 198, 145,  63, 126, 252, 229, 215, 179, 123, 246, 241, 255,
+    227, 219, 171,  75, 150,  49,  98, 196, 149,  55, 110, 220, 165,  87, 174,  65,
+    130,  25,  50, 100, 200, 141,   7,  14,  28,  56, 112, 224, 221, 167,  83, 166,
+     81, 162,  89, 178, 121, 242, 249, 239, 195, 155,  43,  86, 172,  69, 138,   9,
+     18,  36,  72, 144,  61, 122, 244, 245, 247, 243, 251, 235, 203, 139,  11,  22,
+     44,  88, 176, 125, 250, 233, 207, 131,  27,  54, 108, 216, 173,  71, 142,   1,
+      2,   4,   8,  16,  32,  64, 128,  29,  58, 116, 232, 205, 135,  19,  38,  76,
+    152,  45,  90, 180, 117, 234, 201, 143,   3,   6,  12,  24,  48,  96, 192, 157,
+     39,  78, 156,  37,  74, 148,  53, 106, 212, 181, 119, 238, 193, 159,  35,  70,
+    140,   5,  10,  20,  40,  80, 160,  93, 186, 105, 210, 185, 111, 222, 161,  95,
+    190,  97, 194, 153,  47,  94, 188, 101, 202, 137,  15,  30,  60, 120, 240, 253,
+    231, 211, 187, 107, 214, 177, 127, 254, 225, 223, 163,  91, 182, 113, 226, 217,
+    175,  67, 134,  17,  34,  68, 136,  13,  26,  52, 104, 208, 189, 103, 206, 129,
+     31,  62, 124, 248, 237, 199, 147,  59, 118, 236, 197, 151,  51, 102, 204, 133,
+     23,  46,  92, 184, 109, 218, 169,  79, 158,  33,  66, 132,  21,  42,  84, 168,
+     77, 154,  41,  82, 164,  85, 170,  73, 146,  57, 114, 228, 213, 183, 115, 230,
+    209, 191,  99, 198, 145,  63, 126, 252, 229, 215, 179, 123, 246, 241, 255, 227,
+    219, 171,  75, 150,  49,  98, 196, 149,  55, 110, 220, 165,  87, 174,  65, 130,
+     25,  50, 100, 200, 141,   7,  14,  28,  56, 112, 224, 221, 167,  83, 166,  81,
+    162,  89, 178, 121, 242, 249, 239, 195, 155,  43,  86, 172,  69, 138,   9,  18,
+     36,  72, 144,  61, 122, 244, 245, 247, 243, 251, 235, 203, 139,  11,  22,  44,
+     88, 176, 125, 250, 233, 207, 131,  27,  54, 108, 216, 173,  71, 142,   1,   2
+};
+
+/// logarithmes dans GF(256) : gf_log[alpha^i] = i (gf_log[0] non défini)
+static const unsigned char gf_log[256] =
+{
+      0,   0,   1,  25,   2,  50,  26, 198,   3, 223,  51, 238,  27, 104, 199,  75,
+      4, 100, 224,  14,  52, 141, 239, 129,  28, 193, 105, 248, 200,   8,  76, 113,
+      5, 138, 101,  47, 225,  36,  15,  33,  53, 147, 142, 218, 240,  18, 130,  69,
+     29, 181, 194, 125, 106,  39, 249, 185, 201, 154,   9, 120,  77, 228, 114, 166,
+      6, 191, 139,  98, 102, 221,  48, 253, 226, 152,  37, 179,  16, 145,  34, 136,
+     54, 208, 148, 206, 143, 150, 219, 189, 241, 210,  19,  92, 131,  56,  70,  64,
+     30,  66, 182, 163, 195,  72, 126, 110, 107,  58,  40,  84, 250, 133, 186,  61,
+    202,  94, 155, 159,  10,  21, 121,  43,  78, 212, 229, 172, 115, 243, 167,  87,
+      7, 112, 192, 247, 140, 128,  99,  13, 103,  74, 222, 237,  49, 197, 254,  24,
+    227, 165, 153, 119,  38, 184, 180, 124,  17,  68, 146, 217,  35,  32, 137,  46,
+     55,  63, 209,  91, 149, 188, 207, 205, 144, 135, 151, 178, 220, 252, 190,  97,
+    242,  86, 211, 171,  20,  42,  93, 158, 132,  60,  57,  83,  71, 109,  65, 162,
+     31,  45,  67, 216, 183, 123, 164, 118, 196,  23,  73, 236, 127,  12, 111, 246,
+    108, 161,  59,  82,  41, 157,  85, 170, 251,  96, 134, 177, 187, 204,  62,  90,
+    203,  89,  95, 176, 156, 169, 160,  81,  11, 245,  22, 235, 122, 117,  44, 215,
+     79, 174, 213, 233, 230, 231, 173, 232, 116, 214, 244, 234, 168,  80,  88, 175
+};
+
+// polynomes generateurs g(x) = (x-alpha^0)(x-alpha^1)...(x-alpha^(n-1)), coefficients
+// du degre n-1 au degre 0 (le coefficient de x^n vaut 1), stockés sous forme de logarithmes
+static const unsigned char generateur_2[2]   = { 25, 1 };
+static const unsigned char generateur_5[5]   = { 113, 164, 166, 119, 10 };
+static const unsigned char generateur_6[6]   = { 166, 0, 134, 5, 176, 15 };
+static const unsigned char generateur_8[8]   = { 175, 238, 208, 249, 215, 252, 196, 28 };
+static const unsigned char generateur_10[10] = { 251, 67, 46, 61, 118, 70, 64, 94, 32, 45 };
+static const unsigned char generateur_14[14] = { 199, 249, 155, 48, 190, 124, 218, 137, 216, 87, 207, 59, 22, 91 };
+
+/// polynome generateur (en logarithmes) selon la version M1_ ... M4_Q
+static const unsigned char * const generateur_version[8] =
+{
+    generateur_2, generateur_5, generateur_6, generateur_6, generateur_8, generateur_8, generateur_10, generateur_14
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn void ajoute_correction_packedbyteDS(unsigned char packedbyteDS[24], unsigned short int version)
+/// \brief Sujets 3 (complement) : calcule les octets de correction Reed-Solomon des octets de données
+///        par division polynomiale (registre a décalage) avec les tables log/antilog de GF(256)
+/// \param[in,out] packedbyteDS[24] : les nb_octets_donnees[version] octets de données, complétés par
+///        les nb_octets_correction[version] octets de correction (nb_packed[version] octets au total)
+/// \param[in] version : parmi M1_, M2_L ... M4_Q
+void ajoute_correction_packedbyteDS(unsigned char packedbyteDS[24], unsigned short int version)
+{
+    int i, k;
+    int nb_donnees    = nb_octets_donnees[version & 7];
+    int nb_correction = nb_octets_correction[version & 7];
+    const unsigned char *generateur = generateur_version[version & 7];
+    unsigned char reste[24] = {0};   // registre : reste de la division, degre le plus fort en tete
+    unsigned char retour;
+    int log_retour;
+
+    for(i=0; i<nb_donnees; i++)
+    {
+        retour = packedbyteDS[i] ^ reste[0];
+        memmove(reste, reste+1, nb_correction-1);
+        reste[nb_correction-1] = 0;
+        if(retour != 0)
+        {
+            log_retour = gf_log[retour];
+            for(k=0; k<nb_correction; k++)
+            {
+                reste[k] ^= gf_exp[log_retour + generateur[k]];  // retour * g[k] dans GF(256)
+            }
+        }
+    }
+    memcpy(packedbyteDS + nb_donnees, reste, nb_correction);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+// Ecriture directe du flux binaire en octets
+// les encodeurs ecrivent leurs groupes de bits dans un accumulateur de 64 bits, vidé 32 bits
+// a la fois dans packedbyteDS : plus de binaryDS intermediaire (1 octet par bit) ni de recompaction
+
+/// nombre de bits de données selon la version M1_ ... M4_Q (M1 et M3 : dernier octet de 4 bits)
+static const unsigned char nb_bits_donnees[8] = { 20, 40, 32, 84, 68, 128, 112, 80 };
+
+/// indice 0..3 d'un mode NUMERIC, ALPHANUM, ASCII ou KANJI
+#define INDICE_MODE(mode)   ((mode)==NUMERIC ? 0 : (mode)==ALPHANUM ? 1 : (mode)==ASCII ? 2 : 3)
+
+/// taille du champ "nombre de caracteres" [mode][largeur M1..M4] (ISO18004/2015 table 3), 0 = mode non supporté
+static const unsigned char nb_bits_compteur[4][4] =
+{
+    { 3, 4, 5, 6 },     // NUMERIC
+    { 0, 3, 4, 5 },     // ALPHANUM
+    { 0, 0, 4, 5 },     // ASCII (octets)
+    { 0, 0, 3, 4 }      // KANJI
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn static int taille_entete_flux(unsigned short int version, unsigned short int mode)
+/// \brief nombre de bits de l'entete d'un segment (indicateur de mode + nombre de caracteres), -1 si la version ne supporte pas le mode
+static int taille_entete_flux(unsigned short int version, unsigned short int mode)
+{
+    int taille = TAILLE_VERSION(version & 7);
+    int nb_bits_nb_car = nb_bits_compteur[INDICE_MODE(mode)][taille];
+
+    return (nb_bits_nb_car == 0) ? -1 : taille + nb_bits_nb_car;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn void demarre_flux(QRflux_t *flux, unsigned char packedbyteDS[24])
+/// \brief Sujets 3 (complement) : prepare l'ecriture d'un flux binaire directement dans packedbyteDS
+/// \param[out] flux : le flux a demarrer
+/// \param[out] packedbyteDS[24] : le tableau d'octets qui recevra le flux
+void demarre_flux(QRflux_t *flux, unsigned char packedbyteDS[24])
+{
+    flux->accumulateur = 0;
+    flux->nb_bits_accu = 0;
+    flux->nb_bits      = 0;
+    flux->index_octet  = 0;
+    flux->packedbyteDS = packedbyteDS;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn void ecrit_bits_flux(QRflux_t *flux, uint32_t valeur, int nb_bits)
+/// \brief Sujets 3 (complement) : ajoute un groupe de bits (poids fort en tete) au flux
+///        des que 32 bits sont en attente, ils sont ecrits d'un coup (4 octets)
+/// \param[in,out] flux : le flux
+/// \param[in] valeur : les bits a ecrire, alignés sur le poids faible
+/// \param[in] nb_bits : nombre de bits a ecrire (0 a 32)
+void ecrit_bits_flux(QRflux_t *flux, uint32_t valeur, int nb_bits)
+{
+    uint32_t mot;
+    unsigned char *octet;
+    flux->accumulateur  = (flux->accumulateur << nb_bits) | (valeur & (uint32_t)((1ULL << nb_bits) - 1));
+    flux->nb_bits_accu += nb_bits;
+    flux->nb_bits      += nb_bits;
+    if(flux->nb_bits_accu >= 32)
+    {
+        flux->nb_bits_accu -= 32;
+        mot   = (uint32_t)(flux->accumulateur >> flux->nb_bits_accu);
+        octet = flux->packedbyteDS + flux->index_octet;
+        octet[0] = (unsigned char)(mot >> 24);
+        octet[1] = (unsigned char)(mot >> 16);
+        octet[2] = (unsigned char)(mot >> 8);
+        octet[3] = (unsigned char)mot;
+        flux->index_octet += 4;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn int ecrit_entete_flux(QRflux_t *flux, unsigned short int version, unsigned short int mode, int nb_caracteres)
+/// \brief Sujets 3 (complement) : ecrit l'indicateur de mode (0 bit en M1, 1 en M2, 2 en M3, 3 en M4)
+///        puis le nombre de caracteres sur la taille prévue par la norme
+/// \param[in,out] flux : le flux
+/// \param[in] version : parmi M1_, M2_L ... M4_Q
+/// \param[in] mode : parmi NUMERIC, ALPHANUM, ASCII, KANJI
+/// \param[in] nb_caracteres : nombre de caracteres du segment
+/// \return -1 si le mode n'est pas supporté par la version ou si nb_caracteres est trop grand, 0 si non
+int ecrit_entete_flux(QRflux_t *flux, unsigned short int version, unsigned short int mode, int nb_caracteres)
+{
+    int taille = TAILLE_VERSION(version & 7);
+    int indice = INDICE_MODE(mode);
+    int nb_bits_nb_car = nb_bits_compteur[indice][taille];
+
+    if((nb_bits_nb_car == 0) || (nb_caracteres >= (1 << nb_bits_nb_car)))
+    {
+        return -1;
+    }
+    // indicateur de mode des microQRcode : 0 numerique, 1 alphanum, 2 octets, 3 kanji sur "taille" bits
+    ecrit_bits_flux(flux, indice, taille);
+    ecrit_bits_flux(flux, nb_caracteres, nb_bits_nb_car);
+    return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn int termine_flux(QRflux_t *flux, unsigned short int version)
+/// \brief Sujets 3 (complement) : termine le flux de données (ISO18004/2015 §7.4.9 et 7.4.10) :
+///        terminateur (3, 5, 7 ou 9 zeros selon M1..M4, tronqué si la place manque), zeros jusqu'a la fin de l'octet,
+///        octets de bourrage 0xEC/0x11 alternés, puis demi-octet final a 0 en M1/M3.
+///        en M1/M3 le dernier octet de données (4 bits) est ainsi calé sur le MSB de l'octet
+/// \param[in,out] flux : le flux
+/// \param[in] version : parmi M1_, M2_L ... M4_Q
+/// \return nombre de bits de données ecrits, ou -1 si le flux dépasse la capacité de la version
+int termine_flux(QRflux_t *flux, unsigned short int version)
+{
+    int capacite = nb_bits_donnees[version & 7];
+    int terminateur = 3 + 2*TAILLE_VERSION(version & 7);
+    int nb_bits_data = flux->nb_bits;
+    int nb, bourrage = 0xEC;
+
+    if(nb_bits_data > capacite)
+    {
+        return -1;
+    }
+    nb = capacite - flux->nb_bits;                       // terminateur, tronqué si besoin
+    ecrit_bits_flux(flux, 0, (nb < terminateur) ? nb : terminateur);
+    nb = (8 - (flux->nb_bits & 7)) & 7;                  // fin de l'octet en cours
+    if(flux->nb_bits + nb > capacite)
+    {
+        nb = capacite - flux->nb_bits;
+    }
+    ecrit_bits_flux(flux, 0, nb);
+    while(flux->nb_bits + 8 <= capacite)                 // octets de bourrage
+    {
+        ecrit_bits_flux(flux, bourrage, 8);
+        bourrage ^= 0xEC ^ 0x11;
+    }
+    ecrit_bits_flux(flux, 0, capacite - flux->nb_bits);  // demi-octet final en M1/M3
+
+    // vidange de l'accumulateur, le dernier octet est complété par des zeros
+    while(flux->nb_bits_accu > 0)
+    {
+        if(flux->nb_bits_accu >= 8)
+        {
+            flux->nb_bits_accu -= 8;
+            flux->packedbyteDS[flux->index_octet++] = (unsigned char)(flux->accumulateur >> flux->nb_bits_accu);
+        }
+        else
+        {
+            flux->packedbyteDS[flux->index_octet++] = (unsigned char)(flux->accumulateur << (8 - flux->nb_bits_accu));
+            flux->nb_bits_accu = 0;
+        }
+    }
+    return nb_bits_data;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn int flux_to_binaryDS(const QRflux_t *flux, unsigned char binaryDS[24*8])
+/// \brief Sujets 3 (complement) : recopie les bits d'un flux non terminé (octets deja ecrits puis accumulateur)
+///        en binaryDS, 1 octet par bit, suivis de 255 (fin de chaine binaire)
+/// \param[in]  flux : le flux
+/// \param[out] binaryDS[24*8] : la chaine binaire
+/// \return nombre de bits du flux
+int flux_to_binaryDS(const QRflux_t *flux, unsigned char binaryDS[24*8])
+{
+    int k, nb_ecrits = 8*flux->index_octet;
+
+    for(k=0; k<nb_ecrits; k++)
+    {
+        binaryDS[k] = (flux->packedbyteDS[k >> 3] >> (7 - (k & 7))) & 1;
+    }
+    for(; k<flux->nb_bits; k++)
+    {
+        binaryDS[k] = (unsigned char)((flux->accumulateur >> (flux->nb_bits - 1 - k)) & 1);
+    }
+    if(k < 24*8)
+    {
+        binaryDS[k] = 255;
+    }
+    return flux->nb_bits;
+}
+
+// mode numerique : groupes de 3 chiffres sur 10 bits (000..999), le dernier groupe de 1 ou 2 chiffres sur 4 ou 7 bits.
+// les chiffres sont recopiés dans un tampon complété par des '0' : la validation se fait 16 chiffres a la fois
+// (compare + movemask) et la conversion 4 triplets a la fois (pshufb, puis multiplications-additions 100a+10b+c).
+// un groupe incomplet "d" ou "de" devient "d00" ou "de0" : sa valeur est celle du triplet divisée par 100 ou 10.
+
+#define LONGUEUR_NUMERIC_MAX  35        /** nombre maximal de chiffres d'un microQRcode (M4_L)          */
+
+/// nombre de bits du dernier groupe selon le nombre de chiffres restants (0, 1 ou 2)
+static const unsigned char nb_bits_reste_numeric[3] = { 0, 4, 7 };
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn static int chiffres_valides(const unsigned char chiffres[64])
+/// \brief vérifie que les 48 premiers octets du tampon sont des chiffres '0'..'9'
+static int chiffres_valides(const unsigned char chiffres[64])
+{
+#if defined(__SSE2__)
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i neuf = _mm_set1_epi8(9);
+    __m128i valeur;
+    int k, valides = 0xFFFF;
+
+    for(k=0; k<48; k+=16)
+    {
+        // c - '0' (sans signe) <= 9  <=>  min(c - '0', 9) == c - '0'
+        valeur = _mm_sub_epi8(_mm_loadu_si128((const __m128i *)(chiffres + k)), zero);
+        valides &= _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(valeur, neuf), valeur));
+    }
+    return valides == 0xFFFF;
+#else
+    int k, invalides = 0;
+
+    for(k=0; k<48; k++)
+    {
+        invalides |= ((unsigned char)(chiffres[k] - '0') > 9);
+    }
+    return !invalides;
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn static void triplets_numeric(const unsigned char chiffres[64], int nb_groupes, uint32_t groupes[16])
+/// \brief valeur (0..999) des nb_groupes premiers triplets de chiffres
+static void triplets_numeric(const unsigned char chiffres[64], int nb_groupes, uint32_t groupes[16])
+{
+    int k;
+#if defined(__SSSE3__)
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i rangement = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);  // un triplet par mot de 32 bits
+    const __m128i poids = _mm_setr_epi8(100, 10, 1, 0, 100, 10, 1, 0, 100, 10, 1, 0, 100, 10, 1, 0);
+    const __m128i un = _mm_set1_epi16(1);
+    __m128i valeur;
+
+    for(k=0; k<nb_groupes; k+=4)
+    {
+        valeur = _mm_sub_epi8(_mm_loadu_si128((const __m128i *)(chiffres + 3*k)), zero);
+        valeur = _mm_shuffle_epi8(valeur, rangement);
+        valeur = _mm_maddubs_epi16(valeur, poids);      // 100a+10b et c, sur 16 bits
+        valeur = _mm_madd_epi16(valeur, un);            // 100a+10b+c, sur 32 bits
+        _mm_storeu_si128((__m128i *)(groupes + k), valeur);
+    }
+#else
+    for(k=0; k<nb_groupes; k++)
+    {
+        groupes[k] = 100*chiffres[3*k] + 10*chiffres[3*k+1] + chiffres[3*k+2] - 111*'0';
+    }
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn int numeric_to_flux(const unsigned char *data_string, int longueur, QRflux_t *flux, unsigned short int version)
+/// \brief Sujets 3 (complement) : comme numeric_to_binaryDS, mais ecrit directement dans le flux en octets
+/// \param[in] data_string : chiffres a encoder
+/// \param[in] longueur : nombre de chiffres
+/// \param[in,out] flux : le flux
+/// \param[in] version : parmi M1_ ... M4_Q
+/// \return nombre de bits ecrits, -1 si mode/version incompatibles ou chaine invalide
+int numeric_to_flux(const unsigned char *data_string, int longueur, QRflux_t *flux, unsigned short int version)
+{
+    unsigned char chiffres[64];         // les chiffres complétés par des '0' (lectures de 16 octets sans dépassement)
+    uint32_t groupes[16];
+    int nb_bits, nb_complets, reste, k;
+
+    // capacité vérifiée avant tout travail (et avant d'ecrire dans le flux)
+    if(longueur < 0 || longueur > LONGUEUR_NUMERIC_MAX)
+    {
+        return -1;
+    }
+    nb_complets = longueur / 3;
+    reste = longueur % 3;
+    nb_bits = taille_entete_flux(version, NUMERIC) + 10*nb_complets + nb_bits_reste_numeric[reste];
+    if(flux->nb_bits + nb_bits > nb_bits_donnees[version & 7])
+    {
+        return -1;
+    }
+    memcpy(chiffres, data_string, longueur);
+    memset(chiffres + longueur, '0', sizeof(chiffres) - longueur);
+    if(!chiffres_valides(chiffres))
+    {
+        return -1;
+    }
+    triplets_numeric(chiffres, nb_complets + (reste != 0), groupes);
+
+    if(ecrit_entete_flux(flux, version, NUMERIC, longueur) < 0)
+    {
+        return -1;
+    }
+    for(k=0; k+3<=nb_complets; k+=3)                    // 3 groupes (30 bits) par ecriture
+    {
+        ecrit_bits_flux(flux, (groupes[k] << 20) | (groupes[k+1] << 10) | groupes[k+2], 30);
+    }
+    for(; k<nb_complets; k++)
+    {
+        ecrit_bits_flux(flux, groupes[k], 10);
+    }
+    if(reste != 0)
+    {
+        ecrit_bits_flux(flux, groupes[k] / (reste == 1 ? 100 : 10), nb_bits_reste_numeric[reste]);
+    }
+    return nb_bits;
+}
+
+// mode alphanumerique : 45 caracteres (0-9, A-Z, espace $ % * + - . / :), paires de caracteres a et b sur 11 bits (45a+b),
+// le dernier caractere d'une chaine de longueur impaire sur 6 bits.
+// la valeur de chaque caractere est lue dans une table de 256 octets calculée a la compilation ;
+// un caractere hors du jeu vaut 0xFF : il suffit d'un OU de toutes les valeurs pour valider la chaine (bit 7 a 1).
+
+#define LONGUEUR_ALPHANUM_MAX  21       /** nombre maximal de caracteres alphanumeriques d'un microQRcode (M4_L) */
+
+#define VALEUR_ALPHANUM(c)  ((c)>='0' && (c)<='9' ? (c)-'0' : (c)>='A' && (c)<='Z' ? (c)-'A'+10 : \
+                             (c)==' ' ? 36 : (c)=='$' ? 37 : (c)=='%' ? 38 : (c)=='*' ? 39 : (c)=='+' ? 40 : \
+                             (c)=='-' ? 41 : (c)=='.' ? 42 : (c)=='/' ? 43 : (c)==':' ? 44 : 0xFF)
+#define VALEURS_ALPHANUM(c) \
+    VALEUR_ALPHANUM((c)+0),  VALEUR_ALPHANUM((c)+1),  VALEUR_ALPHANUM((c)+2),  VALEUR_ALPHANUM((c)+3),  \
+    VALEUR_ALPHANUM((c)+4),  VALEUR_ALPHANUM((c)+5),  VALEUR_ALPHANUM((c)+6),  VALEUR_ALPHANUM((c)+7),  \
+    VALEUR_ALPHANUM((c)+8),  VALEUR_ALPHANUM((c)+9),  VALEUR_ALPHANUM((c)+10), VALEUR_ALPHANUM((c)+11), \
+    VALEUR_ALPHANUM((c)+12), VALEUR_ALPHANUM((c)+13), VALEUR_ALPHANUM((c)+14), VALEUR_ALPHANUM((c)+15)
+
+/// valeur (0..44) de chaque caractere dans le mode alphanumerique, 0xFF si le caractere n'en fait pas partie
+static const unsigned char valeur_alphanum[256] =
+{
+    VALEURS_ALPHANUM(0x00), VALEURS_ALPHANUM(0x10), VALEURS_ALPHANUM(0x20), VALEURS_ALPHANUM(0x30),
+    VALEURS_ALPHANUM(0x40), VALEURS_ALPHANUM(0x50), VALEURS_ALPHANUM(0x60), VALEURS_ALPHANUM(0x70),
+    VALEURS_ALPHANUM(0x80), VALEURS_ALPHANUM(0x90), VALEURS_ALPHANUM(0xA0), VALEURS_ALPHANUM(0xB0),
+    VALEURS_ALPHANUM(0xC0), VALEURS_ALPHANUM(0xD0), VALEURS_ALPHANUM(0xE0), VALEURS_ALPHANUM(0xF0)
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn int alphanum_to_flux(const unsigned char *data_string, int longueur, QRflux_t *flux, unsigned short int version)
+/// \brief Sujets 3 (complement) : comme alphanum_to_binaryDS, mais ecrit directement dans le flux en octets
+/// \param[in] data_string : caracteres (parmi 45) a encoder
+/// \param[in] longueur : nombre de caracteres
+/// \param[in,out] flux : le flux
+/// \param[in] version : parmi M2_L ... M4_Q
+/// \return nombre de bits ecrits, -1 si mode/version incompatibles ou chaine invalide
+int alphanum_to_flux(const unsigned char *data_string, int longueur, QRflux_t *flux, unsigned short int version)
+{
+    unsigned char valeurs[LONGUEUR_ALPHANUM_MAX + 1];
+    unsigned char invalides = 0;
+    int nb_bits, taille_entete, nb_paires, k;
+
+    // capacité vérifiée avant tout travail (et avant d'ecrire dans le flux)
+    taille_entete = taille_entete_flux(version, ALPHANUM);
+    if(taille_entete < 0 || longueur < 0 || longueur > LONGUEUR_ALPHANUM_MAX)
+    {
+        return -1;
+    }
+    nb_paires = longueur / 2;
+    nb_bits = taille_entete + 11*nb_paires + 6*(longueur & 1);
+    if(flux->nb_bits + nb_bits > nb_bits_donnees[version & 7])
+    {
+        return -1;
+    }
+    // une lecture de table par caractere, puis un seul test sur le OU de toutes les valeurs
+    for(k=0; k<longueur; k++)
+    {
+        valeurs[k] = valeur_alphanum[data_string[k]];
+        invalides |= valeurs[k];
+    }
+    if(invalides & 0x80)
+    {
+        return -1;
+    }
+
+    if(ecrit_entete_flux(flux, version, ALPHANUM, longueur) < 0)
+    {
+        return -1;
+    }
+    for(k=0; k+4<=longueur; k+=4)                       // 2 paires (22 bits) par ecriture
+    {
+        ecrit_bits_flux(flux, ((45*valeurs[k] + valeurs[k+1]) << 11) | (45*valeurs[k+2] + valeurs[k+3]), 22);
+    }
+    for(; k+2<=longueur; k+=2)
+    {
+        ecrit_bits_flux(flux, 45*valeurs[k] + valeurs[k+1], 11);
+    }
+    if(k < longueur)
+    {
+        ecrit_bits_flux(flux, valeurs[k], 6);
+    }
+    return nb_bits;
+}
+
+// mode octets : chaque caractere est recopié tel quel sur 8 bits apres l'entete
+
+#define LONGUEUR_ASCII_MAX  15          /** nombre maximal d'octets d'un microQRcode (M4_L)                      */
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn int ascii_to_flux(const unsigned char *data_string, int longueur, QRflux_t *flux, unsigned short int version)
+/// \brief Sujets 3 (complement) : comme ascii_to_binaryDS, mais ecrit directement dans le flux en octets
+/// \param[in] data_string : octets a encoder
+/// \param[in] longueur : nombre d'octets
+/// \param[in,out] flux : le flux
+/// \param[in] version : parmi M3_L ... M4_Q
+/// \return nombre de bits ecrits, -1 si mode/version incompatibles ou chaine trop longue
+int ascii_to_flux(const unsigned char *data_string, int longueur, QRflux_t *flux, unsigned short int version)
+{
+    int nb_bits, taille_entete, k;
+
+    // capacité vérifiée avant tout travail (et avant d'ecrire dans le flux)
+    taille_entete = taille_entete_flux(version, ASCII);
+    if(taille_entete < 0 || longueur < 0 || longueur > LONGUEUR_ASCII_MAX)
+    {
+        return -1;
+    }
+    nb_bits = taille_entete + 8*longueur;
+    if(flux->nb_bits + nb_bits > nb_bits_donnees[version & 7])
+    {
+        return -1;
+    }
+
+    if(ecrit_entete_flux(flux, version, ASCII, longueur) < 0)
+    {
+        return -1;
+    }
+    // l'entete (2+4 bits en M3, 3+5 bits en M4) décale les octets : ils passent par l'accumulateur 4 a la fois,
+    // le décalage est fait une fois par mot de 32 bits et non bit a bit
+    for(k=0; k+4<=longueur; k+=4)
+    {
+        ecrit_bits_flux(flux, ((uint32_t)data_string[k] << 24) | ((uint32_t)data_string[k+1] << 16)
+                            | ((uint32_t)data_string[k+2] << 8) | data_string[k+3], 32);
+    }
+    for(; k<longueur; k++)
+    {
+        ecrit_bits_flux(flux, data_string[k], 8);
+    }
+    return nb_bits;
+}
+
+// mode kanji : chaque caractere de la table Shift-JIS a 2 octets (JIS X 0208, 0x8140..0x9FFC et 0xE040..0xEBBF) sur 13 bits :
+// on retire 0x8140 (ou 0xC140) au code Shift-JIS, puis valeur = octet de poids fort * 0xC0 + octet de poids faible.
+// la chaine est en UTF-8 : le point de code est converti par une table creuse plutot qu'une table de 65536 entrées (128 Ko).
+// seules les pages de 256 points de code qui contiennent des kanji ont une entrée (page_kanji), chacune découpée
+// en 8 blocs de 32 bits de présence : le rang du caractere dans valeur_kanji est le rang du bloc + le nombre de bits
+// a 1 qui le précedent dans son bloc (popcount). au total 17 Ko, dont 13,4 Ko pour les 6879 valeurs elles-memes.
+// tables générées a partir du codec shift_jis de Python (toutes les paires d'octets des 2 plages, décodées en UTF-16).
+
+#define LONGUEUR_KANJI_MAX  9           /** nombre maximal de caracteres kanji d'un microQRcode (M4_L)           */
+
+#define NB_PAGES_KANJI  93       /** pages de 256 points de code contenant au moins un caractere kanji */
+#define NB_KANJI        6879     /** caracteres du mode kanji (JIS X 0208)                             */
+
+/// n° de page (0 a NB_PAGES_KANJI-1) de chaque page de 256 points de code, 0xFF si la page ne contient aucun kanji
+static const unsigned char page_kanji[256] =
+{
+    0x00, 0xFF, 0xFF, 0x01, 0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x03, 0x04, 0x05, 0x06, 0xFF, 0x07, 0x08, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0A, 0x0B,
+    0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B,
+    0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B,
+    0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B,
+    0x3C, 0x3D, 0x3E, 0x3F, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B,
+    0x4C, 0x4D, 0x4E, 0x4F, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x5B,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x5C
+};
+
+/// points de code présents dans chaque bloc de 32 (8 blocs par page) : bit b = point de code (page, 32*bloc + b)
+static const uint32_t presence_kanji[NB_PAGES_KANJI*8] =
+{
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x0053118C, 0x00800000, 0x00800000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xFFFE0000, 0xFFFE03FB, 0x000003FB, 0x00000000,
+    0xFFFF0002, 0xFFFFFFFF, 0x0002FFFF, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x33610000, 0x080D0063, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000008, 0x00000800, 0x00000000, 0x00000000, 0x000F0000, 0x00000000, 0x00140000, 0x00000000,
+    0x6404098D, 0x20301F81, 0x00040000, 0x00000CC3, 0x000000CC, 0x00000020, 0x00000000, 0x00000000,
+    0x00040000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x3999900F, 0x99999939, 0x00000804, 0x00000000, 0x00000000, 0x300C0003, 0x0000C8C0, 0x00008000,
+    0x00000060, 0x00000000, 0x00000005, 0x0000A400, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x103FFFEF, 0x00000000, 0xFFFFFFFE, 0xFFFFFFFF, 0x780FFFFF, 0xFFFFFFFE, 0xFFFFFFFF, 0x787FFFFF,
+    0x43F36F8B, 0x9B462442, 0xE3E0E82C, 0x400A0004, 0xDB365F65, 0x04497977, 0xE3F0ECD7, 0x08C56038,
+    0x3403E602, 0x35518000, 0x7EABE0C8, 0x98698200, 0x2942A948, 0x8060E803, 0xAD93441C, 0x4568C03A,
+    0x8656AA60, 0x02403F7A, 0x14618388, 0x21741020, 0x07022021, 0x40BC3000, 0x4462A624, 0x0A2060A8,
+    0x85740217, 0x9C840402, 0x14157BFB, 0x11E27F24, 0x02EFB665, 0x20FF1F75, 0x38403A70, 0x676326C3,
+    0x20924DD9, 0x0FC946B0, 0x4850BC98, 0xA03F8638, 0x88162388, 0x52323E09, 0xE3A422AA, 0xC72C00DD,
+    0x26E1A166, 0x8F0A840B, 0x559E27EB, 0x89BBC241, 0x85400014, 0x08496361, 0x8AD07F0C, 0x05CFFF3E,
+    0xA803FF1A, 0x7B407A41, 0x80024745, 0x38EB0500, 0x0005D851, 0x710C9934, 0x01000397, 0x24046366,
+    0x005180D0, 0x430AC000, 0x30C89071, 0x58000008, 0xF7000E99, 0x00415F80, 0x941000B0, 0x62800018,
+    0x09D00240, 0x01568200, 0x08015004, 0x05101D10, 0x001084C1, 0x10504025, 0x4D8A410F, 0xA60D4009,
+    0x914CAB19, 0x098121C0, 0x0003C485, 0x80000652, 0x00080B04, 0x0009041D, 0x905C4849, 0x16900009,
+    0x22200C65, 0x24338412, 0x47960C03, 0x42250A04, 0x90880028, 0x4F084900, 0xD3AA14A2, 0x3E87D830,
+    0x1F618604, 0x41867EA4, 0x05B3C390, 0x211857A5, 0x2A48241E, 0x4A041128, 0x161B0A40, 0x88400D60,
+    0x9502020A, 0x10608221, 0x04000243, 0x80001444, 0x0C040000, 0x70000000, 0x00C11A06, 0x0C00024A,
+    0x00401A00, 0x40451404, 0xBDB30029, 0x052B0A78, 0xBFA0BBA9, 0x8379407C, 0xE81D12FC, 0xC5694BF6,
+    0x044AEFF6, 0xFF022115, 0x402BED63, 0x0242D033, 0x00131000, 0x59CA1B02, 0x020000A0, 0x2C41A703,
+    0x8FF24880, 0x00000204, 0x10055800, 0x00489200, 0x20011894, 0x34805004, 0x684C3200, 0x68BE49EA,
+    0x2E42184C, 0x21C9A820, 0x80B050B9, 0xFF7C001E, 0x14E0849A, 0x01E028C1, 0xAC49870E, 0xDDDB130F,
+    0x89FBBE1A, 0x51A2A2E0, 0x32CA5502, 0x928B3E46, 0x438F1DBF, 0x32186703, 0x33C03028, 0xA9230811,
+    0x3A65C000, 0x04028FE3, 0x86252C4E, 0x00A1BF3D, 0x8CD43A1A, 0x317C06C9, 0x950A00E0, 0x0EDB018B,
+    0x8C20E34B, 0xF0101182, 0xA7287D94, 0x40FBC9AC, 0x06534484, 0x44445A90, 0x00013FC8, 0xF5D40048,
+    0xEC577701, 0x891DC442, 0x49286B83, 0xD2424109, 0x59FE061D, 0x3A221800, 0x3B9FB7E4, 0xC0EAF003,
+    0x82021386, 0xE4008980, 0x10A1B200, 0x0CC44B80, 0x8944D309, 0x48341FAF, 0x0C458259, 0x0450420A,
+    0x10C8A040, 0x44503140, 0x01004004, 0x05408280, 0x442C0108, 0x1A056A30, 0x051420A6, 0x645690CF,
+    0x31000021, 0xCBF09C18, 0x63E2A120, 0x01B5104C, 0x9A83538C, 0x3281B8B2, 0x0A84987A, 0x0C0233E7,
+    0x9018D4CC, 0x9070A1A1, 0xE0048A1E, 0x0451C3D4, 0x21C2439A, 0x53104844, 0x36400292, 0xF3BD0241,
+    0xE8F0AB09, 0xA5D27DC0, 0xD24BC242, 0xD0AFA43F, 0x34A11AA0, 0x03D88247, 0x651BC452, 0xC83AD294,
+    0x40C8001C, 0x33140E06, 0xB21B614F, 0xC0D00088, 0xA898A02A, 0x166BA1C5, 0x85B42E50, 0x0604C08B,
+    0x1E04F933, 0xA251056E, 0x76380400, 0x73B8EC07, 0x18324406, 0xC8164081, 0x63097C8A, 0xAA042980,
+    0xCA9C1C24, 0x27604E0E, 0x83000990, 0x81040046, 0x10816011, 0x0908540D, 0xCC0A000E, 0x0C000500,
+    0xA0440430, 0x6784008B, 0x8A195288, 0x8B18865E, 0x41602E59, 0x9CBE8C10, 0x891C6861, 0x00089800,
+    0x089A8100, 0x41900018, 0xE4A14007, 0x640D0505, 0x0E4D310E, 0xFF0A4806, 0x2AA81632, 0x000B852E,
+    0xCA841800, 0x696C0E20, 0x16000032, 0x03905658, 0x1A285120, 0x11248000, 0x432618E1, 0x0EAA5D52,
+    0xAE280FA0, 0x4500FA7B, 0x89406408, 0xC044C880, 0xB1419005, 0x24C48424, 0x603A1A34, 0xC1949000,
+    0x003A8246, 0xC106180D, 0x99100022, 0x1511E050, 0x00824057, 0x020A041A, 0x8930004F, 0x444AD813,
+    0xED228A02, 0x400510C0, 0x01021000, 0x31018808, 0x02044600, 0x0708F000, 0xA2008900, 0x22020000,
+    0x16100200, 0x10400042, 0x02605200, 0x200052F4, 0x82308510, 0x42021100, 0x80B54308, 0x9A2070E1,
+    0x08012040, 0xFC653500, 0xAB0419C1, 0x62140286, 0x00440087, 0x02449085, 0x0A85405C, 0x33803207,
+    0xB8C00400, 0xC0D0CE20, 0x0080C030, 0x0D250508, 0x00400A90, 0x080C0200, 0x40006505, 0x41026421,
+    0x00000268, 0x847C0024, 0xDE200002, 0x40498619, 0x40000808, 0x20010084, 0x10108400, 0x01C742CD,
+    0xD52A7038, 0x1D8F1968, 0x3E12BE50, 0x81D92EF5, 0x2412CEC4, 0x732E0828, 0x4B3424AC, 0xD41D020C,
+    0x80002A02, 0x08110097, 0x114411C4, 0x7D451786, 0x064949D9, 0x87914000, 0xD8C4254C, 0x491444BA,
+    0xC8001B92, 0x15800271, 0x0C000081, 0xC200096A, 0x40024800, 0xBA493021, 0x1C802080, 0x1008E2AC,
+    0x00341004, 0x841400E1, 0x20000020, 0x10149800, 0x04AA70C2, 0x54208688, 0x04130C62, 0x20109180,
+    0x02064082, 0x54001C40, 0xE4E90383, 0x84802125, 0x2000E433, 0xE60944C0, 0x81260A03, 0x080112DA,
+    0x97906901, 0xF8864001, 0x0081E24D, 0xA6510A0E, 0x81EC011A, 0x8441C600, 0xB62CADB8, 0x8741A46F,
+    0x4B028D54, 0x02681161, 0x2057BB60, 0x043350A0, 0xB7B4A8C0, 0x01122402, 0x20009AD3, 0x00C82271,
+    0x809E2081, 0xE1800C8A, 0x8151B009, 0x40281031, 0x89A52A0E, 0x620E69B6, 0xD1444425, 0x4D548085,
+    0x1FB12C75, 0x862DD807, 0x4841D87C, 0x226E414E, 0x9E088200, 0xED37F80C, 0x75268C80, 0x08149313,
+    0xC8040E32, 0x6EA6484E, 0x66702C4A, 0xBA0126C0, 0x185DD30C, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x05400000, 0x81337020, 0x03A54F81, 0x641055EC, 0x2344C318, 0x00341462, 0x1A090A43,
+    0x13A5187B, 0xA8480102, 0xC5440440, 0xE2DD8106, 0x2D481AF0, 0x0416B626, 0x6E405058, 0x31128032,
+    0x0C0007E4, 0x420A8208, 0x803B4840, 0x87134860, 0x3428850D, 0xE5290319, 0x870A2345, 0x5C1825A9,
+    0xD9C577A6, 0x03E85E00, 0xA7000081, 0x41C6CD54, 0xA2042800, 0x2B0AB860, 0xDA9E0020, 0x0E1A08EA,
+    0x11C0427C, 0x03768908, 0x01058621, 0x18A80000, 0xC44846A0, 0x20220D05, 0x91485422, 0x28978A01,
+    0x00087898, 0x31221605, 0x08804240, 0x06A2FA4E, 0x92110814, 0x9B042002, 0x06432E52, 0x90105000,
+    0x85BA0041, 0x20203042, 0x05A04F0B, 0x40802708, 0x1A930591, 0x0600DF50, 0x3021A202, 0x4E800630,
+    0x04C80CC4, 0x8001A004, 0xD4316000, 0x0A020880, 0x00281C00, 0x00418E18, 0xCA106AD0, 0x4B00F210,
+    0x1506274D, 0x88900220, 0x82A85A00, 0x81504549, 0x80002004, 0x2C088804, 0x000508D1, 0x4AC48001,
+    0x0062E020, 0x0A42008E, 0x6A8C3055, 0xE0A5090E, 0x42C42906, 0x80B34814, 0xB330803E, 0x731C0102,
+    0x600D1494, 0x09400C20, 0xC040301A, 0xC094A451, 0x05C88DCA, 0xA40C96C2, 0x34040001, 0x011000C8,
+    0xA9C9550D, 0x1C5A2428, 0x48370142, 0x100F7A4D, 0x452A32B4, 0x9205317B, 0x5C44B894, 0x458A68D7,
+    0x2ED15097, 0x42081943, 0x9D40D202, 0x20979840, 0x064D5409, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x84800000, 0x04215542, 0x17001C06, 0x61107624, 0xB9DDFF87, 0x5C0A659F, 0x3C00245D,
+    0x0059ADB0, 0x00000000, 0x00000000, 0x009B28D0, 0x02000422, 0x44080108, 0xAC409804, 0x90288D0A,
+    0xE0018700, 0x00310400, 0x82211794, 0x10540019, 0x021A2CB2, 0x40039C02, 0x88043D60, 0x7900080C,
+    0xBA3C1628, 0xCB088640, 0x90807274, 0x0000001E, 0xD8000000, 0x9C87E188, 0x04124034, 0x2791AE64,
+    0xE6FBE86B, 0x5366408F, 0x537FEEA6, 0xB5E4E32B, 0x0002869F, 0x01228548, 0x08004402, 0x20A02116,
+    0x02040004, 0x00052000, 0x01547E00, 0x01AC162C, 0x10852A84, 0x05308C14, 0xB943FBC3, 0x906000CA,
+    0x40326000, 0x80901200, 0x4C810B30, 0x40020054, 0x1D6A0029, 0x02802000, 0x00048000, 0x150C2610,
+    0x07018040, 0x0C24D94D, 0x18502810, 0x50205001, 0x04D01000, 0x02017080, 0x21C30108, 0x00000132,
+    0x07190088, 0x05600802, 0x4C0E0012, 0xF0A10405, 0x00000002, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00800000, 0x035A8E8D, 0x5A0421BD, 0x11703488, 0x00000026,
+    0x10000000, 0x8804C502, 0xF801B815, 0x25ED147C, 0x1BB0ED60, 0x1BD70589, 0x1A627AF3, 0x0AC50D0C,
+    0x524AE5D1, 0x63050490, 0x52440354, 0x16122B57, 0x1101A872, 0x00182949, 0x10080948, 0x886C6000,
+    0x058F916E, 0x39903012, 0x4930F840, 0x001B8880, 0x00000000, 0x00428500, 0x98000058, 0x7014EA04,
+    0x611D1628, 0x60005113, 0x00A71A24, 0x00000000, 0x03C00000, 0x10187120, 0xA9270172, 0x89066004,
+    0x020CC022, 0x40810900, 0x8CA0202D, 0x00000E34, 0x00000000, 0x11012100, 0xC11A8011, 0x0892EC4C,
+    0x85000040, 0x1806C7AC, 0x0512E03E, 0x00108000, 0x80CE4008, 0x02106D01, 0x08568641, 0x0027011E,
+    0x083D3750, 0x4E05E032, 0x048401C0, 0x01400081, 0x00000000, 0x00000000, 0x00000000, 0x00591AA0,
+    0x882443C8, 0xC8001D48, 0x72030152, 0x04049013, 0x04008280, 0x0D148A10, 0x02088056, 0x2704A040,
+    0x4C000000, 0x00000000, 0x00000000, 0xA3200000, 0xA0AE1902, 0xDF002660, 0x7B15F010, 0x3AD08121,
+    0x00284180, 0x48001003, 0x8014CC00, 0x00C414CF, 0x30202000, 0x00000001, 0x00000000, 0x00000000,
+    0xFFFFDF7A, 0xFFFFFFFF, 0x3FFFFFFF, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000028
+};
+
+/// rang (dans valeur_kanji) du premier caractere de chaque bloc de 32
+static const uint16_t rang_kanji[NB_PAGES_KANJI*8] =
+{
+       0,    0,    0,    0,    0,    0,    9,   10,   11,   11,   11,   11,   11,   26,   50,   59,
+      59,   76,  108,  125,  125,  125,  125,  125,  125,  132,  140,  140,  140,  140,  140,  140,
+     140,  141,  142,  142,  142,  146,  146,  148,  148,  158,  168,  169,  175,  179,  180,  180,
+     180,  181,  181,  181,  181,  181,  181,  181,  181,  195,  211,  213,  213,  213,  219,  224,
+     225,  227,  227,  229,  232,  232,  232,  232,  232,  254,  254,  285,  317,  341,  372,  404,
+     431,  450,  462,  477,  481,  501,  516,  536,  546,  557,  565,  582,  591,  602,  611,  625,
+     637,  650,  663,  673,  681,  688,  696,  707,  715,  727,  735,  753,  768,  785,  804,  815,
+     831,  844,  858,  870,  884,  894,  907,  921,  935,  949,  961,  980,  994, 1000, 1011, 1026,
+    1047, 1063, 1077, 1086, 1097, 1106, 1119, 1127, 1138, 1145, 1152, 1163, 1167, 1181, 1190, 1197,
+    1203, 1210, 1217, 1222, 1230, 1236, 1243, 1256, 1266, 1280, 1288, 1296, 1302, 1307, 1314, 1325,
+    1332, 1341, 1351, 1363, 1371, 1377, 1386, 1400, 1415, 1427, 1441, 1454, 1467, 1478, 1486, 1496,
+    1504, 1512, 1519, 1524, 1529, 1532, 1535, 1543, 1549, 1553, 1560, 1574, 1586, 1605, 1619, 1635,
+    1653, 1670, 1684, 1699, 1709, 1713, 1726, 1729, 1741, 1754, 1756, 1762, 1767, 1774, 1781, 1790,
+    1807, 1818, 1828, 1839, 1856, 1867, 1876, 1890, 1909, 1928, 1940, 1952, 1967, 1986, 1998, 2008,
+    2018, 2028, 2040, 2053, 2068, 2082, 2096, 2105, 2119, 2132, 2141, 2157, 2173, 2183, 2193, 2203,
+    2215, 2232, 2244, 2257, 2267, 2284, 2292, 2313, 2326, 2335, 2343, 2351, 2361, 2373, 2389, 2400,
+    2407, 2414, 2422, 2425, 2431, 2438, 2449, 2458, 2473, 2478, 2493, 2505, 2515, 2529, 2542, 2554,
+    2567, 2579, 2590, 2601, 2613, 2625, 2634, 2643, 2658, 2673, 2689, 2702, 2720, 2731, 2743, 2757,
+    2771, 2778, 2789, 2805, 2812, 2823, 2838, 2851, 2860, 2875, 2888, 2897, 2914, 2923, 2932, 2946,
+    2955, 2968, 2981, 2988, 2994, 3001, 3010, 3019, 3023, 3030, 3041, 3052, 3066, 3078, 3092, 3104,
+    3108, 3115, 3121, 3132, 3142, 3155, 3169, 3181, 3191, 3199, 3211, 3217, 3228, 3237, 3242, 3254,
+    3269, 3282, 3297, 3305, 3313, 3323, 3332, 3344, 3352, 3361, 3371, 3378, 3388, 3396, 3403, 3413,
+    3425, 3437, 3443, 3446, 3453, 3458, 3466, 3472, 3475, 3480, 3484, 3490, 3499, 3507, 3512, 3522,
+    3534, 3538, 3552, 3564, 3573, 3579, 3587, 3597, 3608, 3615, 3626, 3631, 3640, 3645, 3649, 3656,
+    3664, 3668, 3677, 3685, 3695, 3698, 3702, 3706, 3719, 3733, 3748, 3763, 3780, 3792, 3804, 3817,
+    3828, 3833, 3841, 3850, 3866, 3879, 3887, 3900, 3912, 3922, 3931, 3935, 3944, 3948, 3960, 3966,
+    3976, 3981, 3989, 3991, 3997, 4008, 4017, 4026, 4032, 4038, 4045, 4059, 4067, 4076, 4087, 4096,
+    4105, 4117, 4127, 4137, 4149, 4160, 4168, 4185, 4200, 4212, 4221, 4235, 4244, 4259, 4265, 4275,
+    4284, 4293, 4303, 4313, 4320, 4333, 4348, 4359, 4370, 4387, 4401, 4414, 4427, 4435, 4453, 4465,
+    4475, 4485, 4500, 4513, 4524, 4538, 4538, 4538, 4538, 4538, 4541, 4551, 4564, 4577, 4588, 4596,
+    4606, 4621, 4628, 4636, 4650, 4663, 4675, 4686, 4695, 4704, 4711, 4720, 4731, 4742, 4755, 4767,
+    4780, 4799, 4810, 4817, 4831, 4837, 4849, 4860, 4872, 4883, 4894, 4902, 4907, 4917, 4925, 4935,
+    4946, 4954, 4964, 4969, 4984, 4992, 5000, 5012, 5017, 5027, 5033, 5045, 5052, 5064, 5075, 5083,
+    5092, 5101, 5106, 5115, 5120, 5125, 5133, 5145, 5155, 5168, 5174, 5183, 5193, 5196, 5203, 5210,
+    5218, 5225, 5233, 5246, 5258, 5268, 5278, 5291, 5301, 5311, 5317, 5325, 5336, 5349, 5361, 5366,
+    5371, 5386, 5397, 5407, 5421, 5434, 5448, 5461, 5476, 5491, 5500, 5511, 5521, 5532, 5532, 5532,
+    5532, 5532, 5535, 5544, 5553, 5564, 5587, 5603, 5614, 5626, 5626, 5626, 5636, 5640, 5645, 5654,
+    5664, 5672, 5676, 5687, 5694, 5705, 5713, 5723, 5731, 5745, 5755, 5766, 5770, 5774, 5788, 5795,
+    5810, 5831, 5845, 5866, 5884, 5894, 5902, 5906, 5914, 5917, 5920, 5930, 5941, 5950, 5959, 5978,
+    5986, 5992, 5997, 6007, 6012, 6023, 6026, 6028, 6037, 6043, 6056, 6063, 6069, 6074, 6080, 6088,
+    6092, 6100, 6106, 6114, 6124, 6125, 6125, 6125, 6125, 6125, 6125, 6125, 6126, 6140, 6153, 6163,
+    6166, 6167, 6175, 6188, 6204, 6219, 6234, 6251, 6262, 6277, 6286, 6296, 6310, 6320, 6328, 6334,
+    6342, 6357, 6367, 6378, 6385, 6385, 6390, 6396, 6407, 6419, 6427, 6437, 6437, 6441, 6449, 6462,
+    6470, 6477, 6482, 6492, 6498, 6498, 6503, 6512, 6524, 6528, 6541, 6553, 6555, 6563, 6571, 6581,
+    6590, 6603, 6615, 6621, 6625, 6625, 6625, 6625, 6634, 6644, 6653, 6663, 6670, 6674, 6683, 6690,
+    6698, 6701, 6701, 6701, 6706, 6717, 6729, 6743, 6754, 6759, 6764, 6771, 6782, 6786, 6787, 6787,
+    6787, 6815, 6847, 6877, 6877, 6877, 6877, 6877
+};
+
+/// valeur sur 13 bits de chaque caractere, dans l'ordre des points de code
+static const uint16_t valeur_kanji[NB_KANJI] =
+{
+    0x0051, 0x0052, 0x0058, 0x000E, 0x008A, 0x004B, 0x003D, 0x000C, 0x00B7, 0x003E, 0x0040, 0x01DF, 0x01E0, 0x01E1, 0x01E2, 0x01E3,
+    0x01E4, 0x01E5, 0x01E6, 0x01E7, 0x01E8, 0x01E9, 0x01EA, 0x01EB, 0x01EC, 0x01ED, 0x01EE, 0x01EF, 0x01F0, 0x01F1, 0x01F2, 0x01F3,
+    0x01F4, 0x01F5, 0x01F6, 0x01FF, 0x0200, 0x0201, 0x0202, 0x0203, 0x0204, 0x0205, 0x0206, 0x0207, 0x0208, 0x0209, 0x020A, 0x020B,
+    0x020C, 0x020D, 0x020E, 0x020F, 0x0210, 0x0211, 0x0212, 0x0213, 0x0214, 0x0215, 0x0216, 0x0246, 0x0240, 0x0241, 0x0242, 0x0243,
+    0x0244, 0x0245, 0x0247, 0x0248, 0x0249, 0x024A, 0x024B, 0x024C, 0x024D, 0x024E, 0x024F, 0x0250, 0x0251, 0x0252, 0x0253, 0x0254,
+    0x0255, 0x0256, 0x0257, 0x0258, 0x0259, 0x025A, 0x025B, 0x025C, 0x025D, 0x025E, 0x025F, 0x0260, 0x0270, 0x0271, 0x0272, 0x0273,
+    0x0274, 0x0275, 0x0277, 0x0278, 0x0279, 0x027A, 0x027B, 0x027C, 0x027D, 0x027E, 0x0280, 0x0281, 0x0282, 0x0283, 0x0284, 0x0285,
+    0x0286, 0x0287, 0x0288, 0x0289, 0x028A, 0x028B, 0x028C, 0x028D, 0x028E, 0x028F, 0x0290, 0x0291, 0x0276, 0x001D, 0x001C, 0x0021,
+    0x0025, 0x0026, 0x0027, 0x0028, 0x00B5, 0x00B6, 0x0024, 0x0023, 0x00B1, 0x004C, 0x004D, 0x0066, 0x004E, 0x00B0, 0x0069, 0x006A,
+    0x0068, 0x006B, 0x008B, 0x008C, 0x008D, 0x009D, 0x008E, 0x009E, 0x0078, 0x0079, 0x003C, 0x00A3, 0x00A5, 0x0047, 0x009A, 0x0088,
+    0x0089, 0x007F, 0x007E, 0x00A7, 0x00A8, 0x0048, 0x00A6, 0x00A4, 0x00A0, 0x0042, 0x009F, 0x0045, 0x0046, 0x00A1, 0x00A2, 0x007C,
+    0x007D, 0x007A, 0x007B, 0x009B, 0x009C, 0x029F, 0x02AA, 0x02A0, 0x02AB, 0x02A1, 0x02AC, 0x02A2, 0x02AD, 0x02A4, 0x02AF, 0x02A3,
+    0x02AE, 0x02A5, 0x02BA, 0x02B5, 0x02B0, 0x02A7, 0x02BC, 0x02B7, 0x02B2, 0x02A6, 0x02B6, 0x02BB, 0x02B1, 0x02A8, 0x02B8, 0x02BD,
+    0x02B3, 0x02A9, 0x02B9, 0x02BE, 0x02B4, 0x0061, 0x0060, 0x0063, 0x0062, 0x0065, 0x0064, 0x005F, 0x005E, 0x005B, 0x005D, 0x005C,
+    0x00BC, 0x005A, 0x0059, 0x004A, 0x0049, 0x00B4, 0x00B3, 0x00B2, 0x0000, 0x0001, 0x0002, 0x0016, 0x0018, 0x0019, 0x001A, 0x0031,
+    0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037, 0x0038, 0x0039, 0x003A, 0x0067, 0x006C, 0x002B, 0x002C, 0x0020, 0x011F, 0x0120,
+    0x0121, 0x0122, 0x0123, 0x0124, 0x0125, 0x0126, 0x0127, 0x0128, 0x0129, 0x012A, 0x012B, 0x012C, 0x012D, 0x012E, 0x012F, 0x0130,
+    0x0131, 0x0132, 0x0133, 0x0134, 0x0135, 0x0136, 0x0137, 0x0138, 0x0139, 0x013A, 0x013B, 0x013C, 0x013D, 0x013E, 0x013F, 0x0140,
+    0x0141, 0x0142, 0x0143, 0x0144, 0x0145, 0x0146, 0x0147, 0x0148, 0x0149, 0x014A, 0x014B, 0x014C, 0x014D, 0x014E, 0x014F, 0x0150,
+    0x0151, 0x0152, 0x0153, 0x0154, 0x0155, 0x0156, 0x0157, 0x0158, 0x0159, 0x015A, 0x015B, 0x015C, 0x015D, 0x015E, 0x015F, 0x0160,
+    0x0161, 0x0162, 0x0163, 0x0164, 0x0165, 0x0166, 0x0167, 0x0168, 0x0169, 0x016A, 0x016B, 0x016C, 0x016D, 0x016E, 0x016F, 0x0170,
+    0x0171, 0x000A, 0x000B, 0x0014, 0x0015, 0x0180, 0x0181, 0x0182, 0x0183, 0x0184, 0x0185, 0x0186, 0x0187, 0x0188, 0x0189, 0x018A,
+    0x018B, 0x018C, 0x018D, 0x018E, 0x018F, 0x0190, 0x0191, 0x0192, 0x0193, 0x0194, 0x0195, 0x0196, 0x0197, 0x0198, 0x0199, 0x019A,
+    0x019B, 0x019C, 0x019D, 0x019E, 0x019F, 0x01A0, 0x01A1, 0x01A2, 0x01A3, 0x01A4, 0x01A5, 0x01A6, 0x01A7, 0x01A8, 0x01A9, 0x01AA,
+    0x01AB, 0x01AC, 0x01AD, 0x01AE, 0x01AF, 0x01B0, 0x01B1, 0x01B2, 0x01B3, 0x01B4, 0x01B5, 0x01B6, 0x01B7, 0x01B8, 0x01B9, 0x01BA,
+    0x01BB, 0x01BC, 0x01BD, 0x01BE, 0x01C0, 0x01C1, 0x01C2, 0x01C3, 0x01C4, 0x01C5, 0x01C6, 0x01C7, 0x01C8, 0x01C9, 0x01CA, 0x01CB,
+    0x01CC, 0x01CD, 0x01CE, 0x01CF, 0x01D0, 0x01D1, 0x01D2, 0x01D3, 0x01D4, 0x01D5, 0x01D6, 0x0005, 0x001B, 0x0012, 0x0013, 0x05EA,
+    0x0D1A, 0x0A35, 0x101C, 0x0B24, 0x09CF, 0x0B23, 0x067A, 0x0F33, 0x109E, 0x11A0, 0x060E, 0x070E, 0x11A1, 0x0BA2, 0x1280, 0x07B5,
+    0x0F78, 0x0B25, 0x10FC, 0x0F80, 0x11A2, 0x0D06, 0x11A3, 0x0838, 0x11A4, 0x075B, 0x0CCF, 0x0A65, 0x11A5, 0x11A6, 0x11A7, 0x0E54,
+    0x07B6, 0x0E56, 0x0E21, 0x08C1, 0x0FD2, 0x1B28, 0x11A8, 0x0B26, 0x11A9, 0x0673, 0x0823, 0x08EE, 0x1067, 0x13E4, 0x10D0, 0x0E3B,
+    0x0723, 0x0794, 0x11AA, 0x11AB, 0x10F9, 0x109C, 0x0C48, 0x11AD, 0x0A16, 0x0E31, 0x11B0, 0x061D, 0x08DD, 0x08DC, 0x05E4, 0x116A,
+    0x1169, 0x0971, 0x059F, 0x11B1, 0x11B2, 0x11B3, 0x0FD3, 0x11B4, 0x08F0, 0x05E5, 0x1012, 0x07DC, 0x07DD, 0x07DE, 0x0D60, 0x10FA,
+    0x11B5, 0x11B6, 0x11B7, 0x0B6C, 0x0A99, 0x0B6D, 0x11BC, 0x11BA, 0x11BB, 0x07B7, 0x0961, 0x06AE, 0x11B9, 0x11B8, 0x0F67, 0x09E5,
+    0x09E4, 0x0C7C, 0x11BD, 0x0F34, 0x0BE5, 0x0017, 0x11BE, 0x11C0, 0x0CA3, 0x111F, 0x05C8, 0x11BF, 0x067C, 0x0802, 0x0D07, 0x088F,
+    0x11C1, 0x0E43, 0x0769, 0x11C2, 0x05C9, 0x08DE, 0x076A, 0x0F5A, 0x0EB0, 0x07B8, 0x06AF, 0x11E5, 0x0DA0, 0x0E8C, 0x11C4, 0x0EBA,
+    0x1120, 0x0B4C, 0x09E6, 0x0A17, 0x067E, 0x0D4F, 0x0CC1, 0x11C8, 0x05CA, 0x0D61, 0x0A9A, 0x0972, 0x1083, 0x0C8C, 0x067D, 0x11C7,
+    0x109D, 0x11C3, 0x11C5, 0x09AC, 0x11C6, 0x1383, 0x11CE, 0x11D1, 0x11CF, 0x0680, 0x0F79, 0x11C9, 0x11CD, 0x08F1, 0x09E7, 0x0724,
+    0x11D2, 0x11CA, 0x1121, 0x0A18, 0x11CB, 0x11D0, 0x11D3, 0x11CC, 0x07DF, 0x05CB, 0x07E0, 0x067F, 0x1384, 0x1019, 0x0F4E, 0x08F2,
+    0x0B4E, 0x10F5, 0x0F96, 0x0857, 0x0C63, 0x06A2, 0x0AB2, 0x11D7, 0x11DC, 0x11DA, 0x11D5, 0x0C6D, 0x11D8, 0x11DB, 0x11D9, 0x0F9B,
+    0x11D6, 0x0B4D, 0x1013, 0x11DD, 0x11DE, 0x0A83, 0x11EB, 0x0E6F, 0x0F15, 0x11E6, 0x0FAE, 0x0674, 0x11EA, 0x11E4, 0x11ED, 0x0C31,
+    0x08C2, 0x0E7B, 0x17C5, 0x11EC, 0x0DBC, 0x11E1, 0x08F4, 0x08F3, 0x11DF, 0x0A58, 0x11E7, 0x0FAD, 0x0CEC, 0x11E3, 0x0891, 0x11E0,
+    0x11E8, 0x11E2, 0x110F, 0x11E9, 0x1160, 0x0824, 0x0890, 0x11EE, 0x11EF, 0x11F3, 0x05CC, 0x0F8E, 0x11F2, 0x11F1, 0x11F5, 0x11F4,
+    0x0D62, 0x0892, 0x11F6, 0x0A43, 0x0C64, 0x0D63, 0x0834, 0x11F7, 0x0795, 0x11F8, 0x11FA, 0x0FD4, 0x0886, 0x09D0, 0x0EF5, 0x11F9,
+    0x0983, 0x10A2, 0x11FC, 0x1202, 0x11FB, 0x0982, 0x0ADD, 0x0858, 0x1203, 0x080D, 0x1200, 0x1201, 0x0DED, 0x0C5C, 0x07E1, 0x0FEC,
+    0x1204, 0x10FB, 0x1205, 0x1208, 0x1206, 0x0C2D, 0x1207, 0x1209, 0x120B, 0x120A, 0x0F86, 0x0796, 0x120D, 0x120E, 0x066D, 0x120C,
+    0x0A72, 0x1211, 0x1210, 0x120F, 0x11D4, 0x1212, 0x0ADE, 0x1213, 0x1084, 0x1057, 0x1215, 0x1214, 0x1217, 0x1216, 0x1218, 0x1219,
+    0x05F2, 0x08B3, 0x085A, 0x0A9B, 0x0D1B, 0x07E2, 0x0BE6, 0x08F5, 0x094E, 0x121B, 0x1046, 0x0DA5, 0x0A19, 0x121A, 0x121C, 0x0DBD,
+    0x0715, 0x121D, 0x0E3C, 0x0C13, 0x121F, 0x1220, 0x0EAA, 0x08F6, 0x115A, 0x1221, 0x07E4, 0x0F7A, 0x0C74, 0x082F, 0x0D94, 0x0893,
+    0x1222, 0x1223, 0x0E20, 0x063E, 0x1226, 0x09BB, 0x1225, 0x0984, 0x1227, 0x1A2C, 0x1228, 0x0FE0, 0x1229, 0x122A, 0x122B, 0x0B27,
+    0x0A4A, 0x0725, 0x122E, 0x122C, 0x103B, 0x122D, 0x0F39, 0x122F, 0x1230, 0x1231, 0x0DBE, 0x1235, 0x1233, 0x1234, 0x1232, 0x09A1,
+    0x1236, 0x1068, 0x1122, 0x1237, 0x0BA6, 0x1238, 0x0AB9, 0x1239, 0x0D1C, 0x10FD, 0x0DC0, 0x1283, 0x123A, 0x1F23, 0x0803, 0x123B,
+    0x0FFD, 0x0AC8, 0x0CBA, 0x123D, 0x0E22, 0x123E, 0x1240, 0x06CD, 0x1241, 0x07E5, 0x0E0A, 0x065A, 0x0AAF, 0x0E9F, 0x1242, 0x0DC1,
+    0x0B6E, 0x1243, 0x0F6A, 0x0BD8, 0x0720, 0x0727, 0x1244, 0x1246, 0x0859, 0x1245, 0x1131, 0x0AC9, 0x0EBB, 0x0F8A, 0x1247, 0x10D8,
+    0x1248, 0x1249, 0x0DDE, 0x124A, 0x0BA7, 0x09BC, 0x0894, 0x124B, 0x09E8, 0x094F, 0x0D64, 0x124D, 0x0C65, 0x09AD, 0x124E, 0x124F,
+    0x0C0F, 0x124C, 0x1251, 0x0FD5, 0x0944, 0x1250, 0x0895, 0x099C, 0x0E8D, 0x1254, 0x1252, 0x0F5B, 0x0B28, 0x125B, 0x0704, 0x1255,
+    0x1253, 0x0C2E, 0x1257, 0x1256, 0x06E3, 0x0880, 0x125C, 0x10EB, 0x1258, 0x125D, 0x125A, 0x1259, 0x110D, 0x08F7, 0x0681, 0x1132,
+    0x0AD5, 0x0DB7, 0x0945, 0x1260, 0x1261, 0x1123, 0x114A, 0x1263, 0x08F8, 0x1262, 0x06CE, 0x1264, 0x0FF5, 0x0D3A, 0x1085, 0x0F97,
+    0x1265, 0x1DD3, 0x0DEE, 0x1266, 0x0728, 0x1031, 0x0ADF, 0x1267, 0x0FA5, 0x126B, 0x0BA8, 0x1268, 0x080E, 0x1269, 0x0729, 0x084D,
+    0x126C, 0x126D, 0x126E, 0x126F, 0x0A59, 0x08F9, 0x105C, 0x1066, 0x0E35, 0x0FAF, 0x1270, 0x1271, 0x1273, 0x1275, 0x1274, 0x1276,
+    0x067B, 0x0FEB, 0x09BA, 0x1277, 0x0C38, 0x0AE0, 0x07E7, 0x1278, 0x0ED9, 0x1279, 0x127A, 0x127B, 0x127C, 0x0F03, 0x0826, 0x05E3,
+    0x0DFD, 0x127D, 0x0A9C, 0x0BE7, 0x127F, 0x127E, 0x0AE1, 0x08DF, 0x1281, 0x0EBC, 0x1282, 0x0EDA, 0x0C72, 0x0CAC, 0x07E6, 0x0E2C,
+    0x0CD0, 0x0E8E, 0x0FED, 0x1284, 0x0BE8, 0x0854, 0x1285, 0x1286, 0x060B, 0x05F3, 0x076B, 0x0C66, 0x07B0, 0x10D1, 0x1289, 0x0675,
+    0x1288, 0x07E8, 0x128A, 0x106F, 0x128B, 0x1110, 0x08FA, 0x08B4, 0x128C, 0x128E, 0x128D, 0x0B7E, 0x0618, 0x063D, 0x128F, 0x1290,
+    0x08B5, 0x1291, 0x07CE, 0x09D1, 0x1292, 0x1014, 0x0973, 0x07B9, 0x1086, 0x0C2F, 0x0EBD, 0x0A7B, 0x0AA6, 0x0A66, 0x0A73, 0x0AD6,
+    0x0EBE, 0x1295, 0x0622, 0x0C30, 0x08FB, 0x08C3, 0x0825, 0x1299, 0x0CC0, 0x0CBC, 0x07E9, 0x0AE2, 0x129A, 0x1298, 0x0682, 0x0CA4,
+    0x0A36, 0x09EA, 0x0605, 0x0710, 0x0946, 0x09E9, 0x129B, 0x129C, 0x07A8, 0x06E5, 0x0947, 0x07A7, 0x0D5D, 0x0604, 0x0DEF, 0x103C,
+    0x0900, 0x10D9, 0x0DA6, 0x08FC, 0x084E, 0x12A5, 0x0821, 0x0FE9, 0x0EDB, 0x12A4, 0x075C, 0x129F, 0x12A0, 0x12A2, 0x12A3, 0x07BA,
+    0x0B81, 0x0F6B, 0x12A1, 0x129D, 0x08E1, 0x129E, 0x1143, 0x0FB0, 0x0D66, 0x08E0, 0x0950, 0x12A6, 0x0E1B, 0x12AA, 0x0A7C, 0x0A74,
+    0x12AD, 0x12AB, 0x1021, 0x12A8, 0x12B1, 0x12AC, 0x12AF, 0x08C4, 0x103D, 0x12B0, 0x12B2, 0x12B4, 0x09AE, 0x1161, 0x12A9, 0x12A7,
+    0x12B3, 0x12AE, 0x12B6, 0x12C2, 0x12B8, 0x12BC, 0x12C0, 0x12B9, 0x12DD, 0x09A7, 0x06D0, 0x12B7, 0x12C4, 0x05F4, 0x12C3, 0x05A3,
+    0x0F29, 0x12C1, 0x12BA, 0x12B5, 0x12BB, 0x0986, 0x12C5, 0x05F5, 0x12CE, 0x12C6, 0x12C7, 0x0AE3, 0x1009, 0x12CC, 0x12CB, 0x0D8E,
+    0x12CD, 0x12CA, 0x0613, 0x0974, 0x0B4F, 0x12C8, 0x0DC2, 0x12C9, 0x05A0, 0x12D3, 0x1082, 0x0AE5, 0x12D9, 0x12D8, 0x12CF, 0x0C81,
+    0x12D0, 0x0CAD, 0x12D5, 0x0AE4, 0x12D2, 0x1062, 0x085B, 0x12D6, 0x12D7, 0x12D4, 0x12DA, 0x12D1, 0x12E0, 0x12E5, 0x12E1, 0x12DC,
+    0x12E6, 0x0C10, 0x12E8, 0x0901, 0x12DE, 0x0D1D, 0x12E2, 0x12DB, 0x072B, 0x076C, 0x0705, 0x12E3, 0x12DF, 0x0896, 0x12E9, 0x12E7,
+    0x0C32, 0x07A9, 0x07EA, 0x12E4, 0x0832, 0x0623, 0x12ED, 0x12EB, 0x1325, 0x12F0, 0x12EA, 0x12EE, 0x12EC, 0x09EB, 0x12EF, 0x12F2,
+    0x12F7, 0x12F5, 0x12F4, 0x0CD1, 0x0683, 0x12F1, 0x12F3, 0x0AE6, 0x0612, 0x12F6, 0x069C, 0x1302, 0x0B3A, 0x12FD, 0x12FB, 0x12FC,
+    0x12FE, 0x061C, 0x0C18, 0x12F8, 0x12F9, 0x071A, 0x1301, 0x076D, 0x1304, 0x1300, 0x1303, 0x0F6C, 0x0E13, 0x0EB6, 0x1306, 0x1305,
+    0x06E4, 0x1307, 0x130A, 0x1309, 0x1308, 0x0E58, 0x130B, 0x130C, 0x130E, 0x130D, 0x1310, 0x1313, 0x1311, 0x130F, 0x1312, 0x1314,
+    0x1315, 0x1316, 0x1317, 0x1318, 0x1224, 0x0A7A, 0x09EC, 0x06B1, 0x05F6, 0x0CE3, 0x1319, 0x0962, 0x05CD, 0x0B7D, 0x131A, 0x08C5,
+    0x0951, 0x131C, 0x131B, 0x0F9E, 0x131D, 0x131F, 0x131E, 0x1320, 0x1321, 0x0897, 0x0640, 0x1322, 0x1324, 0x1323, 0x1326, 0x0DB9,
+    0x1327, 0x05B3, 0x099D, 0x085C, 0x0CEE, 0x1328, 0x1329, 0x132B, 0x132C, 0x09A2, 0x080F, 0x0FD6, 0x132A, 0x132D, 0x097F, 0x0902,
+    0x1331, 0x0963, 0x0CD2, 0x132E, 0x0D58, 0x1332, 0x0B82, 0x1330, 0x1333, 0x085E, 0x1334, 0x1335, 0x0903, 0x06DF, 0x1337, 0x1338,
+    0x1339, 0x1336, 0x132F, 0x133A, 0x133B, 0x1004, 0x0B29, 0x133D, 0x133E, 0x133C, 0x1340, 0x0E57, 0x05E6, 0x0F35, 0x1341, 0x0B3B,
+    0x0A37, 0x0E7C, 0x076E, 0x09A9, 0x0FF8, 0x0DF0, 0x0898, 0x0C8D, 0x133F, 0x1342, 0x0C82, 0x1343, 0x1344, 0x1346, 0x0D67, 0x072C,
+    0x1F1F, 0x0641, 0x0FB1, 0x0B2A, 0x0DA7, 0x09A4, 0x134C, 0x0F7B, 0x111B, 0x06B2, 0x1348, 0x0C19, 0x134B, 0x0DC3, 0x0DA8, 0x0DC4,
+    0x0EB7, 0x0D4B, 0x0987, 0x1347, 0x0656, 0x0D95, 0x1349, 0x1345, 0x0B6F, 0x134D, 0x0AAD, 0x07EB, 0x134E, 0x0FA6, 0x0C5D, 0x0D44,
+    0x1350, 0x0FEE, 0x1351, 0x1356, 0x0F6D, 0x1355, 0x134F, 0x1352, 0x1354, 0x0964, 0x0F87, 0x1357, 0x0CE4, 0x06B3, 0x0B2B, 0x1359,
+    0x1358, 0x0948, 0x135A, 0x135C, 0x135B, 0x135E, 0x1353, 0x1360, 0x135F, 0x135D, 0x09ED, 0x0B70, 0x0C33, 0x1361, 0x0BBA, 0x05EB,
+    0x0E84, 0x0D59, 0x1363, 0x1362, 0x1364, 0x1365, 0x1366, 0x1367, 0x0F8F, 0x1368, 0x0684, 0x1369, 0x109B, 0x06CF, 0x1287, 0x0AA7,
+    0x0C7D, 0x136A, 0x1069, 0x1032, 0x136C, 0x0CA5, 0x0D96, 0x0C7E, 0x0F36, 0x136D, 0x136E, 0x065B, 0x0A38, 0x136F, 0x05CE, 0x1370,
+    0x1371, 0x0642, 0x076F, 0x0E1E, 0x0FB2, 0x1375, 0x0C34, 0x1374, 0x085F, 0x0FFA, 0x1373, 0x0DC5, 0x1377, 0x1376, 0x1379, 0x1378,
+    0x065C, 0x137A, 0x0AE7, 0x137C, 0x0CC4, 0x137B, 0x0F71, 0x0AD7, 0x0DBA, 0x1380, 0x0904, 0x1381, 0x0E40, 0x0EDC, 0x104F, 0x0E44,
+    0x138A, 0x0797, 0x10A4, 0x102D, 0x13EA, 0x1382, 0x1385, 0x0C83, 0x0FD7, 0x0DA9, 0x1386, 0x1005, 0x0988, 0x0AE8, 0x1387, 0x09EF,
+    0x09EE, 0x05B7, 0x08C6, 0x0BA9, 0x05CF, 0x138B, 0x138C, 0x1389, 0x0617, 0x072D, 0x1388, 0x1043, 0x0F10, 0x05A6, 0x05F7, 0x09F0,
+    0x05D0, 0x05A1, 0x1391, 0x138F, 0x103A, 0x1392, 0x1390, 0x138E, 0x0B50, 0x138D, 0x0F98, 0x08E2, 0x1396, 0x1397, 0x0AE9, 0x1393,
+    0x114B, 0x0E6B, 0x1395, 0x0965, 0x1398, 0x0F37, 0x1399, 0x1394, 0x1039, 0x0E7D, 0x139A, 0x0F11, 0x139B, 0x139F, 0x139C, 0x0685,
+    0x139E, 0x0A39, 0x139D, 0x0899, 0x13AB, 0x13A4, 0x13A1, 0x0D04, 0x13A0, 0x13A2, 0x13A3, 0x13A5, 0x13A6, 0x0770, 0x13A8, 0x13A7,
+    0x13A9, 0x0B2C, 0x13AC, 0x0D5A, 0x0624, 0x13AA, 0x13AD, 0x13AE, 0x13B1, 0x13AF, 0x13B0, 0x09F1, 0x13B2, 0x0905, 0x13B3, 0x0A1A,
+    0x0C76, 0x13B4, 0x13B5, 0x09F9, 0x0906, 0x1050, 0x0787, 0x08C7, 0x13B6, 0x06F7, 0x13B7, 0x0C77, 0x13B8, 0x13E1, 0x13B9, 0x13BA,
+    0x13BB, 0x13BD, 0x13BE, 0x13C0, 0x0CAE, 0x0606, 0x0A67, 0x05C0, 0x0C36, 0x072E, 0x0A33, 0x0907, 0x0DC6, 0x0A80, 0x072F, 0x0D08,
+    0x0D68, 0x05B6, 0x0798, 0x0FB3, 0x0A40, 0x07B1, 0x0BE9, 0x0A3A, 0x1087, 0x13C1, 0x07BB, 0x0989, 0x06D1, 0x0643, 0x0AEA, 0x0686,
+    0x13C2, 0x10A5, 0x0AA8, 0x0A62, 0x13C3, 0x0771, 0x0E10, 0x1027, 0x13C4, 0x13C5, 0x0F38, 0x13C7, 0x0726, 0x0835, 0x13C6, 0x0730,
+    0x0B51, 0x13CB, 0x09C0, 0x0687, 0x13CA, 0x13C8, 0x13CC, 0x13C9, 0x0E4A, 0x164B, 0x0B52, 0x13CD, 0x10FE, 0x13CE, 0x13D0, 0x0D1E,
+    0x13CF, 0x0BA1, 0x0A1B, 0x0C8E, 0x0A75, 0x0F55, 0x0BEA, 0x0A4B, 0x13D1, 0x0AEB, 0x13D2, 0x13D3, 0x05D1, 0x0C78, 0x0B71, 0x13D4,
+    0x0DF1, 0x0AEC, 0x0AED, 0x13D5, 0x0BEB, 0x0AEE, 0x13D6, 0x13D7, 0x105E, 0x13D8, 0x0804, 0x0A81, 0x13D9, 0x13DA, 0x0A5A, 0x0B4B,
+    0x0E32, 0x0B73, 0x0EF6, 0x0E41, 0x0807, 0x13DB, 0x07CF, 0x13DC, 0x083C, 0x0E0D, 0x066E, 0x09F2, 0x13DD, 0x13E0, 0x13DF, 0x083B,
+    0x13DE, 0x0D97, 0x0C6E, 0x0DAA, 0x0A46, 0x0C37, 0x10DA, 0x13E2, 0x13E3, 0x0E14, 0x09D2, 0x13E5, 0x13E6, 0x13E7, 0x0772, 0x13E8,
+    0x13E9, 0x066A, 0x0C1A, 0x0762, 0x13EB, 0x1026, 0x0C90, 0x06F8, 0x13ED, 0x13EF, 0x075D, 0x13EC, 0x13EE, 0x13F1, 0x13F0, 0x13F2,
+    0x13F3, 0x0DFB, 0x07EC, 0x06A3, 0x13F4, 0x13F9, 0x13F7, 0x0FB5, 0x0FB4, 0x0DC7, 0x13F6, 0x0AB3, 0x13F5, 0x0B92, 0x13FA, 0x09A8,
+    0x1400, 0x1401, 0x13FB, 0x06D2, 0x13FC, 0x1405, 0x1404, 0x1403, 0x13FF, 0x13FE, 0x1402, 0x0FB6, 0x1409, 0x1406, 0x1408, 0x10D2,
+    0x1407, 0x13FD, 0x0B93, 0x140A, 0x0975, 0x140B, 0x140C, 0x140F, 0x140E, 0x140D, 0x0DC8, 0x13F8, 0x1415, 0x1411, 0x1410, 0x1412,
+    0x1413, 0x1416, 0x1124, 0x1417, 0x1414, 0x1418, 0x075E, 0x1419, 0x141B, 0x141A, 0x141C, 0x141D, 0x0BEC, 0x0A82, 0x0AC4, 0x0C43,
+    0x0908, 0x0976, 0x0909, 0x07D0, 0x141E, 0x0977, 0x08C8, 0x141F, 0x1024, 0x0E62, 0x1420, 0x090A, 0x072A, 0x0CC6, 0x0810, 0x09F3,
+    0x0F3A, 0x0EBF, 0x1421, 0x0773, 0x1424, 0x0D1F, 0x1423, 0x1422, 0x1425, 0x0D69, 0x0B83, 0x09F4, 0x0BC8, 0x0C91, 0x0781, 0x0D20,
+    0x1426, 0x1427, 0x0B2D, 0x0FD8, 0x142A, 0x1429, 0x1428, 0x0F5D, 0x1431, 0x0FF9, 0x142B, 0x142D, 0x100B, 0x142C, 0x142E, 0x0EA6,
+    0x142F, 0x0F7C, 0x1430, 0x0731, 0x0F7D, 0x0E4E, 0x1432, 0x1433, 0x090B, 0x0732, 0x1434, 0x08B6, 0x10A3, 0x1088, 0x0774, 0x1436,
+    0x0D21, 0x090C, 0x0AEF, 0x0EDD, 0x0AF0, 0x0AD8, 0x0D6A, 0x0FB7, 0x0D98, 0x090D, 0x0F3B, 0x1437, 0x0DB8, 0x0980, 0x08C9, 0x0D6B,
+    0x05C1, 0x0ACE, 0x090E, 0x10A6, 0x1438, 0x1439, 0x0E70, 0x143A, 0x1135, 0x114C, 0x143C, 0x143B, 0x06E6, 0x1440, 0x1443, 0x1444,
+    0x1442, 0x0F1F, 0x0AF1, 0x1446, 0x1445, 0x1441, 0x1447, 0x1448, 0x1449, 0x144C, 0x144A, 0x144B, 0x144D, 0x0644, 0x0D6C, 0x144E,
+    0x089A, 0x06B4, 0x0E55, 0x144F, 0x0E39, 0x0F99, 0x1450, 0x114D, 0x1451, 0x0F7E, 0x1454, 0x119F, 0x11AF, 0x0A2E, 0x0E33, 0x1455,
+    0x07BC, 0x0D22, 0x05F8, 0x1456, 0x0F64, 0x090F, 0x0CEF, 0x0D6D, 0x106D, 0x08B7, 0x08CA, 0x1457, 0x1458, 0x145E, 0x0A63, 0x0D23,
+    0x07ED, 0x1459, 0x0F0A, 0x0CE5, 0x145A, 0x145B, 0x07EE, 0x145C, 0x145D, 0x145F, 0x0DD6, 0x1460, 0x1461, 0x1462, 0x1453, 0x1452,
+    0x1463, 0x0860, 0x0F06, 0x098A, 0x0F16, 0x0D24, 0x0F2A, 0x1464, 0x0AF2, 0x0625, 0x1465, 0x1466, 0x1070, 0x0EDE, 0x1469, 0x065D,
+    0x0BAA, 0x1468, 0x1467, 0x0861, 0x0C92, 0x146D, 0x146B, 0x146A, 0x10E5, 0x08E3, 0x0AD9, 0x146C, 0x0DAB, 0x0A9D, 0x0DFE, 0x1470,
+    0x146F, 0x146E, 0x1471, 0x08E4, 0x1472, 0x0F5C, 0x0ABA, 0x1473, 0x0EF7, 0x0DFF, 0x0D25, 0x0D8F, 0x1474, 0x078A, 0x0B53, 0x0F0B,
+    0x0775, 0x0E45, 0x1475, 0x09F5, 0x0FD9, 0x0FDA, 0x065E, 0x147A, 0x0D09, 0x1477, 0x06B5, 0x14AB, 0x1479, 0x0E4F, 0x1478, 0x1476,
+    0x095A, 0x147C, 0x1483, 0x1489, 0x1481, 0x0DBB, 0x1486, 0x0F3C, 0x1480, 0x1485, 0x1125, 0x09F6, 0x0C93, 0x147D, 0x07BD, 0x1488,
+    0x0BAB, 0x0645, 0x1482, 0x06B6, 0x1487, 0x07EF, 0x1484, 0x148A, 0x148C, 0x1496, 0x1494, 0x1491, 0x1490, 0x1136, 0x1492, 0x07F0,
+    0x0910, 0x0ADA, 0x1499, 0x148B, 0x148F, 0x147E, 0x06B8, 0x1493, 0x1495, 0x0CF0, 0x0966, 0x0676, 0x148D, 0x1498, 0x1497, 0x07F1,
+    0x0C67, 0x0706, 0x0862, 0x148E, 0x149A, 0x149D, 0x149F, 0x0A3B, 0x14A5, 0x0D6E, 0x149B, 0x14A3, 0x06B7, 0x14A1, 0x14A2, 0x149E,
+    0x14A0, 0x08E5, 0x1089, 0x0733, 0x0638, 0x14A4, 0x0E59, 0x05AB, 0x0EDF, 0x147B, 0x14AA, 0x14AE, 0x1063, 0x14A7, 0x0DC9, 0x14AC,
+    0x0B2E, 0x14AD, 0x0E15, 0x1166, 0x14A9, 0x14AF, 0x095B, 0x0BC9, 0x05D2, 0x14A8, 0x14A6, 0x0C39, 0x149C, 0x09D3, 0x0C84, 0x14BB,
+    0x0C3A, 0x14B6, 0x14B3, 0x14B4, 0x0A64, 0x14B7, 0x14BA, 0x14B5, 0x0A84, 0x14B8, 0x14B2, 0x107A, 0x1079, 0x14BC, 0x14BD, 0x05D3,
+    0x14B1, 0x0830, 0x05A4, 0x0734, 0x14B9, 0x14C1, 0x14C0, 0x14C5, 0x14C6, 0x14C4, 0x14C7, 0x14BF, 0x14C3, 0x14C8, 0x14C9, 0x14BE,
+    0x0A1C, 0x14C2, 0x0C94, 0x0911, 0x14B0, 0x0B54, 0x14D6, 0x0FA7, 0x14CC, 0x14CD, 0x14CE, 0x14D5, 0x14D4, 0x101D, 0x0735, 0x14D2,
+    0x0864, 0x06D3, 0x14CF, 0x10F6, 0x14D1, 0x05D4, 0x14D3, 0x14CA, 0x14D0, 0x14D7, 0x0863, 0x14CB, 0x10BC, 0x108A, 0x14DA, 0x14DE,
+    0x0C5E, 0x1137, 0x14DF, 0x14DC, 0x14D9, 0x14D8, 0x14DD, 0x0F6E, 0x0DF2, 0x0865, 0x14E0, 0x14DB, 0x14E1, 0x089B, 0x066F, 0x14E9,
+    0x0736, 0x14E7, 0x14E8, 0x0967, 0x14E6, 0x14E4, 0x14E3, 0x14EA, 0x14E2, 0x14EC, 0x06B9, 0x14EE, 0x14ED, 0x0D26, 0x14F1, 0x14EF,
+    0x14E5, 0x089C, 0x14F0, 0x14F4, 0x14F3, 0x14F5, 0x14F2, 0x14F6, 0x14F7, 0x14F8, 0x0FA8, 0x14FA, 0x14F9, 0x0A9E, 0x0BAC, 0x06A4,
+    0x06BA, 0x14FB, 0x05BD, 0x0BCA, 0x14FC, 0x1C41, 0x1500, 0x0881, 0x1501, 0x0BED, 0x1502, 0x1503, 0x0799, 0x1504, 0x1505, 0x1506,
+    0x0C95, 0x08CB, 0x105F, 0x0FDB, 0x0ACA, 0x1507, 0x0BEE, 0x1CFB, 0x0EE0, 0x0A68, 0x098B, 0x1508, 0x0C85, 0x0F65, 0x0CAF, 0x150B,
+    0x1509, 0x150C, 0x150A, 0x150D, 0x0F6F, 0x05B5, 0x0F3D, 0x0EE1, 0x150E, 0x1511, 0x0AF3, 0x079A, 0x150F, 0x1516, 0x0AF4, 0x1510,
+    0x0E63, 0x10BD, 0x1512, 0x1513, 0x1517, 0x0DCA, 0x1514, 0x0912, 0x0BDC, 0x1525, 0x0EB2, 0x0CB0, 0x0EE2, 0x156B, 0x0FB8, 0x0D6F,
+    0x1015, 0x151A, 0x065F, 0x0D0A, 0x1523, 0x0CD3, 0x151D, 0x1524, 0x151F, 0x1526, 0x1522, 0x1521, 0x0E8F, 0x151B, 0x06BB, 0x1519,
+    0x07D1, 0x0CB1, 0x1515, 0x1518, 0x0913, 0x0BD9, 0x0AF5, 0x1520, 0x0E71, 0x07D2, 0x06E7, 0x0707, 0x0B40, 0x1528, 0x152D, 0x1529,
+    0x089D, 0x152E, 0x09C1, 0x0949, 0x0A85, 0x151C, 0x0A1D, 0x152B, 0x09F7, 0x152C, 0x05C2, 0x1527, 0x0D27, 0x07D3, 0x07F2, 0x152A,
+    0x05A5, 0x0981, 0x0B55, 0x0D70, 0x0ED2, 0x1530, 0x0C3D, 0x0C68, 0x09CA, 0x1531, 0x1533, 0x152F, 0x0F9F, 0x0D3B, 0x0C3B, 0x0FB9,
+    0x0A4C, 0x1540, 0x153E, 0x0B98, 0x089E, 0x1538, 0x0AF7, 0x0E26, 0x0E50, 0x1536, 0x0C3C, 0x0A76, 0x153B, 0x0AF6, 0x1535, 0x153A,
+    0x0E72, 0x1534, 0x0840, 0x06FC, 0x153C, 0x10E9, 0x098C, 0x0CD4, 0x1539, 0x0BDA, 0x0914, 0x0B84, 0x0646, 0x0C1B, 0x1537, 0x07A4,
+    0x0866, 0x0D4D, 0x153D, 0x0C3E, 0x1541, 0x1543, 0x0C75, 0x1549, 0x1544, 0x1546, 0x0F20, 0x0D71, 0x1547, 0x108B, 0x10A7, 0x0737,
+    0x05AC, 0x1545, 0x1542, 0x0776, 0x0647, 0x1548, 0x10A8, 0x154C, 0x0C79, 0x1553, 0x154D, 0x154A, 0x1551, 0x1532, 0x154E, 0x1552,
+    0x0EC0, 0x0DCB, 0x154B, 0x154F, 0x0867, 0x09AF, 0x0BDB, 0x1557, 0x0D85, 0x1554, 0x1000, 0x1555, 0x1556, 0x104C, 0x0BA0, 0x0882,
+    0x155D, 0x09D4, 0x155A, 0x1559, 0x0E51, 0x0DF3, 0x0D90, 0x155B, 0x155C, 0x0F4F, 0x0E64, 0x09C2, 0x0BEF, 0x0FEF, 0x06E8, 0x1563,
+    0x155E, 0x10A9, 0x1565, 0x1561, 0x1562, 0x0C40, 0x1560, 0x151E, 0x1564, 0x155F, 0x1569, 0x156A, 0x0D86, 0x156C, 0x09C3, 0x1567,
+    0x079B, 0x156D, 0x1566, 0x1571, 0x1570, 0x156F, 0x1572, 0x1574, 0x0B2F, 0x1573, 0x1577, 0x1575, 0x1576, 0x1550, 0x1579, 0x1578,
+    0x1558, 0x157A, 0x156E, 0x09F8, 0x157B, 0x157C, 0x157E, 0x157D, 0x157F, 0x06BC, 0x0915, 0x0FBA, 0x0BAD, 0x08CC, 0x1581, 0x1584,
+    0x0F31, 0x07BE, 0x1583, 0x1582, 0x0E73, 0x1585, 0x07F3, 0x1587, 0x1586, 0x0738, 0x09D5, 0x0E16, 0x0868, 0x0B94, 0x1588, 0x0BAE,
+    0x0D87, 0x0F3E, 0x1589, 0x158A, 0x158B, 0x0F76, 0x13BC, 0x0BC4, 0x0F2B, 0x0996, 0x0EE3, 0x0EC1, 0x0DAC, 0x10FF, 0x158D, 0x0A4E,
+    0x158E, 0x05B4, 0x0812, 0x0BCB, 0x0F40, 0x158F, 0x09E1, 0x0CE6, 0x09FA, 0x0B56, 0x1590, 0x0FBB, 0x0657, 0x09FB, 0x1593, 0x1591,
+    0x1594, 0x10F7, 0x1592, 0x0BF9, 0x1595, 0x0C70, 0x1596, 0x0778, 0x1598, 0x1597, 0x1599, 0x159A, 0x0779, 0x0E3A, 0x0CD5, 0x07CC,
+    0x09FC, 0x0C41, 0x0ABB, 0x05AE, 0x159B, 0x0660, 0x159F, 0x0916, 0x159E, 0x0969, 0x0AF8, 0x159D, 0x0AF9, 0x103E, 0x0968, 0x05D5,
+    0x0BCC, 0x15A4, 0x0BAF, 0x0626, 0x0AB4, 0x1006, 0x09B0, 0x0AFA, 0x0BA5, 0x15A3, 0x15A1, 0x15A2, 0x0D0B, 0x15C5, 0x15A8, 0x0A1E,
+    0x0917, 0x15A6, 0x15A7, 0x0B57, 0x15A5, 0x09CE, 0x15AA, 0x15A9, 0x15AE, 0x15AF, 0x15AB, 0x06C1, 0x15AC, 0x15AD, 0x0ED3, 0x0F41,
+    0x0869, 0x15B0, 0x0BB0, 0x0AFB, 0x0CF1, 0x0805, 0x15B1, 0x15B5, 0x0689, 0x15B2, 0x15B4, 0x15B3, 0x0ACB, 0x0CE7, 0x05C3, 0x15B6,
+    0x15B7, 0x0D28, 0x112F, 0x09E2, 0x0FA9, 0x0FDC, 0x15C1, 0x15B9, 0x15BC, 0x15BB, 0x15B8, 0x15C0, 0x0E1C, 0x15BA, 0x15C2, 0x0ACC,
+    0x15C3, 0x10AA, 0x0E98, 0x15C4, 0x15C6, 0x15C7, 0x15C8, 0x0808, 0x0627, 0x0918, 0x15C9, 0x15CA, 0x0AD1, 0x0C42, 0x1296, 0x0C1D,
+    0x0C1C, 0x0C96, 0x0985, 0x11F0, 0x088E, 0x108C, 0x0FBC, 0x0F5E, 0x15CB, 0x09B1, 0x0D3D, 0x15CC, 0x114E, 0x0FDD, 0x0D29, 0x15CD,
+    0x077A, 0x15CE, 0x15CF, 0x1058, 0x1022, 0x1016, 0x0FFB, 0x09C4, 0x15D1, 0x0A69, 0x0FF0, 0x15D3, 0x15D6, 0x15D5, 0x0777, 0x07C0,
+    0x15D2, 0x15D4, 0x15D7, 0x0B99, 0x10DB, 0x05C7, 0x099E, 0x0C7A, 0x0A5B, 0x0B31, 0x15DA, 0x0DAD, 0x15D8, 0x0C69, 0x15D9, 0x0B30,
+    0x105B, 0x15DB, 0x15DC, 0x10C8, 0x15E1, 0x0919, 0x0E74, 0x15DE, 0x0DCC, 0x159C, 0x15A0, 0x07AE, 0x0E66, 0x15E0, 0x0AFC, 0x0EC2,
+    0x15E6, 0x0EF8, 0x15DD, 0x15E3, 0x15E2, 0x0BCD, 0x100D, 0x1111, 0x1007, 0x068A, 0x09FD, 0x1167, 0x15E5, 0x0B95, 0x15E4, 0x15DF,
+    0x08CD, 0x15EB, 0x15E9, 0x068B, 0x15E7, 0x15ED, 0x15F3, 0x0C86, 0x0F7F, 0x15F5, 0x0F01, 0x15F4, 0x0E90, 0x0FDE, 0x0739, 0x0BF5,
+    0x0A9F, 0x0D51, 0x108D, 0x15F0, 0x15EF, 0x15F1, 0x15EE, 0x15F6, 0x15EC, 0x15EA, 0x15F2, 0x15E8, 0x0D0C, 0x1076, 0x0A44, 0x09B2,
+    0x0978, 0x100F, 0x06E0, 0x0D4C, 0x0E08, 0x0628, 0x0BF0, 0x0BB2, 0x0849, 0x15F8, 0x091A, 0x071C, 0x15FA, 0x0714, 0x1601, 0x15FD,
+    0x0BF1, 0x06EA, 0x096A, 0x06E9, 0x098D, 0x15FB, 0x0885, 0x086A, 0x0DCD, 0x15F9, 0x05C4, 0x15FC, 0x15FE, 0x080B, 0x084B, 0x073A,
+    0x07AA, 0x1602, 0x09B7, 0x1011, 0x09D6, 0x1603, 0x0F0F, 0x160F, 0x0671, 0x1604, 0x1615, 0x1605, 0x1100, 0x160C, 0x0E7E, 0x1614,
+    0x1607, 0x05B2, 0x1609, 0x091B, 0x160B, 0x160A, 0x1606, 0x1611, 0x0AFD, 0x136B, 0x08E6, 0x10DC, 0x1608, 0x0D72, 0x06C2, 0x096B,
+    0x1600, 0x1610, 0x0701, 0x160E, 0x1612, 0x0DCE, 0x077C, 0x1630, 0x1047, 0x1617, 0x077B, 0x161E, 0x0FDF, 0x161F, 0x1621, 0x1625,
+    0x1619, 0x0CC9, 0x0DCF, 0x1629, 0x161C, 0x1626, 0x1620, 0x0B58, 0x162A, 0x0BB1, 0x1628, 0x073B, 0x116F, 0x1616, 0x1624, 0x05D6,
+    0x1618, 0x1038, 0x161D, 0x0B41, 0x0D45, 0x1613, 0x1623, 0x0B9A, 0x162D, 0x0711, 0x089F, 0x162F, 0x161A, 0x162E, 0x1627, 0x161B,
+    0x162B, 0x162C, 0x163D, 0x0E0C, 0x1622, 0x1639, 0x163B, 0x0D56, 0x10AB, 0x0F56, 0x1636, 0x0C88, 0x163C, 0x0C1E, 0x1633, 0x1640,
+    0x163F, 0x0E2D, 0x163E, 0x0E28, 0x1642, 0x1635, 0x0806, 0x1638, 0x0ABC, 0x0E80, 0x163A, 0x0809, 0x1632, 0x1634, 0x1631, 0x114F,
+    0x06F9, 0x1637, 0x1641, 0x06D4, 0x09A5, 0x063C, 0x1652, 0x1150, 0x1655, 0x0B59, 0x1654, 0x1653, 0x1650, 0x1644, 0x1661, 0x1643,
+    0x1656, 0x164E, 0x1649, 0x1646, 0x1647, 0x164F, 0x1F20, 0x164C, 0x091C, 0x0D46, 0x0C44, 0x164A, 0x1645, 0x1648, 0x10AC, 0x100A,
+    0x164D, 0x1657, 0x165F, 0x1658, 0x1665, 0x1663, 0x165E, 0x165D, 0x0D4E, 0x0C45, 0x165B, 0x1659, 0x1660, 0x1666, 0x0EF3, 0x166C,
+    0x1667, 0x166A, 0x1664, 0x0D14, 0x0F17, 0x165A, 0x1662, 0x0AFE, 0x104D, 0x1676, 0x1669, 0x08A0, 0x0661, 0x06FE, 0x1651, 0x0AFF,
+    0x166E, 0x1675, 0x0A77, 0x0712, 0x0CCD, 0x166B, 0x1670, 0x1674, 0x07F4, 0x07AB, 0x1672, 0x0780, 0x0E09, 0x1671, 0x1673, 0x166D,
+    0x166F, 0x0700, 0x0CE8, 0x167A, 0x1678, 0x08E7, 0x1677, 0x1680, 0x15F7, 0x1679, 0x167B, 0x167C, 0x168B, 0x1687, 0x160D, 0x1686,
+    0x1685, 0x1682, 0x1668, 0x1684, 0x1683, 0x1689, 0x1145, 0x168C, 0x0839, 0x1688, 0x168A, 0x0EA5, 0x168D, 0x1691, 0x168E, 0x10D3,
+    0x168F, 0x165C, 0x1692, 0x1693, 0x0614, 0x1695, 0x0887, 0x0A1F, 0x0813, 0x0662, 0x10BE, 0x1697, 0x1696, 0x1699, 0x079C, 0x0814,
+    0x073C, 0x169C, 0x169B, 0x169D, 0x068C, 0x0CD6, 0x169E, 0x073D, 0x16A0, 0x169F, 0x16A1, 0x16A2, 0x16A3, 0x09FE, 0x0BB3, 0x095F,
+    0x0F50, 0x0FA0, 0x1163, 0x0A15, 0x098E, 0x1130, 0x16A4, 0x16A5, 0x0A00, 0x16A6, 0x16A7, 0x16A9, 0x16A8, 0x0FF7, 0x0ABD, 0x0A6A,
+    0x09E3, 0x16AA, 0x16AC, 0x0B42, 0x16AB, 0x16AD, 0x16AE, 0x16AF, 0x16B0, 0x16B1, 0x16B3, 0x16B2, 0x16B4, 0x0663, 0x0CE9, 0x16B5,
+    0x09C5, 0x06EB, 0x16B6, 0x0DA1, 0x134A, 0x0782, 0x16B7, 0x16B8, 0x0FAA, 0x1008, 0x0E05, 0x16B9, 0x0EE4, 0x0EF9, 0x1051, 0x16BA,
+    0x16BC, 0x16BB, 0x16BE, 0x16BD, 0x16C1, 0x0A01, 0x102F, 0x16C2, 0x16C3, 0x0783, 0x16C4, 0x16C6, 0x16C5, 0x0B85, 0x0F18, 0x0629,
+    0x0EC3, 0x0D73, 0x0AA0, 0x07C1, 0x0EC4, 0x0A2C, 0x16C8, 0x073E, 0x0658, 0x0E30, 0x16C7, 0x091D, 0x0CF2, 0x16C9, 0x16D1, 0x16CA,
+    0x0C7F, 0x07C2, 0x16D2, 0x0888, 0x0784, 0x16D0, 0x16CE, 0x16CB, 0x10C0, 0x0D3E, 0x0E17, 0x16CC, 0x16D4, 0x16D3, 0x0842, 0x066B,
+    0x0979, 0x16CD, 0x16CF, 0x0FF6, 0x0CB2, 0x1017, 0x16DC, 0x16DD, 0x068D, 0x0F66, 0x107B, 0x16DF, 0x0A21, 0x0B00, 0x16D8, 0x16DE,
+    0x0648, 0x07F5, 0x16D5, 0x16DA, 0x0BF2, 0x0E91, 0x0EE5, 0x16D7, 0x0FC0, 0x16D9, 0x16E2, 0x16E0, 0x16DB, 0x0FC1, 0x0E67, 0x07C3,
+    0x0D84, 0x0D0D, 0x16E3, 0x16E1, 0x0C97, 0x16D6, 0x062A, 0x10AD, 0x16EE, 0x16ED, 0x0BF4, 0x16EA, 0x10CC, 0x0DF4, 0x16E4, 0x0D43,
+    0x062B, 0x091E, 0x16E7, 0x0A86, 0x16EC, 0x16EB, 0x16E6, 0x16E9, 0x0708, 0x16E8, 0x0E68, 0x10EC, 0x0B32, 0x0BF3, 0x16F4, 0x16F2,
+    0x0F2C, 0x16EF, 0x16F1, 0x0619, 0x091F, 0x1151, 0x06DC, 0x0F42, 0x10C1, 0x06C3, 0x0B5A, 0x16F3, 0x16F8, 0x0B01, 0x108F, 0x16F5,
+    0x16F0, 0x16F6, 0x111C, 0x0DD3, 0x0E00, 0x06D5, 0x0634, 0x16FC, 0x16FF, 0x1101, 0x10C4, 0x1706, 0x1700, 0x16FD, 0x1112, 0x1703,
+    0x0AA9, 0x1705, 0x170A, 0x0DD1, 0x1708, 0x1702, 0x0CD7, 0x1709, 0x16FE, 0x1704, 0x170B, 0x05FA, 0x1701, 0x170C, 0x0B5B, 0x0ABE,
+    0x0F63, 0x096C, 0x16F9, 0x1707, 0x0D99, 0x0BB4, 0x0709, 0x098F, 0x0B02, 0x16FB, 0x0AA1, 0x086B, 0x16FA, 0x1710, 0x0ACD, 0x08B8,
+    0x171F, 0x1719, 0x07D4, 0x0DAE, 0x1714, 0x171D, 0x05AD, 0x0611, 0x0677, 0x1716, 0x0C6A, 0x170D, 0x170F, 0x0920, 0x1720, 0x171B,
+    0x1713, 0x171A, 0x1029, 0x1718, 0x171C, 0x08CE, 0x0B03, 0x0CD8, 0x1712, 0x108E, 0x1715, 0x170E, 0x0DD2, 0x1711, 0x1717, 0x1170,
+    0x0A3C, 0x101E, 0x1721, 0x0EAC, 0x172D, 0x08B9, 0x0AC0, 0x1723, 0x10ED, 0x0921, 0x1730, 0x05EC, 0x172E, 0x1722, 0x1728, 0x172A,
+    0x10AE, 0x1725, 0x0D8D, 0x1727, 0x172F, 0x1729, 0x1045, 0x1724, 0x0A20, 0x173C, 0x070A, 0x1726, 0x172B, 0x172C, 0x0CAA, 0x0C98,
+    0x1734, 0x173A, 0x1738, 0x0D88, 0x1742, 0x1735, 0x1736, 0x171E, 0x07D9, 0x0F19, 0x0A3D, 0x0957, 0x1152, 0x1732, 0x1741, 0x0649,
+    0x0C46, 0x0E99, 0x073F, 0x1138, 0x101F, 0x0D50, 0x1739, 0x173B, 0x0C11, 0x1740, 0x1737, 0x1731, 0x0741, 0x0889, 0x174E, 0x1749,
+    0x0BF6, 0x0703, 0x0AC1, 0x1752, 0x174B, 0x0D2A, 0x1748, 0x0D57, 0x176B, 0x1745, 0x1744, 0x174D, 0x1747, 0x1746, 0x174C, 0x0B9F,
+    0x1743, 0x174F, 0x1750, 0x0740, 0x1755, 0x1754, 0x1756, 0x1759, 0x0DA2, 0x1753, 0x1757, 0x0883, 0x0CB7, 0x1751, 0x0E5A, 0x1758,
+    0x175D, 0x175B, 0x175E, 0x1761, 0x175A, 0x094A, 0x0E47, 0x16F7, 0x10D4, 0x175C, 0x1760, 0x0CB3, 0x175F, 0x174A, 0x1D89, 0x1764,
+    0x1768, 0x1766, 0x1762, 0x1763, 0x1767, 0x1765, 0x0F2D, 0x176D, 0x176A, 0x1769, 0x176C, 0x0E12, 0x176E, 0x0D15, 0x0CAB, 0x0BA3,
+    0x176F, 0x1771, 0x1770, 0x1733, 0x1772, 0x0E25, 0x1773, 0x068E, 0x0DD4, 0x06C4, 0x07C4, 0x0A5C, 0x0990, 0x1146, 0x0B86, 0x064A,
+    0x1775, 0x1774, 0x1778, 0x0CD9, 0x177B, 0x1776, 0x177A, 0x1779, 0x0D9F, 0x05D7, 0x1133, 0x177D, 0x0607, 0x1780, 0x177E, 0x177C,
+    0x1777, 0x0FC2, 0x1782, 0x1781, 0x064B, 0x1784, 0x0F70, 0x1783, 0x1033, 0x0B05, 0x0C12, 0x0B04, 0x1139, 0x178A, 0x0BF7, 0x1786,
+    0x178B, 0x064C, 0x1789, 0x0E81, 0x1785, 0x1788, 0x0B06, 0x0ECF, 0x178C, 0x0A4F, 0x0BF8, 0x178F, 0x1787, 0x0846, 0x178D, 0x10AF,
+    0x1790, 0x1F24, 0x0AAE, 0x1791, 0x1792, 0x0E4D, 0x1794, 0x1795, 0x0E52, 0x0DD5, 0x1797, 0x1799, 0x1113, 0x1796, 0x1798, 0x064D,
+    0x1793, 0x12FA, 0x179A, 0x0C47, 0x09D7, 0x179C, 0x179B, 0x0B43, 0x1297, 0x179D, 0x179F, 0x178E, 0x179E, 0x17A0, 0x0E9A, 0x17A1,
+    0x17A2, 0x17A3, 0x17A4, 0x0D5C, 0x17A6, 0x17A5, 0x17A7, 0x17A8, 0x0A5D, 0x0F43, 0x106A, 0x17A9, 0x17AA, 0x0C35, 0x0A22, 0x17AB,
+    0x17AC, 0x17AD, 0x0F90, 0x0EC5, 0x17AE, 0x0E76, 0x0D2B, 0x17AF, 0x06A5, 0x07CD, 0x1044, 0x1034, 0x0672, 0x1153, 0x0FF1, 0x0F68,
+    0x0BB5, 0x17B0, 0x0E01, 0x08A1, 0x17B1, 0x0992, 0x17B3, 0x17B2, 0x17B4, 0x17B5, 0x17B6, 0x079D, 0x17B7, 0x17B8, 0x08A2, 0x0EC6,
+    0x17BA, 0x0B33, 0x17B9, 0x07F6, 0x17BB, 0x17BD, 0x17BC, 0x17BE, 0x08CF, 0x17BF, 0x0827, 0x0C1F, 0x095D, 0x17C1, 0x17C2, 0x17C0,
+    0x0A6B, 0x0E06, 0x07F7, 0x17C4, 0x0CCB, 0x17C3, 0x1154, 0x0E82, 0x17C7, 0x17C9, 0x17C6, 0x1052, 0x17C8, 0x17CA, 0x1102, 0x17CE,
+    0x17CD, 0x0D16, 0x0E4C, 0x08A3, 0x17CC, 0x17CB, 0x1090, 0x1091, 0x17CF, 0x064E, 0x0956, 0x0A02, 0x17D0, 0x17D1, 0x17D3, 0x0AA2,
+    0x17D5, 0x17D4, 0x17D6, 0x06EC, 0x17D8, 0x17D7, 0x17DA, 0x17D9, 0x08BA, 0x10E6, 0x080A, 0x0664, 0x0828, 0x075F, 0x1126, 0x17DC,
+    0x17DE, 0x17DF, 0x068F, 0x17DB, 0x09D8, 0x0D3F, 0x17DD, 0x17E2, 0x0A6C, 0x17E0, 0x085D, 0x0EC7, 0x17E1, 0x17FC, 0x17E7, 0x08BB,
+    0x07C5, 0x17E4, 0x10DD, 0x10EE, 0x0CB4, 0x17E6, 0x17E8, 0x1114, 0x0815, 0x0EFA, 0x0E69, 0x17E9, 0x17EB, 0x17EE, 0x17EA, 0x17ED,
+    0x08E8, 0x062C, 0x17EF, 0x0B90, 0x17EC, 0x111A, 0x17F2, 0x1F22, 0x17F0, 0x17F3, 0x17E5, 0x17F1, 0x097A, 0x17F4, 0x17F5, 0x10DE,
+    0x17F6, 0x17F7, 0x17E3, 0x17F8, 0x0742, 0x0A23, 0x17F9, 0x17FA, 0x17FB, 0x061A, 0x1800, 0x0F1A, 0x1801, 0x0722, 0x1802, 0x1803,
+    0x1804, 0x1806, 0x1807, 0x1805, 0x0F32, 0x1809, 0x1808, 0x180B, 0x180A, 0x180C, 0x180D, 0x180F, 0x180E, 0x0959, 0x1811, 0x1810,
+    0x0743, 0x0B72, 0x0D9B, 0x1812, 0x0BB6, 0x09D9, 0x0659, 0x1813, 0x10B0, 0x0FA1, 0x1814, 0x0DA3, 0x1092, 0x0922, 0x0B5C, 0x0CEA,
+    0x1272, 0x0D2C, 0x06A6, 0x1815, 0x1816, 0x181B, 0x1819, 0x1818, 0x1580, 0x06C5, 0x1817, 0x05D8, 0x0EA8, 0x0EC8, 0x10EF, 0x181C,
+    0x181A, 0x0CFB, 0x0BA4, 0x0EA9, 0x0F0C, 0x181E, 0x10EA, 0x086C, 0x181F, 0x181D, 0x0ED4, 0x1820, 0x1821, 0x05D9, 0x0B34, 0x1826,
+    0x1823, 0x0E2B, 0x1822, 0x0785, 0x1829, 0x1824, 0x1825, 0x1828, 0x1827, 0x0F04, 0x0C21, 0x0C20, 0x079E, 0x182A, 0x182B, 0x182C,
+    0x182E, 0x182D, 0x0635, 0x1836, 0x0EE6, 0x1830, 0x1832, 0x1834, 0x0B5D, 0x1835, 0x1833, 0x0A3E, 0x182F, 0x1831, 0x0F21, 0x0B07,
+    0x1838, 0x1837, 0x1839, 0x0A24, 0x096D, 0x0DD7, 0x183A, 0x0D49, 0x183C, 0x10DF, 0x183B, 0x0C49, 0x1842, 0x1844, 0x1845, 0x0CF3,
+    0x1843, 0x1840, 0x183D, 0x183E, 0x1841, 0x1848, 0x1846, 0x1847, 0x1849, 0x184B, 0x184C, 0x184D, 0x184E, 0x184A, 0x1850, 0x184F,
+    0x1851, 0x1103, 0x1854, 0x1852, 0x1853, 0x0760, 0x107C, 0x0F88, 0x1856, 0x1855, 0x1857, 0x1858, 0x185C, 0x1859, 0x185A, 0x185B,
+    0x185D, 0x185E, 0x185F, 0x1860, 0x1861, 0x0EAD, 0x0DAF, 0x1862, 0x0E92, 0x0F13, 0x1863, 0x1864, 0x0D89, 0x06C6, 0x0923, 0x1865,
+    0x1866, 0x1867, 0x09C8, 0x1869, 0x1868, 0x186A, 0x186B, 0x0EE7, 0x186C, 0x186D, 0x1F09, 0x186E, 0x186F, 0x1870, 0x09CD, 0x1871,
+    0x0E75, 0x0FFE, 0x062D, 0x0636, 0x1872, 0x1874, 0x1873, 0x0DD0, 0x0BB7, 0x1698, 0x1875, 0x103F, 0x1876, 0x0744, 0x0ED5, 0x1877,
+    0x1878, 0x1879, 0x105A, 0x1053, 0x0D3C, 0x0C4A, 0x187B, 0x0AC2, 0x0B08, 0x187E, 0x187D, 0x187C, 0x0EFB, 0x0745, 0x08A7, 0x1884,
+    0x1881, 0x0B5E, 0x1030, 0x1880, 0x1882, 0x1883, 0x187F, 0x1885, 0x1886, 0x0D2D, 0x0761, 0x0D05, 0x1887, 0x1888, 0x188B, 0x0B87,
+    0x0E02, 0x188C, 0x0FF2, 0x1889, 0x188A, 0x188F, 0x188E, 0x188D, 0x1891, 0x1890, 0x1892, 0x1894, 0x1893, 0x0F8B, 0x0AB5, 0x1104,
+    0x1895, 0x0DF5, 0x1896, 0x1897, 0x189B, 0x1899, 0x189A, 0x1898, 0x189C, 0x189D, 0x189E, 0x189F, 0x1035, 0x18A0, 0x106E, 0x18A1,
+    0x0CED, 0x0E8A, 0x0829, 0x0CDA, 0x18A2, 0x07F8, 0x0BCE, 0x18A3, 0x097B, 0x18A4, 0x18A5, 0x08A4, 0x0993, 0x18A7, 0x0DB5, 0x0994,
+    0x07AD, 0x0FC3, 0x0E6A, 0x0DB6, 0x093B, 0x18A9, 0x0B09, 0x10F0, 0x0924, 0x08A5, 0x0EA1, 0x18AB, 0x18AD, 0x08E9, 0x18AC, 0x0D74,
+    0x18AF, 0x06D6, 0x18AA, 0x0EE8, 0x060F, 0x09AA, 0x1171, 0x18AE, 0x18B0, 0x0F89, 0x0BD7, 0x18B2, 0x18B3, 0x18B1, 0x06ED, 0x18B9,
+    0x18B8, 0x0A25, 0x18BA, 0x18B5, 0x18BB, 0x18B6, 0x0ED6, 0x18B4, 0x18B7, 0x18C1, 0x18C0, 0x1001, 0x18BC, 0x05E9, 0x18C3, 0x18C2,
+    0x0B0A, 0x18C4, 0x0C22, 0x18C6, 0x18C5, 0x18C7, 0x18A6, 0x18A8, 0x18C9, 0x18C8, 0x0A26, 0x1127, 0x0A50, 0x18CA, 0x0856, 0x079F,
+    0x0786, 0x0A03, 0x1093, 0x18D0, 0x18CF, 0x0C23, 0x18CC, 0x18CE, 0x0AAA, 0x0B5F, 0x18CD, 0x18CB, 0x0E49, 0x0B0B, 0x0F1B, 0x0995,
+    0x0DD8, 0x18D1, 0x18D2, 0x18E8, 0x0816, 0x115C, 0x0C14, 0x18D3, 0x0690, 0x0D75, 0x0F5F, 0x18D4, 0x07DA, 0x18D5, 0x18D7, 0x18D8,
+    0x0E48, 0x18D9, 0x18DA, 0x18DB, 0x0817, 0x0691, 0x0E03, 0x0A87, 0x0A04, 0x18DC, 0x0A88, 0x0688, 0x0F22, 0x18DD, 0x0EE9, 0x0C24,
+    0x18E0, 0x18E1, 0x0E89, 0x0B60, 0x18DE, 0x0D01, 0x18DF, 0x0B0C, 0x05DA, 0x0788, 0x18E2, 0x0D76, 0x18E3, 0x0BC5, 0x102B, 0x0F02,
+    0x18E4, 0x18E5, 0x0CF4, 0x1105, 0x18E7, 0x18E6, 0x0A6D, 0x18E9, 0x05EE, 0x18EC, 0x18EA, 0x0692, 0x086D, 0x18EB, 0x0925, 0x0952,
+    0x0FA4, 0x18ED, 0x0FF3, 0x18EF, 0x0BCF, 0x062E, 0x0678, 0x05AA, 0x18EE, 0x18F0, 0x18F1, 0x0B35, 0x18F2, 0x06EE, 0x18F4, 0x088A,
+    0x07C6, 0x18F5, 0x0833, 0x18F6, 0x0BFA, 0x0E0B, 0x0BDE, 0x09B3, 0x18F7, 0x0D02, 0x0C4B, 0x18F9, 0x18FB, 0x18F8, 0x18FA, 0x0841,
+    0x18FC, 0x0845, 0x07C7, 0x10B1, 0x18FE, 0x1900, 0x060D, 0x1903, 0x0716, 0x1902, 0x1901, 0x1905, 0x18FD, 0x1906, 0x10E7, 0x1907,
+    0x1908, 0x1372, 0x190A, 0x1909, 0x190B, 0x190C, 0x10F3, 0x190D, 0x1DED, 0x0B0D, 0x190E, 0x190F, 0x0AB6, 0x0DF6, 0x1910, 0x0CC7,
+    0x1911, 0x0CDB, 0x1912, 0x07E3, 0x121E, 0x0CFC, 0x0A31, 0x0746, 0x1913, 0x1920, 0x1916, 0x07C8, 0x1915, 0x1922, 0x1914, 0x0B0E,
+    0x1918, 0x1919, 0x0D8A, 0x191A, 0x06FD, 0x0B79, 0x0F44, 0x191C, 0x0CA6, 0x1917, 0x191B, 0x191D, 0x09B9, 0x1924, 0x0F0D, 0x0EA4,
+    0x0DD9, 0x0818, 0x1923, 0x1921, 0x0EB3, 0x191E, 0x0CFD, 0x0DDB, 0x0DDA, 0x09B4, 0x1936, 0x1926, 0x1928, 0x192B, 0x192C, 0x1929,
+    0x192A, 0x1927, 0x1925, 0x191F, 0x0F8D, 0x0693, 0x1933, 0x1930, 0x1935, 0x1934, 0x0E93, 0x1025, 0x09DA, 0x192E, 0x1937, 0x1932,
+    0x1931, 0x192D, 0x192F, 0x0747, 0x0CDC, 0x0BFB, 0x0EA0, 0x193C, 0x0EA2, 0x0BDF, 0x1939, 0x0ECD, 0x193D, 0x0F91, 0x0CFA, 0x1938,
+    0x193A, 0x193B, 0x193E, 0x0A42, 0x0E04, 0x1943, 0x1942, 0x193F, 0x1155, 0x1948, 0x194C, 0x1949, 0x1945, 0x1946, 0x194B, 0x1940,
+    0x1293, 0x1947, 0x1941, 0x194A, 0x1950, 0x0748, 0x194D, 0x194E, 0x194F, 0x1952, 0x1951, 0x0EF4, 0x1953, 0x113A, 0x0FAB, 0x1958,
+    0x1955, 0x1954, 0x0BD0, 0x1957, 0x1959, 0x1956, 0x195D, 0x195A, 0x195B, 0x1944, 0x195C, 0x195E, 0x195F, 0x0F84, 0x1960, 0x1060,
+    0x080C, 0x0848, 0x1961, 0x0F72, 0x0B88, 0x102E, 0x1962, 0x10F1, 0x0E94, 0x0C25, 0x0E53, 0x0AAC, 0x05BE, 0x1967, 0x1965, 0x1963,
+    0x071F, 0x0B0F, 0x1968, 0x1966, 0x1964, 0x196C, 0x196B, 0x196A, 0x1969, 0x196D, 0x196E, 0x0BB8, 0x196F, 0x1971, 0x1970, 0x08D0,
+    0x0C17, 0x1973, 0x0DDC, 0x1972, 0x1974, 0x0F73, 0x0C4C, 0x0926, 0x1975, 0x1106, 0x1977, 0x1978, 0x1979, 0x197A, 0x0A05, 0x197B,
+    0x086E, 0x07CA, 0x0789, 0x1980, 0x1071, 0x0927, 0x197C, 0x1983, 0x1064, 0x0E5B, 0x0F12, 0x0AC3, 0x1982, 0x0A51, 0x0928, 0x0A06,
+    0x07C9, 0x0F74, 0x1981, 0x0C26, 0x0FE1, 0x09B5, 0x0A07, 0x0D5B, 0x1986, 0x111D, 0x0997, 0x1987, 0x0B61, 0x1989, 0x0B10, 0x096E,
+    0x1988, 0x0A89, 0x08BC, 0x0C27, 0x1984, 0x198A, 0x1985, 0x086F, 0x198D, 0x1991, 0x088B, 0x198C, 0x1995, 0x0929, 0x10CD, 0x05BA,
+    0x1992, 0x07CB, 0x198F, 0x1990, 0x0DDD, 0x198E, 0x198B, 0x06C7, 0x0BE2, 0x08A6, 0x1997, 0x1994, 0x1996, 0x1993, 0x0870, 0x0C71,
+    0x1998, 0x0C4E, 0x19A5, 0x19A1, 0x199B, 0x199F, 0x0A78, 0x05DB, 0x199A, 0x19A2, 0x19A6, 0x092A, 0x1054, 0x0D54, 0x199C, 0x19A4,
+    0x1999, 0x0CDD, 0x199E, 0x05BB, 0x1048, 0x199D, 0x0819, 0x0EEA, 0x0C4D, 0x110E, 0x0ACF, 0x19CE, 0x19A7, 0x0BFC, 0x19A3, 0x19A8,
+    0x19AA, 0x0D77, 0x19AD, 0x19A9, 0x0F92, 0x0749, 0x1049, 0x05DC, 0x19AC, 0x113B, 0x19AB, 0x064F, 0x0E2A, 0x19AE, 0x19B5, 0x19AF,
+    0x19B6, 0x19B2, 0x0E9B, 0x0A48, 0x19B4, 0x19B1, 0x19B7, 0x19B0, 0x0AA3, 0x0FC4, 0x0AAB, 0x19B3, 0x19C0, 0x19BB, 0x19BE, 0x19BC,
+    0x19C1, 0x19BA, 0x19A0, 0x0BD1, 0x0EC9, 0x19BD, 0x19B8, 0x0C00, 0x0871, 0x0A8A, 0x0B44, 0x0C15, 0x19C4, 0x19C6, 0x19C7, 0x19C3,
+    0x19C5, 0x19B9, 0x19C2, 0x19CA, 0x19C9, 0x101A, 0x084A, 0x19C8, 0x19CC, 0x19CB, 0x19CF, 0x19D1, 0x09DB, 0x19CD, 0x19D2, 0x19D3,
+    0x19D4, 0x19DA, 0x0D9A, 0x19D6, 0x19D5, 0x19D7, 0x19D8, 0x19D9, 0x19DB, 0x19DC, 0x074A, 0x19DD, 0x19DE, 0x19DF, 0x19E0, 0x19E1,
+    0x19E2, 0x19E3, 0x19E4, 0x19E6, 0x19E5, 0x19E7, 0x19E8, 0x19E9, 0x19EC, 0x19EA, 0x19EB, 0x099F, 0x0872, 0x0CF5, 0x0EB1, 0x0AD0,
+    0x0E6C, 0x0EEB, 0x19ED, 0x14EB, 0x19EE, 0x19F0, 0x10C5, 0x19EF, 0x19F2, 0x19F1, 0x10B2, 0x19F3, 0x0EFC, 0x19F4, 0x19F7, 0x19F6,
+    0x19F5, 0x19F8, 0x0851, 0x0C01, 0x07A0, 0x19FC, 0x19F9, 0x19FA, 0x19FD, 0x19FE, 0x19FB, 0x0608, 0x0665, 0x1A00, 0x1A01, 0x1A02,
+    0x10C2, 0x0A8B, 0x1A04, 0x1A03, 0x0B89, 0x1A05, 0x1A06, 0x1A07, 0x0763, 0x074B, 0x1A08, 0x1A09, 0x0FFC, 0x10C3, 0x10B3, 0x1156,
+    0x092C, 0x1A0C, 0x0A52, 0x1A0B, 0x1A0D, 0x0A27, 0x0C8F, 0x1A0E, 0x092B, 0x1055, 0x1A0F, 0x1A10, 0x1A11, 0x1A12, 0x1A13, 0x0A28,
+    0x106B, 0x1A15, 0x0CDE, 0x1A14, 0x1A17, 0x1A16, 0x1A18, 0x0BB9, 0x1A19, 0x1A1A, 0x0F77, 0x1A1B, 0x0C4F, 0x1A1C, 0x1A1D, 0x113C,
+    0x1A20, 0x1A1F, 0x1A1E, 0x0D2E, 0x1A21, 0x0B45, 0x1A22, 0x1A23, 0x1157, 0x1A24, 0x1A25, 0x1A27, 0x1A26, 0x0EA3, 0x0E37, 0x115D,
+    0x0EA7, 0x1A29, 0x0B11, 0x0F09, 0x1A2A, 0x1A28, 0x074C, 0x08D2, 0x0A08, 0x0EEC, 0x08A8, 0x0FE2, 0x1A2D, 0x1A2B, 0x092D, 0x092E,
+    0x05E7, 0x09A6, 0x0E78, 0x05DD, 0x1A32, 0x0CDF, 0x0E77, 0x0C99, 0x1A34, 0x1A30, 0x1A33, 0x1A2E, 0x1A31, 0x0FC5, 0x08D3, 0x05FB,
+    0x1A2F, 0x1A36, 0x1A37, 0x0DF7, 0x07F9, 0x1A45, 0x0E5C, 0x0A09, 0x07FA, 0x0BC6, 0x1165, 0x102C, 0x1A35, 0x0BD2, 0x07B2, 0x1A38,
+    0x1A3A, 0x1A39, 0x1A3B, 0x0CC5, 0x0E5D, 0x0D2F, 0x1A42, 0x1A41, 0x1A3C, 0x0B74, 0x0F45, 0x1A44, 0x1A43, 0x092F, 0x1172, 0x1A54,
+    0x1A48, 0x1A49, 0x0A6E, 0x1A47, 0x0958, 0x1A46, 0x1A4A, 0x0D30, 0x0F60, 0x0C02, 0x0C9A, 0x1A4E, 0x1A4F, 0x1A4B, 0x1A4C, 0x1A4D,
+    0x0930, 0x1A55, 0x1A51, 0x0F46, 0x100C, 0x0F07, 0x1A50, 0x1A53, 0x1A52, 0x0FE3, 0x1A56, 0x1A57, 0x0C16, 0x1A58, 0x1A5A, 0x1A5E,
+    0x1A5B, 0x1A59, 0x0E5E, 0x1A5C, 0x1A5D, 0x0670, 0x1A64, 0x1A5F, 0x1A60, 0x1A61, 0x0C5F, 0x1A63, 0x1A62, 0x1A65, 0x1A66, 0x1A67,
+    0x0B62, 0x06A7, 0x1A68, 0x1115, 0x0A29, 0x0A8C, 0x0A0A, 0x0CF6, 0x1A69, 0x1A6A, 0x0610, 0x1A6B, 0x1A6C, 0x1A6D, 0x1A6E, 0x1A6F,
+    0x07FB, 0x1568, 0x1A70, 0x0BE3, 0x1A71, 0x0A49, 0x1A72, 0x11AE, 0x1A73, 0x0F9C, 0x075A, 0x0C03, 0x0AB7, 0x0F51, 0x0A8D, 0x1A74,
+    0x0931, 0x1A75, 0x0ECA, 0x1A84, 0x1A77, 0x0C87, 0x0E95, 0x08BD, 0x1A76, 0x0C04, 0x1A78, 0x0D78, 0x1A7A, 0x1A79, 0x1A7C, 0x1A7B,
+    0x1A7D, 0x1A80, 0x1A7E, 0x074D, 0x1A81, 0x1A82, 0x1A83, 0x096F, 0x1107, 0x1A85, 0x0B46, 0x0650, 0x1A86, 0x1A87, 0x1A88, 0x05F0,
+    0x1A89, 0x1A8A, 0x0F47, 0x0A45, 0x1A8C, 0x06C8, 0x05B0, 0x1A8B, 0x1A8E, 0x0E6D, 0x0B63, 0x0694, 0x0FC6, 0x087C, 0x081A, 0x1A8D,
+    0x06A8, 0x0721, 0x0651, 0x1A92, 0x1128, 0x0C9B, 0x0F23, 0x1A9E, 0x0695, 0x1A9C, 0x1A9A, 0x1A91, 0x1A8F, 0x1A90, 0x0A61, 0x082A,
+    0x0D17, 0x0E0F, 0x0630, 0x1A94, 0x1A93, 0x1A99, 0x1A95, 0x1A98, 0x104E, 0x1A97, 0x0696, 0x071D, 0x1A9B, 0x1A9D, 0x0873, 0x1AA1,
+    0x1AAA, 0x1AAB, 0x05A9, 0x1AB2, 0x05EF, 0x1AA9, 0x1AA8, 0x1AA3, 0x1AA2, 0x1AA0, 0x1A9F, 0x0D03, 0x0CB9, 0x1AA5, 0x1AA4, 0x1AA7,
+    0x0C50, 0x0874, 0x0620, 0x1AA6, 0x0932, 0x0C51, 0x1AB8, 0x1AB9, 0x0697, 0x066C, 0x1AB6, 0x1AAC, 0x1AB4, 0x1ABB, 0x1AB5, 0x1AB3,
+    0x1A96, 0x1AB1, 0x1AAD, 0x074E, 0x1AAF, 0x1ABA, 0x1AB0, 0x1ABC, 0x1AAE, 0x0E9C, 0x10C9, 0x1AB7, 0x1ACD, 0x1AC5, 0x0B9B, 0x07A5,
+    0x081B, 0x1AC0, 0x0699, 0x0B12, 0x1AC3, 0x0998, 0x0DB0, 0x1AC8, 0x0FAC, 0x1ABF, 0x0698, 0x08D4, 0x0F08, 0x1AC9, 0x1ABD, 0x1AC6,
+    0x1AD0, 0x1AC1, 0x1AC2, 0x0DF8, 0x1AC7, 0x1AC4, 0x0FC7, 0x1ACA, 0x05DE, 0x1ABE, 0x1ACC, 0x1ACB, 0x0E8B, 0x1AD2, 0x1ADD, 0x071E,
+    0x1AE0, 0x1ACE, 0x1AD3, 0x10CE, 0x1ADC, 0x10B4, 0x10E8, 0x0D18, 0x070B, 0x0F52, 0x1AE2, 0x0DDF, 0x05AF, 0x1ADB, 0x1AD7, 0x0C52,
+    0x1AD1, 0x1AD9, 0x1ADE, 0x0E4B, 0x05A8, 0x1AD6, 0x1ADF, 0x0F58, 0x1ADA, 0x1AD5, 0x0B13, 0x0A8E, 0x0A2A, 0x1056, 0x0F26, 0x1AE5,
+    0x1AEE, 0x1AD8, 0x0717, 0x0B36, 0x1AE3, 0x1AE8, 0x0C53, 0x1AE4, 0x1AEB, 0x0CFE, 0x1AEC, 0x10B5, 0x1AE1, 0x06D7, 0x1AE7, 0x1AEA,
+    0x102A, 0x1AED, 0x1AE6, 0x1AE9, 0x0FC8, 0x1140, 0x1AF1, 0x1AF8, 0x1AF0, 0x0A41, 0x1ACF, 0x0F8C, 0x1020, 0x1AF7, 0x1AF6, 0x1AF2,
+    0x1AF3, 0x0615, 0x1AF5, 0x1AEF, 0x0D53, 0x1AF4, 0x05FC, 0x0C60, 0x0F81, 0x1AF9, 0x1B00, 0x0ED7, 0x1AFC, 0x0B14, 0x0A47, 0x1B02,
+    0x07FC, 0x1B03, 0x0F59, 0x1AFB, 0x1AD4, 0x1AFA, 0x116E, 0x0DE0, 0x0F53, 0x1B0A, 0x1B10, 0x1B11, 0x1B04, 0x0E96, 0x1B0E, 0x1B06,
+    0x1B08, 0x1B12, 0x1B07, 0x1B0B, 0x0652, 0x0E23, 0x1B0C, 0x1B0F, 0x1B05, 0x0C05, 0x1B09, 0x09C6, 0x0B64, 0x084F, 0x1072, 0x1077,
+    0x0AD2, 0x1B16, 0x1B14, 0x116D, 0x1B13, 0x10D5, 0x1B15, 0x1B17, 0x1B18, 0x1B1B, 0x1B19, 0x0DE1, 0x1B1A, 0x0ECB, 0x1B0D, 0x0AD3,
+    0x1B1C, 0x1B21, 0x0C54, 0x1B20, 0x1B01, 0x1B22, 0x0C28, 0x1B1D, 0x1B1F, 0x1B1E, 0x1690, 0x1681, 0x1B24, 0x1B23, 0x10D6, 0x187A,
+    0x1B25, 0x1B26, 0x1B27, 0x08D5, 0x07B3, 0x1B29, 0x123C, 0x07D5, 0x10F8, 0x0831, 0x1B2A, 0x1B2B, 0x0D0E, 0x1B2C, 0x0E38, 0x05B8,
+    0x06A1, 0x1B31, 0x1B32, 0x1B2D, 0x09DC, 0x1B2E, 0x0E61, 0x1B2F, 0x1B30, 0x1B3A, 0x1B34, 0x1B37, 0x1B33, 0x1B35, 0x1B36, 0x0A56,
+    0x1B38, 0x0CE0, 0x0875, 0x06E1, 0x1B3B, 0x06DE, 0x1B41, 0x1B3C, 0x1B40, 0x0EB8, 0x1B3D, 0x1B3E, 0x0F27, 0x0ED8, 0x1B42, 0x0CBB,
+    0x1B4C, 0x1B48, 0x06A9, 0x1B46, 0x0FC9, 0x1B47, 0x1B44, 0x1B45, 0x1B4A, 0x1B4D, 0x1B4B, 0x1B49, 0x1B43, 0x0CF7, 0x1B54, 0x1028,
+    0x1B52, 0x1B53, 0x1B4E, 0x1B50, 0x1B51, 0x1B4F, 0x0BE4, 0x1158, 0x1B58, 0x1B59, 0x1B5F, 0x0B49, 0x1B5B, 0x1B5E, 0x1B56, 0x1B55,
+    0x1B60, 0x069A, 0x1B5C, 0x1B61, 0x1B5D, 0x1B5A, 0x0D31, 0x1B57, 0x0E88, 0x1B65, 0x109A, 0x1B64, 0x1B63, 0x1B6C, 0x1B66, 0x1B6E,
+    0x10C6, 0x1B71, 0x1B68, 0x1B69, 0x1B6D, 0x1B70, 0x1B6F, 0x1B67, 0x1B6A, 0x1B7B, 0x1B74, 0x1B72, 0x1B73, 0x1B78, 0x1B79, 0x06C9,
+    0x07A1, 0x1B77, 0x1B62, 0x1B76, 0x1B7A, 0x1B75, 0x1B7C, 0x1B7E, 0x1B7D, 0x1B80, 0x1B7F, 0x1B39, 0x1B84, 0x1B81, 0x1B82, 0x1B83,
+    0x1B85, 0x088C, 0x1B87, 0x1B86, 0x0A8F, 0x0933, 0x16E5, 0x1B88, 0x0AB0, 0x06D8, 0x1B89, 0x0631, 0x0B15, 0x1B8A, 0x0934, 0x1B8B,
+    0x05DF, 0x0F1C, 0x1B8C, 0x0B8A, 0x1B93, 0x1B90, 0x0D0F, 0x1B91, 0x1B8E, 0x081C, 0x1B8D, 0x1B94, 0x0855, 0x0C9C, 0x1B9A, 0x1B96,
+    0x0C73, 0x1B95, 0x1B98, 0x1B8F, 0x1B99, 0x1B9B, 0x0EED, 0x1B97, 0x1B9C, 0x1B9E, 0x08D1, 0x1B92, 0x05BF, 0x1B9D, 0x0999, 0x1134,
+    0x1B9F, 0x1BA0, 0x0C55, 0x10E0, 0x1BA1, 0x1094, 0x1BA2, 0x1BA3, 0x0FA2, 0x1BA4, 0x097E, 0x10E1, 0x1BA9, 0x1BAA, 0x0B16, 0x1BA8,
+    0x10C7, 0x1BA5, 0x1BA7, 0x0BBB, 0x0B9E, 0x1BA6, 0x1BAB, 0x0F61, 0x1BAD, 0x1BAC, 0x070C, 0x0FCA, 0x1BAE, 0x1BBA, 0x1BB0, 0x1BB1,
+    0x1BB2, 0x1BB3, 0x1BB7, 0x1BB8, 0x1BB6, 0x1BB4, 0x1BAF, 0x1BB5, 0x1BB9, 0x1DB5, 0x0666, 0x1BBC, 0x081D, 0x1BBB, 0x1BC1, 0x1BC0,
+    0x1BC3, 0x1BC2, 0x1BC4, 0x0A90, 0x1BC5, 0x1BC6, 0x1BC7, 0x0BBC, 0x10B6, 0x1BC8, 0x0F62, 0x0E65, 0x1BC9, 0x1BCA, 0x08A9, 0x078B,
+    0x1BCB, 0x0A0B, 0x0E60, 0x1BCC, 0x06EF, 0x1BCD, 0x1BCF, 0x10D7, 0x1BCE, 0x0B65, 0x1BD0, 0x1BD1, 0x1BD2, 0x074F, 0x1BD3, 0x1BD4,
+    0x1BD5, 0x1BD6, 0x06F0, 0x1BD7, 0x1BD8, 0x1BD9, 0x06B0, 0x0B47, 0x1BDA, 0x1BDB, 0x1BDC, 0x08BE, 0x0D79, 0x1BDD, 0x0876, 0x0B75,
+    0x1BE0, 0x0DE2, 0x1BDF, 0x0850, 0x1BDE, 0x0CB5, 0x078C, 0x1BE1, 0x1BE2, 0x0B17, 0x088D, 0x1BE3, 0x0FCB, 0x0BDD, 0x07D6, 0x1073,
+    0x0C29, 0x1BE4, 0x0B66, 0x0D10, 0x0B18, 0x1BE5, 0x1BE8, 0x1BE9, 0x097C, 0x0C80, 0x1BE7, 0x0B19, 0x0F1D, 0x1BE6, 0x0A0C, 0x0632,
+    0x1BED, 0x0877, 0x0A0E, 0x0A0D, 0x116C, 0x1BEC, 0x1BEB, 0x0C06, 0x07AC, 0x1162, 0x06D9, 0x0B1A, 0x1BEA, 0x1BEF, 0x1BF0, 0x1BEE,
+    0x08D6, 0x109F, 0x0A0F, 0x0E46, 0x1BF3, 0x0BBE, 0x0CE1, 0x1095, 0x1BF6, 0x08EA, 0x0BBD, 0x1BF2, 0x1BF7, 0x08EB, 0x1BF4, 0x1BF5,
+    0x1BF1, 0x0BE0, 0x0E07, 0x0CCE, 0x069B, 0x0EEE, 0x07A2, 0x0D32, 0x1BFA, 0x1BF8, 0x0CEB, 0x0BBF, 0x0750, 0x1BF9, 0x0B7A, 0x1108,
+    0x115F, 0x1BFB, 0x1C07, 0x0D33, 0x1C06, 0x1C03, 0x1C0B, 0x1C04, 0x1C00, 0x0D7A, 0x1BFE, 0x1BFC, 0x1080, 0x0A10, 0x1C01, 0x1BFD,
+    0x1C05, 0x0AD4, 0x08BF, 0x0CB8, 0x0FE4, 0x0639, 0x05E0, 0x0DE3, 0x1C09, 0x1C08, 0x0E24, 0x1C0D, 0x1C02, 0x1C0C, 0x1C0E, 0x08AA,
+    0x1C0A, 0x0935, 0x0A53, 0x1C0F, 0x10B7, 0x1C12, 0x1C15, 0x1C13, 0x0F14, 0x1C10, 0x081E, 0x1C14, 0x1C16, 0x1C1A, 0x1C17, 0x1C19,
+    0x1C18, 0x1C1B, 0x0A2F, 0x1C1D, 0x1C1C, 0x0F48, 0x1C1F, 0x0878, 0x1C1E, 0x1C20, 0x1C21, 0x07A3, 0x19FF, 0x0B37, 0x1C22, 0x08EC,
+    0x1C23, 0x1C24, 0x09DD, 0x158C, 0x1C25, 0x1C26, 0x0A91, 0x1C27, 0x1C28, 0x1C29, 0x1C2A, 0x1C2B, 0x0CCA, 0x1C2C, 0x1C2E, 0x1C2D,
+    0x0DE4, 0x1C2F, 0x0FCC, 0x1C30, 0x1C31, 0x1C32, 0x1C33, 0x0E18, 0x0B1B, 0x1C34, 0x094B, 0x11AC, 0x1C35, 0x1C36, 0x0F1E, 0x1C37,
+    0x1C3F, 0x1C38, 0x1C3A, 0x1C39, 0x1C3B, 0x0FE5, 0x1C3C, 0x1C3D, 0x1C3E, 0x1C40, 0x06CC, 0x0D65, 0x0F49, 0x09A0, 0x0936, 0x0F2E,
+    0x069D, 0x0ECC, 0x1C43, 0x0751, 0x0BD3, 0x1C42, 0x1C47, 0x0D19, 0x1061, 0x1C45, 0x1C46, 0x078D, 0x1C48, 0x0E83, 0x0C9D, 0x0EEF,
+    0x0D9C, 0x1C44, 0x0FE6, 0x06AA, 0x1C4A, 0x1147, 0x0D40, 0x1164, 0x0A11, 0x1C49, 0x0C6F, 0x1C5A, 0x0C07, 0x0E36, 0x0F2F, 0x1C4D,
+    0x09DE, 0x0A12, 0x0B1C, 0x0E85, 0x08AB, 0x1C4C, 0x1C4B, 0x0F4A, 0x0A3F, 0x0DB1, 0x1C4F, 0x1C50, 0x0937, 0x1C4E, 0x1C51, 0x1C52,
+    0x1C54, 0x0C61, 0x1C53, 0x0764, 0x1C56, 0x1C55, 0x1C57, 0x1C59, 0x1C5B, 0x1C5C, 0x0BD4, 0x0A4D, 0x1C5D, 0x06F1, 0x1C5E, 0x0C56,
+    0x1C5F, 0x1C60, 0x0F4B, 0x078E, 0x1C61, 0x0D34, 0x063A, 0x1C62, 0x0A6F, 0x0B96, 0x0C6B, 0x1C65, 0x1C64, 0x1C63, 0x1C6B, 0x1C69,
+    0x1C66, 0x1C68, 0x1C67, 0x1C6A, 0x07D7, 0x1C6E, 0x0BD5, 0x1C6F, 0x08D7, 0x1C6C, 0x1C6D, 0x1148, 0x0D35, 0x0C08, 0x1C70, 0x1C73,
+    0x1C71, 0x1C72, 0x10B8, 0x0DE5, 0x1C76, 0x1C74, 0x1C75, 0x1C77, 0x1C88, 0x1C7A, 0x1C7B, 0x1C79, 0x1C78, 0x0D7B, 0x1C80, 0x1C84,
+    0x1C81, 0x1C7C, 0x1C82, 0x1C83, 0x1C8A, 0x1C85, 0x0BD6, 0x1C87, 0x1C89, 0x1C86, 0x1C8C, 0x0A92, 0x1C8B, 0x1C8D, 0x1C8E, 0x1C91,
+    0x1C90, 0x1C8F, 0x1C93, 0x1C92, 0x1074, 0x1C95, 0x1C94, 0x1C96, 0x1C97, 0x1C99, 0x1C98, 0x0B67, 0x1C9A, 0x082B, 0x1C9B, 0x1C9D,
+    0x1C9E, 0x1C9F, 0x1C9C, 0x1CA0, 0x0A54, 0x1CA1, 0x078F, 0x0852, 0x08AC, 0x1CA2, 0x0E2E, 0x0D9D, 0x1CA3, 0x1CA6, 0x0A32, 0x1CA5,
+    0x1CA4, 0x0879, 0x1CA7, 0x06F2, 0x1CA9, 0x099A, 0x1CA8, 0x1CB1, 0x1CAB, 0x1CAD, 0x0FA3, 0x1CAA, 0x1CAC, 0x1CB0, 0x1CAE, 0x0790,
+    0x1CAF, 0x1CB2, 0x0E79, 0x1116, 0x0A93, 0x1CB3, 0x1081, 0x1CB5, 0x1CB4, 0x1CB8, 0x10A0, 0x1CB7, 0x070D, 0x1CB6, 0x1CBB, 0x1CBA,
+    0x1CB9, 0x0D91, 0x1CBC, 0x1CBD, 0x1CBE, 0x094C, 0x0844, 0x1CC0, 0x1CC1, 0x1CC2, 0x0B68, 0x1CC3, 0x0A2B, 0x1CC4, 0x1CC5, 0x125F,
+    0x125E, 0x1CC6, 0x19D0, 0x1CC7, 0x0CC3, 0x0B4A, 0x0E5F, 0x1CC8, 0x0F93, 0x0D52, 0x095E, 0x0CC8, 0x0609, 0x1018, 0x0B76, 0x087D,
+    0x081F, 0x0F94, 0x1CC9, 0x1CCB, 0x1CCA, 0x069E, 0x0E34, 0x1CCC, 0x0E97, 0x0D92, 0x1CCD, 0x0AB1, 0x1CCF, 0x1040, 0x1CDE, 0x1CD1,
+    0x1CD2, 0x0D47, 0x0C9E, 0x0C57, 0x0DE6, 0x1CD0, 0x07B4, 0x1CD9, 0x1CD6, 0x1CE3, 0x0DE7, 0x0D00, 0x1CD3, 0x0D7C, 0x0DB2, 0x1CD4,
+    0x1CD8, 0x0B80, 0x0E87, 0x0D4A, 0x0BC0, 0x1CD7, 0x0C6C, 0x0C62, 0x1CD5, 0x05A7, 0x1141, 0x1CDA, 0x0C9F, 0x0A94, 0x0B69, 0x1CDC,
+    0x1CDB, 0x05ED, 0x1CDD, 0x0F0E, 0x1CE5, 0x0E19, 0x0B8B, 0x0CF8, 0x0836, 0x1CE4, 0x1096, 0x061E, 0x0F95, 0x069F, 0x1CDF, 0x1CE0,
+    0x1CE1, 0x1CE2, 0x0DF9, 0x0CC2, 0x05E1, 0x1CE6, 0x1CE7, 0x1F21, 0x0C7B, 0x1CE8, 0x0653, 0x0C2B, 0x08AD, 0x10B9, 0x1CE9, 0x0D8B,
+    0x0C58, 0x0A55, 0x1CEA, 0x1CED, 0x0AC5, 0x1CEB, 0x0C0A, 0x0C09, 0x05E2, 0x1109, 0x1CEF, 0x0EF0, 0x1CF1, 0x1CF0, 0x1CEE, 0x1904,
+    0x0752, 0x1CCE, 0x1CF3, 0x1CF2, 0x1CF4, 0x1097, 0x0E1F, 0x0FCD, 0x1CF5, 0x0A57, 0x1CF6, 0x1CF7, 0x1CF8, 0x0D80, 0x05E8, 0x0938,
+    0x1159, 0x1CFC, 0x0853, 0x1CF9, 0x1CFA, 0x0F54, 0x06F3, 0x1098, 0x07FD, 0x0DB3, 0x1CFD, 0x1CFE, 0x1CFF, 0x0D81, 0x1D01, 0x1D00,
+    0x0E11, 0x1D02, 0x0A95, 0x0A5E, 0x0E7A, 0x0D11, 0x0A70, 0x0B8C, 0x1D03, 0x1D04, 0x0B7C, 0x1D05, 0x1D06, 0x1D07, 0x10CF, 0x0A96,
+    0x1D09, 0x1D08, 0x0939, 0x0953, 0x09DF, 0x1D0C, 0x0AC6, 0x1D0B, 0x1D0A, 0x0CA7, 0x08ED, 0x0BC1, 0x0EAE, 0x0A98, 0x1D0D, 0x0B1D,
+    0x1D10, 0x1D0E, 0x1D0F, 0x1D12, 0x1D11, 0x0B38, 0x1D13, 0x1D14, 0x1D15, 0x0ECE, 0x0991, 0x0A5F, 0x1D16, 0x1D17, 0x10E2, 0x0AA4,
+    0x106C, 0x110A, 0x1D18, 0x0820, 0x1D19, 0x0D82, 0x1D1C, 0x0718, 0x0B6A, 0x1D1A, 0x1D1B, 0x0D5E, 0x0FF4, 0x083A, 0x1D1E, 0x1D1F,
+    0x1D1D, 0x1D21, 0x0E1D, 0x06E2, 0x1D25, 0x1D22, 0x1D24, 0x1D20, 0x1D6E, 0x1D23, 0x1129, 0x08D8, 0x1D2D, 0x0D93, 0x1D28, 0x1D2B,
+    0x1D29, 0x1D2E, 0x1D2F, 0x1D27, 0x1D34, 0x0654, 0x1D26, 0x0EAB, 0x1D2A, 0x0B1E, 0x093A, 0x0FE7, 0x0822, 0x0AA5, 0x0DFA, 0x0C0C,
+    0x1D32, 0x1D2C, 0x1D31, 0x1041, 0x0D36, 0x1D33, 0x1D30, 0x0C0B, 0x1D37, 0x1D36, 0x1D35, 0x0FCE, 0x0ADB, 0x1D38, 0x0F9D, 0x0633,
+    0x0F25, 0x0D12, 0x07D8, 0x1D3A, 0x093C, 0x09CB, 0x1D39, 0x0B8D, 0x0B8E, 0x1D40, 0x1D42, 0x0B39, 0x1D41, 0x1D43, 0x0811, 0x0F24,
+    0x0A60, 0x1142, 0x1D3C, 0x09B6, 0x115E, 0x1D45, 0x1D44, 0x1D46, 0x1D3B, 0x0E27, 0x0DB4, 0x0D55, 0x1D4B, 0x0CE2, 0x1D47, 0x1D48,
+    0x084C, 0x1D4A, 0x08AE, 0x1D49, 0x0B1F, 0x0719, 0x1D4F, 0x097D, 0x0C59, 0x0D48, 0x06DA, 0x1D4D, 0x1D4E, 0x0D41, 0x1D4C, 0x1D50,
+    0x1D56, 0x1D59, 0x1D58, 0x0D8C, 0x1D51, 0x1D52, 0x1D55, 0x1D57, 0x07FE, 0x1D5A, 0x1D54, 0x1D53, 0x1D5E, 0x1D5F, 0x1D60, 0x1D5D,
+    0x1D5C, 0x0B20, 0x0DE8, 0x1D5B, 0x1D64, 0x1D62, 0x1D63, 0x1D61, 0x0CB6, 0x1D65, 0x1D66, 0x1D68, 0x0753, 0x1D67, 0x1078, 0x1D73,
+    0x1D69, 0x1D6C, 0x1D6A, 0x1D6B, 0x1D6D, 0x1D6F, 0x1D70, 0x1D71, 0x1D74, 0x1D72, 0x1D75, 0x1D77, 0x1D76, 0x0D37, 0x1065, 0x1D78,
+    0x0C0D, 0x1D79, 0x0F82, 0x1D7A, 0x06CA, 0x061B, 0x0755, 0x0754, 0x1D7B, 0x1D7C, 0x1D7D, 0x1D7E, 0x1D80, 0x0756, 0x06F4, 0x093D,
+    0x0EB4, 0x1D82, 0x1D81, 0x1D83, 0x063B, 0x1D86, 0x1D85, 0x1D84, 0x1D87, 0x1D8A, 0x05C5, 0x1D88, 0x1D8C, 0x1D8B, 0x1D8E, 0x1D8D,
+    0x1D8F, 0x0DEC, 0x1D90, 0x1D91, 0x1D93, 0x1D92, 0x0F4C, 0x1D94, 0x1D95, 0x09A3, 0x1D96, 0x1D97, 0x0FE8, 0x0C2A, 0x05A2, 0x0C89,
+    0x1D98, 0x0F4D, 0x1D9B, 0x1D99, 0x093E, 0x1D9A, 0x08C0, 0x0F83, 0x1D9D, 0x1D9F, 0x1D9E, 0x1DA0, 0x0600, 0x0B77, 0x0ADC, 0x0757,
+    0x1DA1, 0x0E86, 0x1DA3, 0x0601, 0x1DA2, 0x0D42, 0x110B, 0x0DE9, 0x1D9C, 0x10E4, 0x08AF, 0x10BA, 0x0837, 0x10F2, 0x0847, 0x0CA0,
+    0x1A40, 0x1DA4, 0x06CB, 0x0B8F, 0x06F5, 0x1DA6, 0x1DA7, 0x1DA5, 0x0884, 0x099B, 0x0B21, 0x0602, 0x1117, 0x1DA9, 0x1CEC, 0x1DA8,
+    0x1DAC, 0x1DAA, 0x1DAB, 0x1DAD, 0x1DAE, 0x112A, 0x1DAF, 0x1DB0, 0x0BC7, 0x0EB9, 0x0B9D, 0x0765, 0x1099, 0x06AB, 0x0A97, 0x08D9,
+    0x1DB3, 0x1DB2, 0x0A13, 0x1DB4, 0x1DB1, 0x09C7, 0x1DB8, 0x1B6B, 0x1294, 0x0B97, 0x1DB6, 0x10E3, 0x0E2F, 0x060A, 0x0BE1, 0x0A34,
+    0x0F75, 0x061F, 0x112B, 0x10CB, 0x1DB9, 0x0DA4, 0x0A79, 0x1DBA, 0x1DBB, 0x0B6B, 0x1DBC, 0x112C, 0x1DB7, 0x1DBE, 0x1DC0, 0x1DBF,
+    0x1DBD, 0x1DC1, 0x1DC2, 0x0C5A, 0x06A0, 0x1DC3, 0x1036, 0x1DC4, 0x1DC5, 0x1149, 0x15D0, 0x1DC6, 0x1DC7, 0x1DC8, 0x1DCC, 0x1DC9,
+    0x1DCA, 0x1DCB, 0x1DCD, 0x0BC2, 0x1075, 0x0BC3, 0x1DCE, 0x0EF1, 0x1DCF, 0x1EF2, 0x104A, 0x1DD0, 0x1DD1, 0x1DD2, 0x06F6, 0x1DD4,
+    0x0B78, 0x1DD5, 0x0843, 0x1DD6, 0x1DDA, 0x1DD8, 0x1DD9, 0x0713, 0x1DD7, 0x1DDB, 0x1DDC, 0x05C6, 0x1DDD, 0x1DDE, 0x0B22, 0x1DDF,
+    0x07A6, 0x1DE2, 0x1DE1, 0x1DE0, 0x1C11, 0x0F9A, 0x1DE3, 0x1DE4, 0x1DE5, 0x1DE6, 0x1DE7, 0x1DE8, 0x0758, 0x1DE9, 0x1DEA, 0x0E42,
+    0x1DEC, 0x0679, 0x1DEF, 0x1DEE, 0x0603, 0x07FF, 0x0F85, 0x0D38, 0x0960, 0x0940, 0x0AC7, 0x0B7B, 0x1DF1, 0x1DF0, 0x10A1, 0x0766,
+    0x0ED0, 0x0E1A, 0x0B9C, 0x110C, 0x087A, 0x1DF4, 0x1DF3, 0x0FEA, 0x0DEA, 0x062F, 0x1DF5, 0x1DF2, 0x0F30, 0x10CA, 0x1DF6, 0x1DF7,
+    0x1DF9, 0x0CA8, 0x06FA, 0x06FB, 0x1DF8, 0x0767, 0x08B0, 0x0768, 0x0D9E, 0x111E, 0x08DA, 0x1DFA, 0x1DFB, 0x1DFC, 0x1E00, 0x1E02,
+    0x1E01, 0x0F57, 0x1E03, 0x1E04, 0x1E05, 0x1E06, 0x1E08, 0x1E07, 0x1E09, 0x0EF2, 0x1A0A, 0x0B48, 0x0791, 0x1E0A, 0x1E0B, 0x126A,
+    0x169A, 0x0ED1, 0x05F9, 0x05B9, 0x0A14, 0x0FCF, 0x0B3C, 0x1E0C, 0x105D, 0x1E0D, 0x10BB, 0x0621, 0x09E0, 0x1E0E, 0x06AC, 0x1E0F,
+    0x1E10, 0x1E12, 0x1E13, 0x1E15, 0x1E11, 0x1E14, 0x0759, 0x1E16, 0x1E17, 0x1E18, 0x1E19, 0x1E1A, 0x1E1C, 0x1E1B, 0x1E1E, 0x1E21,
+    0x1E1D, 0x1E1F, 0x1E20, 0x1E22, 0x0800, 0x0A71, 0x1E23, 0x1E24, 0x0941, 0x1E25, 0x06DD, 0x0E6E, 0x1E26, 0x1E27, 0x0CF9, 0x0E29,
+    0x1E28, 0x0E9D, 0x0C8A, 0x0637, 0x082C, 0x082D, 0x0D13, 0x1E2D, 0x082E, 0x06AD, 0x1E2C, 0x1E2A, 0x1E2B, 0x1E29, 0x1E37, 0x1E2E,
+    0x1E2F, 0x1E30, 0x1E31, 0x1E33, 0x1E32, 0x0AB8, 0x1E34, 0x1E36, 0x0792, 0x1E35, 0x0C5B, 0x08B1, 0x1E38, 0x0C8B, 0x1E39, 0x0DEB,
+    0x1E3A, 0x1E40, 0x1E3D, 0x1E3C, 0x1E3E, 0x1E3B, 0x1E42, 0x1E41, 0x1E44, 0x0801, 0x1E43, 0x1E45, 0x1E46, 0x1E48, 0x1E47, 0x1E49,
+    0x1E4B, 0x1E4A, 0x095C, 0x1E4C, 0x1E4D, 0x06DB, 0x1E4E, 0x1E4F, 0x0B91, 0x1E50, 0x1E51, 0x1E52, 0x1E53, 0x0942, 0x1E54, 0x1E55,
+    0x1E56, 0x1E57, 0x1E58, 0x0EAF, 0x1E5A, 0x0F05, 0x1E5B, 0x1E59, 0x1E5D, 0x1E5C, 0x1E5E, 0x1E5F, 0x1E60, 0x1E61, 0x1E62, 0x1E63,
+    0x1E64, 0x1E65, 0x1E66, 0x1E67, 0x1E68, 0x1E69, 0x1E6A, 0x1E6B, 0x1E6C, 0x1694, 0x1E6D, 0x1976, 0x0793, 0x06C0, 0x0970, 0x1E6F,
+    0x1E6E, 0x1023, 0x1E71, 0x1E72, 0x1E70, 0x1E73, 0x1002, 0x1E74, 0x07DB, 0x1144, 0x1E75, 0x1E77, 0x05BC, 0x1E78, 0x0F69, 0x1E76,
+    0x1E79, 0x1E7A, 0x1E7B, 0x1E7C, 0x1E7D, 0x100E, 0x09CC, 0x09B8, 0x0C0E, 0x1E7E, 0x1E81, 0x1E7F, 0x1E82, 0x08EF, 0x1E80, 0x1E83,
+    0x1E84, 0x1E85, 0x1E89, 0x09C9, 0x0CA2, 0x1E8A, 0x1E87, 0x1E86, 0x1E88, 0x087E, 0x1E8E, 0x1E8D, 0x1E8C, 0x05B1, 0x1E98, 0x1E94,
+    0x1E95, 0x1E91, 0x1E97, 0x1E93, 0x0702, 0x116B, 0x1E96, 0x1E92, 0x1E90, 0x1E8F, 0x1E9A, 0x1E9D, 0x1E9C, 0x1E9B, 0x0F28, 0x1E99,
+    0x05F1, 0x1E9E, 0x1EA0, 0x070F, 0x1E8B, 0x0616, 0x1EA2, 0x1EA1, 0x1E9F, 0x0CCC, 0x1010, 0x1118, 0x1EA3, 0x1EA4, 0x1EA5, 0x1EA6,
+    0x1EA7, 0x0D39, 0x1EA8, 0x0EB5, 0x1EAD, 0x1EA9, 0x1EAA, 0x0FD0, 0x1042, 0x0E0E, 0x1EAE, 0x1EAF, 0x0DFC, 0x1EAC, 0x1EAB, 0x0668,
+    0x1EB7, 0x1EB6, 0x0655, 0x1EB4, 0x1EB3, 0x1EB1, 0x071B, 0x1EB0, 0x0A30, 0x0667, 0x0943, 0x1EBA, 0x1EB9, 0x1EB8, 0x1EB5, 0x1EBB,
+    0x1EBC, 0x1EC4, 0x1EC3, 0x1EC5, 0x060C, 0x1EC0, 0x1EC1, 0x0954, 0x1037, 0x1EC2, 0x0FD1, 0x1ECA, 0x1EC6, 0x1ECB, 0x1EC8, 0x1EC7,
+    0x087B, 0x1ECC, 0x1ECD, 0x1ECE, 0x1EC9, 0x1EB2, 0x1ECF, 0x0D5F, 0x1ED3, 0x1ED4, 0x1ED2, 0x1ED1, 0x1ED7, 0x1ED0, 0x1ED5, 0x1ED6,
+    0x1ED9, 0x1ED8, 0x1EDB, 0x1EDC, 0x1EDD, 0x1168, 0x1EDA, 0x0CA9, 0x09AB, 0x1EDE, 0x1EDF, 0x1EE0, 0x1EE1, 0x1EE2, 0x08B2, 0x1EE3,
+    0x1EE4, 0x0A2D, 0x1EE5, 0x1EE6, 0x1EE7, 0x1EE8, 0x1EEB, 0x1EE9, 0x115B, 0x1EEA, 0x112D, 0x1EEC, 0x1119, 0x1EED, 0x0E9E, 0x1EEE,
+    0x1EF0, 0x1EF1, 0x1EEF, 0x094D, 0x104B, 0x1003, 0x1435, 0x16C0, 0x101B, 0x0669, 0x1EF3, 0x07AF, 0x1EF4, 0x1EF5, 0x1EF6, 0x0955,
+    0x1EF7, 0x17D2, 0x1059, 0x0CA1, 0x1EF8, 0x1EFA, 0x1EF9, 0x1EFB, 0x1EFC, 0x1EFD, 0x1EFE, 0x1F00, 0x1F01, 0x1F02, 0x1F03, 0x1F04,
+    0x1F05, 0x1F06, 0x1F07, 0x1F08, 0x0D83, 0x08DB, 0x1F0A, 0x0C2C, 0x1F0B, 0x1F0C, 0x0F00, 0x1F0D, 0x1F0E, 0x18D6, 0x1C58, 0x1DEB,
+    0x1F0F, 0x1F10, 0x1F12, 0x1F13, 0x1F14, 0x112E, 0x1F11, 0x1F15, 0x1F16, 0x1F18, 0x1F17, 0x1F1A, 0x1F1B, 0x1F19, 0x10F4, 0x1F1C,
+    0x1F1D, 0x18F3, 0x1F1E, 0x0009, 0x0054, 0x0050, 0x0053, 0x0055, 0x0029, 0x002A, 0x0056, 0x003B, 0x0003, 0x0004, 0x001E, 0x00CF,
+    0x00D0, 0x00D1, 0x00D2, 0x00D3, 0x00D4, 0x00D5, 0x00D6, 0x00D7, 0x00D8, 0x0006, 0x0007, 0x0043, 0x0041, 0x0044, 0x0008, 0x0057,
+    0x00E0, 0x00E1, 0x00E2, 0x00E3, 0x00E4, 0x00E5, 0x00E6, 0x00E7, 0x00E8, 0x00E9, 0x00EA, 0x00EB, 0x00EC, 0x00ED, 0x00EE, 0x00EF,
+    0x00F0, 0x00F1, 0x00F2, 0x00F3, 0x00F4, 0x00F5, 0x00F6, 0x00F7, 0x00F8, 0x00F9, 0x002D, 0x001F, 0x002E, 0x000F, 0x0011, 0x000D,
+    0x0101, 0x0102, 0x0103, 0x0104, 0x0105, 0x0106, 0x0107, 0x0108, 0x0109, 0x010A, 0x010B, 0x010C, 0x010D, 0x010E, 0x010F, 0x0110,
+    0x0111, 0x0112, 0x0113, 0x0114, 0x0115, 0x0116, 0x0117, 0x0118, 0x0119, 0x011A, 0x002F, 0x0022, 0x0030, 0x0010, 0x004F
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn static int lit_kanji_utf8(const unsigned char *octets, int nb, int *valeur)
+/// \brief lit un caractere UTF-8 (2 ou 3 octets) et donne sa valeur sur 13 bits s'il fait partie du mode kanji
+/// \param[in]  octets : le premier octet du caractere
+/// \param[in]  nb : nombre d'octets disponibles
+/// \param[out] valeur : valeur du caractere (0 a 0x1FFF)
+/// \return nombre d'octets du caractere, 0 si ce n'est pas un caractere du mode kanji (ou UTF-8 invalide)
+static int lit_kanji_utf8(const unsigned char *octets, int nb, int *valeur)
+{
+    uint32_t unicode, presence, bit;
+    unsigned char page;
+    int lg;
+
+    if(nb >= 2 && octets[0] >= 0xC2 && octets[0] <= 0xDF && (octets[1] & 0xC0) == 0x80)
+    {
+        unicode = ((uint32_t)(octets[0] & 0x1F) << 6) | (octets[1] & 0x3F);
+        lg = 2;
+    }
+    else if(nb >= 3 && (octets[0] & 0xF0) == 0xE0 && (octets[1] & 0xC0) == 0x80 && (octets[2] & 0xC0) == 0x80)
+    {
+        unicode = ((uint32_t)(octets[0] & 0x0F) << 12) | ((uint32_t)(octets[1] & 0x3F) << 6) | (octets[2] & 0x3F);
+        lg = (unicode >= 0x800) ? 3 : 0;                // forme trop longue refusée
+    }
+    else
+    {
+        return 0;
+    }
+    page = page_kanji[unicode >> 8];
+    if(lg == 0 || page == 0xFF)
+    {
+        return 0;
+    }
+    presence = presence_kanji[8*page + ((unicode >> 5) & 7)];
+    bit = (uint32_t)1 << (unicode & 31);
+    if(!(presence & bit))
+    {
+        return 0;
+    }
+    *valeur = valeur_kanji[rang_kanji[8*page + ((unicode >> 5) & 7)] + __builtin_popcount(presence & (bit - 1))];
+    return lg;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn int kanji_to_flux(const unsigned char *data_string, int longueur, QRflux_t *flux, unsigned short int version)
+/// \brief Sujets 3 (complement) : encode une chaine UTF-8 de caracteres kanji (Shift-JIS a 2 octets), 13 bits par caractere
+/// \param[in] data_string : caracteres a encoder, en UTF-8
+/// \param[in] longueur : nombre d'octets de la chaine
+/// \param[in,out] flux : le flux
+/// \param[in] version : parmi M3_L ... M4_Q
+/// \return nombre de bits ecrits, -1 si mode/version incompatibles, chaine invalide ou trop longue
+int kanji_to_flux(const unsigned char *data_string, int longueur, QRflux_t *flux, unsigned short int version)
+{
+    int valeurs[LONGUEUR_KANJI_MAX];
+    int nb_bits, taille_entete, nb, k, lg;
+
+    // un caractere fait au plus 3 octets : une chaine plus longue ne peut pas tenir
+    taille_entete = taille_entete_flux(version, KANJI);
+    if(taille_entete < 0 || longueur < 0 || longueur > 3*LONGUEUR_KANJI_MAX)
+    {
+        return -1;
+    }
+    for(k=0, nb=0; k<longueur; k+=lg, nb++)
+    {
+        lg = (nb < LONGUEUR_KANJI_MAX) ? lit_kanji_utf8(data_string + k, longueur - k, &valeurs[nb]) : 0;
+        if(lg == 0)
+        {
+            return -1;
+        }
+    }
+    nb_bits = taille_entete + 13*nb;
+    if(flux->nb_bits + nb_bits > nb_bits_donnees[version & 7])
+    {
+        return -1;
+    }
+
+    if(ecrit_entete_flux(flux, version, KANJI, nb) < 0)
+    {
+        return -1;
+    }
+    for(k=0; k+2<=nb; k+=2)                             // 2 caracteres (26 bits) par ecriture
+    {
+        ecrit_bits_flux(flux, ((uint32_t)valeurs[k] << 13) | valeurs[k+1], 26);
+    }
+    if(k < nb)
+    {
+        ecrit_bits_flux(flux, valeurs[k], 13);
+    }
+    return nb_bits;
+}
+
+// ////////////////////////////////////////////////////////////////////
+/// \fn int data_string_to_packedbyteDS(const unsigned char *data_string, int longueur, unsigned char packedbyteDS[24], unsigned short int version, unsigned short int mode)
+/// \brief Sujets 3 (complement) : comme data_string_to_binaryDS, mais produit directement les octets de données
+///        terminés et bourrés (prets pour ajoute_correction_packedbyteDS)
+/// \param[in]  data_string : chaine a encoder
+/// \param[in]  longueur : nombre de caracteres (octets) de la chaine
+/// \param[out] packedbyteDS[24] : octets de données
+/// \param[in]  version : parmi M1_, M2_L ... M4_Q
+/// \param[in]  mode : parmi NUMERIC, ALPHANUM, ASCII, KANJI, ou MODE_AUTO (découpage en segments, voir mixte_to_flux)
+/// \return -1 si incompatibilité entre le mode et la version (ou capacité dépassée), nb de bits de données si non
+int data_string_to_packedbyteDS(const unsigned char *data_string, int longueur,
+                                unsigned char packedbyteDS[24],
+                                unsigned short int version,
+                                unsigned short int mode )
+{
+    QRflux_t flux;
+    int nb_bits;
+
+    demarre_flux(&flux, packedbyteDS);
+    switch(mode)
+    {
+    case NUMERIC :
+        nb_bits = numeric_to_flux(data_string, longueur, &flux, version);
+        break;
+    case ALPHANUM :
+        nb_bits = alphanum_to_flux(data_string, longueur, &flux, version);
+        break;
+    case ASCII :
+        nb_bits = ascii_to_flux(data_string, longueur, &flux, version);
+        break;
+    case KANJI :
+        nb_bits = kanji_to_flux(data_string, longueur, &flux, version);
+        break;
+    case MODE_AUTO :
+        nb_bits = mixte_to_flux(data_string, longueur, &flux, version, MODE_AUTO);
+        break;
+    default :
+        nb_bits = -1;
+        break;
+    }
+    if(nb_bits < 0)
+    {
+        return -1;
+    }
+    return termine_flux(&flux, version);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Découpage d'une chaine en segments de modes différents (ISO18004/2015 §7.4.2 et annexe J)
+// les positions sont des positions d'octets : un segment kanji commence et finit entre 2 caracteres UTF-8.
+// "AB-123456789" en M3 : 12 caracteres alphanum (6+66 = 72 bits) ou "AB-" alphanum + 9 chiffres (6+17 + 7+30 = 60 bits).
+// programmation dynamique sur les fins de segment : cout[j] = nombre minimal de bits pour les j premiers octets,
+// le dernier segment [i, j[ étant encodé dans un seul mode. la longueur exacte d'un segment (groupes incomplets
+// compris) ne dépend que de son mode et de sa longueur : le minimum est exact, pas une estimation.
+// la taille des entetes dépend de la largeur M1..M4 : le découpage est refait pour chaque largeur.
+
+#define NB_SEGMENTS_MAX  LONGUEUR_NUMERIC_MAX  /** au plus un segment par caractere */
+
+// un découpage : segment n° k = caracteres [debut[k], debut[k+1][ dans le mode mode[k]
+typedef struct
+{
+    int nb_segments;
+    unsigned char debut[NB_SEGMENTS_MAX + 1];
+    unsigned short int mode[NB_SEGMENTS_MAX];
+} QRsegments_t;
+
+/// modes essayés pour chaque segment
+static const unsigned short int modes_segment[4] = { NUMERIC, ALPHANUM, ASCII, KANJI };
+
+/// niveau de correction de chaque version M1_ ... M4_Q
+static const unsigned char niveau_correction[8] = { NIVEAU_DETECTION, NIVEAU_L, NIVEAU_M, NIVEAU_L, NIVEAU_M, NIVEAU_L, NIVEAU_M, NIVEAU_Q };
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn static int nb_bits_segment(unsigned short int mode, int longueur)
+/// \brief nombre de bits de données (sans entete) d'un segment de longueur caracteres (kanji : caracteres et non octets)
+static int nb_bits_segment(unsigned short int mode, int longueur)
+{
+    switch(mode)
+    {
+    case NUMERIC :
+        return 10*(longueur/3) + nb_bits_reste_numeric[longueur%3];
+    case ALPHANUM :
+        return 11*(longueur/2) + 6*(longueur & 1);
+    case KANJI :
+        return 13*longueur;
+    default :
+        return 8*longueur;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn static int segmente_donnees(const unsigned char *data_string, int longueur, unsigned short int version, unsigned short int modes, QRsegments_t *segments)
+/// \brief découpage de la chaine qui donne le flux le plus court dans la version choisie
+/// \param[in]  data_string : chaine a encoder
+/// \param[in]  longueur : nombre d'octets de la chaine
+/// \param[in]  version : parmi M1_ ... M4_Q (seule la largeur compte)
+/// \param[in]  modes : modes autorisés (NUMERIC | ALPHANUM ... ou MODE_AUTO)
+/// \param[out] segments : le découpage (NULL si inutile)
+/// \return nombre de bits du flux (non terminé), -1 si la chaine ne peut pas etre encodée avec ces modes
+static int segmente_donnees(const unsigned char *data_string, int longueur, unsigned short int version,
+                            unsigned short int modes, QRsegments_t *segments)
+{
+    int cout[LONGUEUR_NUMERIC_MAX + 1];             // cout[j] : nb minimal de bits des j premiers octets
+    unsigned char debut[LONGUEUR_NUMERIC_MAX + 1];  // début du dernier segment de ce minimum
+    unsigned char mode[LONGUEUR_NUMERIC_MAX + 1];   // et son mode (indice dans modes_segment)
+    unsigned char avant[4][LONGUEUR_NUMERIC_MAX + 1]; // avant[m][j] : nb d'octets du caractere qui finit en j s'il est encodable dans le mode m, 0 si non
+    int taille = TAILLE_VERSION(version & 7);
+    int entete, nb_max, nb_car, nb_bits, valeur, i, j, m, k;
+    unsigned short int mode_m;
+
+    if(longueur < 0 || longueur > LONGUEUR_NUMERIC_MAX)      // rien de plus long ne tient dans un M4
+    {
+        return -1;
+    }
+    memset(avant, 0, sizeof(avant));
+    for(i=0; i<longueur; i++)
+    {
+        avant[0][i+1] = ((unsigned char)(data_string[i] - '0') <= 9);
+        avant[1][i+1] = (valeur_alphanum[data_string[i]] != 0xFF);
+        avant[2][i+1] = 1;
+        k = lit_kanji_utf8(data_string + i, longueur - i, &valeur);
+        if(k > 0)
+        {
+            avant[3][i+k] = (unsigned char)k;
+        }
+    }
+    cout[0] = 0;
+    for(j=1; j<=longueur; j++)
+    {
+        cout[j] = -1;
+        for(m=0; m<4; m++)
+        {
+            mode_m = modes_segment[m];
+            entete = taille_entete_flux(version, mode_m);
+            if(!(modes & mode_m) || entete < 0)
+            {
+                continue;
+            }
+            nb_max = (1 << nb_bits_compteur[INDICE_MODE(mode_m)][taille]) - 1;
+            // segments [i, j[ de plus en plus longs, un caractere de plus a chaque tour, tant qu'il est encodable dans ce mode
+            for(i=j, nb_car=1; nb_car<=nb_max && avant[m][i]>0; nb_car++)
+            {
+                i -= avant[m][i];
+                if(cout[i] < 0)
+                {
+                    continue;
+                }
+                nb_bits = cout[i] + entete + nb_bits_segment(mode_m, nb_car);
+                if(cout[j] < 0 || nb_bits < cout[j])
+                {
+                    cout[j]  = nb_bits;
+                    debut[j] = (unsigned char)i;
+                    mode[j]  = (unsigned char)m;
+                }
+            }
+        }
+    }
+    if(cout[longueur] < 0)
+    {
+        return -1;
+    }
+    if(segments != NULL)
+    {
+        // les segments sont retrouvés de la fin vers le début
+        k = 0;
+        for(j=longueur; j>0; j=debut[j])
+        {
+            k++;
+        }
+        segments->nb_segments = k;
+        segments->debut[k] = (unsigned char)longueur;
+        for(j=longueur; j>0; j=debut[j])
+        {
+            k--;
+            segments->debut[k] = debut[j];
+            segments->mode[k]  = modes_segment[mode[j]];
+        }
+    }
+    return cout[longueur];
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn int mixte_to_flux(const unsigned char *data_string, int longueur, QRflux_t *flux, unsigned short int version, unsigned short int modes)
+/// \brief Sujets 3 (complement) : encode la chaine en une suite de segments (numerique, alphanum, octets, kanji)
+///        dont le découpage donne le flux le plus court pour cette version
+/// \param[in] data_string : chaine a encoder
+/// \param[in] longueur : nombre d'octets de la chaine
+/// \param[in,out] flux : le flux
+/// \param[in] version : parmi M1_ ... M4_Q
+/// \param[in] modes : modes autorisés (MODE_AUTO pour tous)
+/// \return nombre de bits ecrits, -1 si la chaine ne peut pas etre encodée dans cette version
+int mixte_to_flux(const unsigned char *data_string, int longueur, QRflux_t *flux, unsigned short int version, unsigned short int modes)
+{
+    QRsegments_t segments;
+    int nb_bits, k, debut, nb;
+
+    // capacité vérifiée avant d'ecrire dans le flux
+    nb_bits = segmente_donnees(data_string, longueur, version, modes, &segments);
+    if(nb_bits < 0 || flux->nb_bits + nb_bits > nb_bits_donnees[version & 7])
+    {
+        return -1;
+    }
+    for(k=0; k<segments.nb_segments; k++)
+    {
+        debut = segments.debut[k];
+        nb = segments.debut[k+1] - debut;
+        switch(segments.mode[k])
+        {
+        case NUMERIC :
+            numeric_to_flux(data_string + debut, nb, flux, version);
+            break;
+        case ALPHANUM :
+            alphanum_to_flux(data_string + debut, nb, flux, version);
+            break;
+        case KANJI :
+            kanji_to_flux(data_string + debut, nb, flux, version);
+            break;
+        default :
+            ascii_to_flux(data_string + debut, nb, flux, version);
+            break;
+        }
+    }
+    return nb_bits;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+/// \fn int choisit_version_QRcode(const unsigned char *data_string, int longueur, unsigned short int mode, int niveau_min)
+/// \brief Sujets 3 (complement) : choisit le plus petit microQRcode qui contient la chaine (table nb_bits_donnees),
+///        et a cette taille le niveau de correction le plus élevé qui convient
+/// \param[in] data_string : chaine a encoder
+/// \param[in] longueur : nombre d'octets de la chaine
+/// \param[in] mode : parmi NUMERIC, ALPHANUM, ASCII, KANJI, ou MODE_AUTO
+/// \param[in] niveau_min : niveau de correction minimal, parmi NIVEAU_DETECTION, NIVEAU_L, NIVEAU_M, NIVEAU_Q
+/// \return la version parmi M1_ ... M4_Q, -1 si la chaine ne tient dans aucune
+int choisit_version_QRcode(const unsigned char *data_string, int longueur, unsigned short int mode, int niveau_min)
+{
+    int nb_bits[4];                 // longueur du flux selon la largeur M1..M4 (un découpage par largeur)
+    int choix = -1, taille_choix = 4;
+    unsigned short int version;
+
+    for(version=M1_; version<=M4_Q && TAILLE_VERSION(version)<=taille_choix; version++)
+    {
+        if(version == M1_ || TAILLE_VERSION(version) != TAILLE_VERSION(version-1))
+        {
+            nb_bits[TAILLE_VERSION(version)] = segmente_donnees(data_string, longueur, version, mode, NULL);
+        }
+        if(niveau_correction[version] >= niveau_min && nb_bits[TAILLE_VERSION(version)] >= 0 &&
+           nb_bits[TAILLE_VERSION(version)] <= nb_bits_donnees[version])
+        {
+            choix = version;                // les versions suivantes de meme taille corrigent mieux
+            taille_choix = TAILLE_VERSION(version);
+        }
+    }
+    return choix;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Tables de placement des bits
+// pour chaque version, table_placement[version][k] donne la position (ligne*NB_MODULE_MAX + colonne)
+// du module qui recoit le bit k du flux (k = 8*n° d'octet + n° du bit, bit7 d'abord).
+// l'ordre suit le zig-zag de la norme (ISO18004/2015 §7.7.3) : colonnes prises 2 par 2 en partant
+// de la droite, en montant puis en descendant, en sautant les modules des patterns et du format.
+// en M1/M3, les 4 bits de poids faible du dernier octet de données (demi-octet) n'existent pas :
+// ils sont envoyés vers un module "poubelle", le dernier du stockage 17x17, hors du QRcode
+
+#define MODULE_POUBELLE  (NB_MODULE_MAX*NB_MODULE_MAX - 1)   /** module hors QRcode pour les bits ignorés en M1/M3 */
+
+static unsigned short int table_placement[8][24*8];   /** bit k du flux -> ligne*NB_MODULE_MAX + colonne */
+static pthread_once_t placement_pret = PTHREAD_ONCE_INIT;   /** tables construites une seule fois, meme avec plusieurs threads */
+
+//////////////////////////////////////////////////////////////////////
+/// \fn static void construit_placement(void)
+/// \brief Sujet 4 (complement) : construit une fois pour toutes les tables de placement des 8 versions
+///        (appelée par pthread_once depuis ajoute_data_QRcode : aucun thread ne lit une table en construction)
+static void construit_placement(void)
+{
+    unsigned short int zigzag[NB_MODULE_MAX*NB_MODULE_MAX];   // modules de données dans l'ordre du zig-zag
+    int version, n, nb, col, c, pas, i, j, k, index, octet_demi;
+
+    for(version=M1_; version<=M4_Q; version++)
+    {
+        n  = nb_module_version(version);
+        nb = 0;
+        pas = -1;                                          // on commence en montant
+        for(col=n-1; col>=1; col-=2)                       // la colonne 0 (timing) n'a pas de données
+        {
+            for(k=0; k<n; k++)
+            {
+                i = (pas < 0) ? n-1-k : k;
+                for(c=0; c<2; c++)                         // colonne de droite puis de gauche
+                {
+                    j = col - c;
+                    if(ZONE_DONNEES(n,i,j))
+                    {
+                        zigzag[nb++] = i*NB_MODULE_MAX + j;
+                    }
+                }
+            }
+            pas = -pas;
+        }
+
+        // demi-octet en M1 et M3 : dernier octet de données
+        octet_demi = (nb_bits_donnees[version] & 7) ? nb_octets_donnees[version]-1 : -1;
+        index = 0;
+        for(k=0; k<(nb_octets_donnees[version]+nb_octets_correction[version])*8; k++)
+        {
+            if((k/8 == octet_demi) && (k%8 >= 4))
+            {
+                table_placement[version][k] = MODULE_POUBELLE;
+            }
+            else
+            {
+                table_placement[version][k] = zigzag[index++];
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn void ajoute_data_QRcode(const unsigned char packedbyteDS[24],QRcode_t *qrcode)
+/// \brief Sujet 4 (complement, toutes versions M1 a M4) : ajoute les données et la correction (packed) dans le qrcode
+///        une seule boucle, sans branchement, qui disperse les bits du flux selon table_placement
+/// \param[in]     packedbyteDS[] : octets de données suivis des octets de correction (voir ajoute_correction_packedbyteDS)
+/// \param[in,out] qrcode : le qrcode (sa version doit etre fixée)
+void ajoute_data_QRcode(const unsigned char packedbyteDS[24],QRcode_t *qrcode)
+{
+    int k, nb_bits;
+    const unsigned short int *placement;
+    unsigned char *modules = &qrcode->module[0][0];
+
+    pthread_once(&placement_pret, construit_placement);
+    placement = table_placement[qrcode->version & 7];
+    nb_bits   = (nb_octets_donnees[qrcode->version & 7] + nb_octets_correction[qrcode->version & 7]) * 8;
+    for(k=0; k<nb_bits; k++)
+    {
+        // bit a 1 : 1-1 = 0 = NOIR, bit a 0 : 0-1 = 255 = BLANC
+        modules[placement[k]] = (unsigned char)(((packedbyteDS[k >> 3] >> (7 - (k & 7))) & 1) - 1);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn void ajoute_dataM1_QRcode(const unsigned char packedbyteDS[24],QRcode_t *qrcode)
+/// \brief Sujet 4 version M1 : Ajoute les données (packed) dans un microQRcode M1
 /// \param[in]     packedbyteDS[] : le tableau du flux binaire a ecrire compacté en octets (seuls les 5 premiers sont ecrits
-/// \param[in,out] qrcode[][]  : le qrcode
-void ajoute_dataM1_QRcode(const unsigned char packedbyteDS[24],unsigned char qrcode[NB_MODULE][NB_MODULE])
+/// \param[in,out] qrcode  : le qrcode
+void ajoute_dataM1_QRcode(const unsigned char packedbyteDS[24],QRcode_t *qrcode)
+{
+    ajoute_data_QRcode(packedbyteDS, qrcode);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn void ajoute_dataM2_QRcode(const unsigned char packedbyteDS[24],QRcode_t *qrcode)
+/// \brief Sujet 4 version M2 : Ajoute les données (packed) dans un microQRcode M2
+/// \param[in]     packedbyteDS[] : le tableau du flux binaire a ecrire compacté en octets (seuls les 10 premiers sont ecrits
+/// \param[in,out] qrcode  : le qrcode
+
+void ajoute_dataM2_QRcode(const unsigned char packedbyteDS[24],QRcode_t *qrcode)
+{
+    ajoute_data_QRcode(packedbyteDS, qrcode);
+}
+//////////////////////////////////////////////////////////////////////
+/// \fn void ajoute_dataM3L_QRcode(const unsigned char packedbyteDS[24],QRcode_t *qrcode)
+/// \brief HORS SUJET  M3L : Ajoute les données (packed)  dans un microQRcode M3L
+/// \param[in]      packedbyteDS[] : le tableau du flux binaire a ecrire compacté en octets (seuls les 17 premiers sont ecrits
+/// \param[in,out]  qrcode  : le qrcode
+
+void ajoute_dataM3L_QRcode(const unsigned char packedbyteDS[24],QRcode_t *qrcode)
+{
+    ajoute_data_QRcode(packedbyteDS, qrcode);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn void ajoute_dataM3M_QRcode(const unsigned char packedbyteDS[24],QRcode_t *qrcode)
+/// \brief HORS SUJET  M3M : ajoute les données (packed) dans un microQRcode M3M
+/// \param[in]     packedbyteDS[] : le tableau du flux binaire a ecrire compacté en octets (seuls les 17 premiers sont ecrits
+/// \param[in,out] qrcode  : le qrcode !
+
+void ajoute_dataM3M_QRcode(const unsigned char packedbyteDS[24],QRcode_t *qrcode)
+{
+    ajoute_data_QRcode(packedbyteDS, qrcode);
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn void ajoute_dataM4_QRcode(const unsigned char packedbyteDS[24],QRcode_t *qrcode)
+/// \brief Sujet 4 (version M4) : Ajoute les données (packed) dans un microQRcode M4
+/// \param[in]     packedbyteDS[] : le tableau du flux binaire a ecrire compacté en octets
+/// \param[in,out] qrcode : le qrcode
+
+void ajoute_dataM4_QRcode(const unsigned char packedbyteDS[24],QRcode_t *qrcode)
+{
+    ajoute_data_QRcode(packedbyteDS, qrcode);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+/// \fn void put_byte_in_blocks(QRcode_t *qrcode,unsigned char byte,
+///                        unsigned char lig, unsigned char col, unsigned char direction)
+/// \brief Sujets 4 (commun a toutes les versions M1/M2/M3/M4 : Ecriture d'un bloc de 8 modules a un emplacement donné (et pour une direction donnée parmi UP, DN UL,DL, US  )
+/// \param[in,out] qrcode le qrcode
+/// \param[in]    byte : les 8 bits à ecrire
+/// \param[in]    lig :  la ligne ou doit etre placé le bit7
+/// \param[in]   col  ; la colonne ou doit etre placée le bit de poid fort (bit7)
+/// \param[in]    direction : la direction parmi ( UP, DN, UL, DL, et US  pour UP LEFT ou DOWN LEFT, et US pour les blocs spéciaux de 4 bist )
+/// remarque : les fonctions ajoute_dataXX_QRcode n'utilisent plus ces blocs mais les tables de placement (voir ajoute_data_QRcode)
+
+void put_byte_in_blocks(QRcode_t *qrcode,unsigned char byte,
+                        unsigned char lig, unsigned char col, unsigned char direction)
+{
+    // A COMPLETER
+}//
+
+//////////////////////////////////////////////////////////////////////
+/// \fn int encode_QRcode(const unsigned char *data_string, int longueur, unsigned short int version, unsigned short int mode, int no_masque, QRcode_t *qrcode)
+/// \brief Encodage complet d'une chaine : flux de données, correction Reed-Solomon, modele (patterns + format),
+///        placement des bits, choix du masque (ou masque imposé) et mise a jour du format
+/// \param[in]  data_string : chaine a encoder
+/// \param[in]  longueur : nombre d'octets de la chaine
+/// \param[in]  version : parmi M1_ ... M4_Q, ou VERSION_AUTO | niveau minimal (voir choisit_version_QRcode)
+/// \param[in]  mode : parmi NUMERIC, ALPHANUM, ASCII, KANJI, ou MODE_AUTO
+/// \param[in]  no_masque : MASQUE_AUTO ou n° de masque imposé (0 a 3)
+/// \param[out] qrcode : le qrcode complet (effacé en cas d'erreur)
+/// \return le n° du masque appliqué, -1 si la chaine ne peut pas etre encodée dans cette version/mode
+int encode_QRcode(const unsigned char *data_string, int longueur,
+                  unsigned short int version, unsigned short int mode,
+                  int no_masque, QRcode_t *qrcode)
+{
+    unsigned char packedbyteDS[24];
+    int choix;
+
+    if(version & VERSION_AUTO)
+    {
+        choix = choisit_version_QRcode(data_string, longueur, mode, version & 3);
+        version = (choix < 0) ? M4_Q : choix;
+    }
+    version &= 7;
+    if(data_string_to_packedbyteDS(data_string, longueur, packedbyteDS, version, mode) < 0)
+    {
+        cree_QRcode(qrcode, version);
+        return -1;
+    }
+    ajoute_correction_packedbyteDS(packedbyteDS, version);
+    demarre_QRcode(qrcode, version, (no_masque == MASQUE_AUTO) ? 0 : no_masque);
+    ajoute_data_QRcode(packedbyteDS, qrcode);
+    if(no_masque == MASQUE_AUTO)
+    {
+        no_masque = choisit_masque_QRcode(qrcode, MASQUE_AUTO);
+        ajoute_version_QRcode(qrcode, encode_version(version, no_masque));   // le modele portait le masque 0
+    }
+    else
+    {
+        no_masque = choisit_masque_QRcode(qrcode, no_masque);
+    }
+    return no_masque;
+}
+
+//////////////////////////////////////////////////////////////////////
+// Pool de threads avec vol de travail
+// les nb elements sont répartis en intervalles contigus, un par thread. chaque thread consomme son
+// intervalle par le début, par paquets ; quand il est vide, il vole la moitié arriere de l'intervalle
+// d'un autre thread. l'intervalle [debut, fin[ tient dans un seul mot de 64 bits modifié par
+// compare-and-swap : pas de verrou. chaque element est traité exactement une fois, par son index :
+// le résultat ne dépend donc pas de l'ordre d'execution.
+
+#define NB_THREADS_MAX  256          /** nombre maximal de threads du pool */
+
+typedef struct
+{
+    _Atomic uint64_t intervalle;     /** (debut << 32) | fin des elements restant a traiter */
+    char alignement[64 - sizeof(uint64_t)];   /** un intervalle par ligne de cache */
+} QRintervalle_t;
+
+typedef struct
+{
+    QRintervalle_t *intervalles;     /** un intervalle par thread */
+    int nb_threads;
+    int paquet;                      /** nombre d'elements pris a la fois */
+    QRtache_t tache;
+    void *contexte;
+} QRpool_t;
+
+typedef struct
+{
+    QRpool_t *pool;
+    int no_thread;
+} QRouvrier_t;
+
+//////////////////////////////////////////////////////////////////////
+/// \fn int nb_coeurs(void)
+/// \brief nombre de coeurs (processeurs logiques) disponibles sur la machine
+int nb_coeurs(void)
+{
+    long nb;
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    nb = info.dwNumberOfProcessors;
+#else
+    nb = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return (nb < 1) ? 1 : (nb > NB_THREADS_MAX) ? NB_THREADS_MAX : (int)nb;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn static int prend_devant(QRintervalle_t *intervalle, int paquet, int *debut, int *fin)
+/// \brief prend un paquet d'elements au début de l'intervalle (utilisé par le thread propriétaire)
+/// \return 1 si des elements ont été pris dans [*debut, *fin[, 0 si l'intervalle est vide
+static int prend_devant(QRintervalle_t *intervalle, int paquet, int *debut, int *fin)
+{
+    uint64_t valeur = atomic_load(&intervalle->intervalle);
+    uint32_t d, f, nd;
+    do
+    {
+        d = (uint32_t)(valeur >> 32);
+        f = (uint32_t)valeur;
+        if(d >= f)
+        {
+            return 0;
+        }
+        nd = (f - d > (uint32_t)paquet) ? d + paquet : f;
+    }
+    while(!atomic_compare_exchange_weak(&intervalle->intervalle, &valeur, ((uint64_t)nd << 32) | f));
+    *debut = d;
+    *fin   = nd;
+    return 1;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn static int vole_derriere(QRintervalle_t *intervalle, int *debut, int *fin)
+/// \brief vole la moitié arriere de l'intervalle d'un autre thread
+/// \return 1 si des elements ont été volés dans [*debut, *fin[, 0 si l'intervalle est vide
+static int vole_derriere(QRintervalle_t *intervalle, int *debut, int *fin)
+{
+    uint64_t valeur = atomic_load(&intervalle->intervalle);
+    uint32_t d, f, nf;
+    do
+    {
+        d = (uint32_t)(valeur >> 32);
+        f = (uint32_t)valeur;
+        if(d >= f)
+        {
+            return 0;
+        }
+        nf = f - (f - d + 1) / 2;
+    }
+    while(!atomic_compare_exchange_weak(&intervalle->intervalle, &valeur, ((uint64_t)d << 32) | nf));
+    *debut = nf;
+    *fin   = f;
+    return 1;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn static void *ouvrier(void *argument)
+/// \brief boucle d'un thread du pool : son intervalle, puis vol chez les autres jusqu'a ce que tout soit traité
+static void *ouvrier(void *argument)
+{
+    QRouvrier_t *ouvrier = (QRouvrier_t *)argument;
+    QRpool_t *pool = ouvrier->pool;
+    QRintervalle_t *mien = &pool->intervalles[ouvrier->no_thread];
+    int debut, fin, i, k, victime, vole;
+
+    do
+    {
+        while(prend_devant(mien, pool->paquet, &debut, &fin))
+        {
+            for(i=debut; i<fin; i++)
+            {
+                pool->tache(i, pool->contexte);
+            }
+        }
+        // plus rien chez moi : on vole chez les autres, en commencant par le voisin
+        vole = 0;
+        for(k=1; (k<pool->nb_threads) && !vole; k++)
+        {
+            victime = (ouvrier->no_thread + k) % pool->nb_threads;
+            if(vole_derriere(&pool->intervalles[victime], &debut, &fin))
+            {
+                atomic_store(&mien->intervalle, ((uint64_t)debut << 32) | (uint32_t)fin);
+                vole = 1;
+            }
+        }
+    }
+    while(vole);
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn int parallele_pour(int nb, int nb_threads, QRtache_t tache, void *contexte)
+/// \brief execute tache(i, contexte) pour i de 0 a nb-1 sur un pool de threads avec vol de travail
+///        le thread appelant participe au travail ; retour quand tous les elements sont traités
+/// \param[in] nb : nombre d'elements
+/// \param[in] nb_threads : nombre de threads (0 = un par coeur)
+/// \param[in] tache : fonction a executer pour chaque element
+/// \param[in] contexte : parametre transmis a la tache
+/// \return 0, ou -1 en cas d'erreur d'allocation
+int parallele_pour(int nb, int nb_threads, QRtache_t tache, void *contexte)
+{
+    QRpool_t pool;
+    QRouvrier_t ouvriers[NB_THREADS_MAX];
+    pthread_t threads[NB_THREADS_MAX];
+    int t, nb_lances;
+
+    if(nb <= 0)
+    {
+        return 0;
+    }
+    if(nb_threads <= 0)
+    {
+        nb_threads = nb_coeurs();
+    }
+    if(nb_threads > NB_THREADS_MAX) nb_threads = NB_THREADS_MAX;
+    if(nb_threads > nb)             nb_threads = nb;
+
+    pool.intervalles = malloc(nb_threads * sizeof(QRintervalle_t));
+    if(pool.intervalles == NULL)
+    {
+        return -1;
+    }
+    pool.nb_threads = nb_threads;
+    pool.tache      = tache;
+    pool.contexte   = contexte;
+    pool.paquet     = nb / (nb_threads * 16);            // assez de paquets pour equilibrer, assez gros pour limiter les CAS
+    if(pool.paquet < 1)  pool.paquet = 1;
+    if(pool.paquet > 64) pool.paquet = 64;
+    for(t=0; t<nb_threads; t++)
+    {
+        atomic_init(&pool.intervalles[t].intervalle,
+                    ((uint64_t)((long long)nb * t / nb_threads) << 32) | (uint32_t)((long long)nb * (t+1) / nb_threads));
+        ouvriers[t].pool = &pool;
+        ouvriers[t].no_thread = t;
+    }
+
+    // le thread 0 est le thread appelant
+    nb_lances = 1;
+    for(t=1; t<nb_threads; t++)
+    {
+        if(pthread_create(&threads[t], NULL, ouvrier, &ouvriers[t]) != 0)
+        {
+            break;      // son intervalle sera volé par les autres
+        }
+        nb_lances++;
+    }
+    ouvrier(&ouvriers[0]);
+    for(t=1; t<nb_lances; t++)
+    {
+        pthread_join(threads[t], NULL);
+    }
+    free(pool.intervalles);
+    return 0;
+}
+
+// contexte d'un lot d'encodage
+typedef struct
+{
+    const QRdemande_t *demandes;
+    QRcode_t *qrcodes;
+    int *masques;
+    int no_masque;
+    atomic_int nb_erreurs;
+    void (*rendu)(const QRcode_t *qrcode, int index, void *contexte);
+    void *contexte;
+} QRlot_t;
+
+//////////////////////////////////////////////////////////////////////
+/// \fn static void tache_encode(int index, void *contexte)
+/// \brief tache du pool : encode la demande n° index puis appelle le rendu
+static void tache_encode(int index, void *contexte)
+{
+    QRlot_t *lot = (QRlot_t *)contexte;
+    const QRdemande_t *demande = &lot->demandes[index];
+    int masque;
+
+    masque = encode_QRcode(demande->data_string, demande->longueur, demande->version, demande->mode,
+                           lot->no_masque, &lot->qrcodes[index]);
+    if(lot->masques != NULL)
+    {
+        lot->masques[index] = masque;
+    }
+    if(masque < 0)
+    {
+        atomic_fetch_add(&lot->nb_erreurs, 1);
+    }
+    else if(lot->rendu != NULL)
+    {
+        lot->rendu(&lot->qrcodes[index], index, lot->contexte);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn int encode_lot_QRcode(const QRdemande_t *demandes, int nb, QRcode_t *qrcodes, int *masques, int no_masque, int nb_threads, void (*rendu)(const QRcode_t *, int, void *), void *contexte)
+/// \brief encode un lot de nb demandes en parallele (encodage -> correction -> placement -> masquage -> rendu)
+///        le qrcode de la demande n° i est toujours ecrit dans qrcodes[i] : l'ordre de sortie est déterministe
+/// \param[in]  demandes[nb] : les chaines a encoder avec leur version et leur mode (M1 a M4 mélangés possibles)
+/// \param[in]  nb : nombre de demandes
+/// \param[out] qrcodes[nb] : tableau contigu fourni par l'appelant
+/// \param[out] masques[nb] : n° de masque appliqué ou -1 si erreur (NULL si inutile)
+/// \param[in]  no_masque : MASQUE_AUTO ou n° de masque imposé a tous les qrcodes
+/// \param[in]  nb_threads : nombre de threads (0 = un par coeur)
+/// \param[in]  rendu : fonction appelée par le thread pour chaque qrcode réussi (NULL si inutile)
+/// \param[in]  contexte : parametre transmis a rendu
+/// \return nombre de demandes qui n'ont pas pu etre encodées, -1 en cas d'erreur du pool
+int encode_lot_QRcode(const QRdemande_t *demandes, int nb, QRcode_t *qrcodes, int *masques,
+                      int no_masque, int nb_threads,
+                      void (*rendu)(const QRcode_t *qrcode, int index, void *contexte), void *contexte)
+{
+    QRlot_t lot;
+
+    lot.demandes  = demandes;
+    lot.qrcodes   = qrcodes;
+    lot.masques   = masques;
+    lot.no_masque = no_masque;
+    lot.rendu     = rendu;
+    lot.contexte  = contexte;
+    atomic_init(&lot.nb_erreurs, 0);
+    if(parallele_pour(nb, nb_threads, tache_encode, &lot) < 0)
+    {
+        return -1;
+    }
+    return atomic_load(&lot.nb_erreurs);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Mode flux : double tampon d'entrée/sortie
+// pendant que le programme analyse (ou remplit) un tampon, un thread lit (ou ecrit) l'autre.
+// aucun fichier n'est ouvert par symbole : les images sont écrites directement dans le tampon de sortie.
+// l'entrée est lue par son descripteur (read), qui rend ce qui est déjà disponible sans attendre un tampon plein :
+// quand l'entrée est tarie, les images en attente sont ecrites aussitot (un producteur peut attendre chaque image).
+
+#ifdef _WIN32
+#define LIT_DESCRIPTEUR(fichier, tampon, taille)  _read(_fileno(fichier), (tampon), (unsigned int)(taille))
+#else
+#define LIT_DESCRIPTEUR(fichier, tampon, taille)  read(fileno(fichier), (tampon), (taille))
+#endif
+
+#define TAILLE_TAMPON_FLUX   (1 << 16)   /** taille minimale de chacun des 2 tampons d'entrée et de sortie */
+#define LONGUEUR_DONNEE_MAX  4096        /** longueur maximale d'une donnée (plus longue : erreur)       */
+
+typedef struct
+{
+    FILE *fichier;
+    int lecture;                              /** 1 : tampons d'entrée (read), 0 : tampons de sortie (fwrite)  */
+    unsigned char *tampon[2];
+    size_t taille;                            /** taille de chaque tampon                                      */
+    size_t nb[2];                             /** nombre d'octets utiles de chaque tampon                     */
+    int courant;                              /** tampon analysé ou rempli par le programme                    */
+    int en_transfert;                         /** tampon lu ou ecrit par le thread                             */
+    int thread_actif;
+    pthread_t thread;
+    int erreur;
+} QRtampon_double_t;
+
+//////////////////////////////////////////////////////////////////////
+/// \fn static void *transfert_tampon(void *argument)
+/// \brief thread de lecture ou d'ecriture du tampon en_transfert
+static void *transfert_tampon(void *argument)
+{
+    QRtampon_double_t *t = (QRtampon_double_t *)argument;
+    int k = t->en_transfert;
+    long nb_lus;
+
+    if(t->lecture)
+    {
+        // lecture partielle : ce qui est disponible, 0 en fin de l'entrée
+        do
+        {
+            nb_lus = (long)LIT_DESCRIPTEUR(t->fichier, t->tampon[k], t->taille);
+        }
+        while(nb_lus < 0 && errno == EINTR);
+        if(nb_lus < 0)                      // erreur de lecture, et non fin de l'entrée
+        {
+            t->erreur = 1;
+            nb_lus = 0;
+        }
+        t->nb[k] = (size_t)nb_lus;
+    }
+    else if(fwrite(t->tampon[k], 1, t->nb[k], t->fichier) != t->nb[k] || fflush(t->fichier) != 0)
+    {
+        t->erreur = 1;
+    }
+    return NULL;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn static void lance_transfert(QRtampon_double_t *t, int k)
+/// \brief lance la lecture ou l'ecriture du tampon k dans un thread (directement si le thread ne peut etre créé)
+static void lance_transfert(QRtampon_double_t *t, int k)
+{
+    t->en_transfert = k;
+    t->thread_actif = (pthread_create(&t->thread, NULL, transfert_tampon, t) == 0);
+    if(!t->thread_actif)
+    {
+        transfert_tampon(t);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn static void attend_transfert(QRtampon_double_t *t)
+/// \brief attend la fin du transfert en cours
+static void attend_transfert(QRtampon_double_t *t)
+{
+    if(t->thread_actif)
+    {
+        pthread_join(t->thread, NULL);
+        t->thread_actif = 0;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn static int demarre_tampon_double(QRtampon_double_t *t, FILE *fichier, int lecture, size_t taille)
+/// \brief alloue les 2 tampons de taille octets ; en lecture, lance le remplissage du premier
+/// \return 0, -1 en cas d'erreur d'allocation
+static int demarre_tampon_double(QRtampon_double_t *t, FILE *fichier, int lecture, size_t taille)
+{
+    t->fichier = fichier;
+    t->lecture = lecture;
+    t->taille = taille;
+    t->tampon[0] = malloc(2 * taille);
+    if(t->tampon[0] == NULL)
+    {
+        return -1;
+    }
+    t->tampon[1] = t->tampon[0] + taille;
+    t->nb[0] = t->nb[1] = 0;
+    t->courant = 0;
+    t->thread_actif = 0;
+    t->erreur = 0;
+    if(lecture)
+    {
+        lance_transfert(t, 0);
+    }
+    return 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn static size_t lit_tampon_suivant(QRtampon_double_t *t)
+/// \brief entrée : recupere le tampon qui vient d'etre lu et lance la lecture de l'autre
+/// \return nombre d'octets disponibles dans t->tampon[t->courant] (éventuellement moins que t->taille), 0 en fin de fichier
+static size_t lit_tampon_suivant(QRtampon_double_t *t)
+{
+    attend_transfert(t);
+    t->courant = t->en_transfert;
+    if(t->nb[t->courant] > 0)               // seule une lecture vide signale la fin de l'entrée (ou une erreur)
+    {
+        lance_transfert(t, 1 - t->courant);
+    }
+    else
+    {
+        t->nb[1 - t->courant] = 0;
+        t->en_transfert = 1 - t->courant;
+    }
+    return t->nb[t->courant];
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn static void ecrit_tampon_courant(QRtampon_double_t *t)
+/// \brief sortie : lance l'ecriture du tampon rempli et passe a l'autre (une fois son ecriture terminée)
+static void ecrit_tampon_courant(QRtampon_double_t *t)
+{
+    attend_transfert(t);
+    if(t->nb[t->courant] > 0)
+    {
+        lance_transfert(t, t->courant);
+        t->courant = 1 - t->courant;
+        t->nb[t->courant] = 0;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn static int termine_tampon_double(QRtampon_double_t *t)
+/// \brief termine les transferts en cours (en sortie : ecrit le dernier tampon) et libere les tampons
+/// \return 0, -1 si une lecture ou une ecriture a echoué
+static int termine_tampon_double(QRtampon_double_t *t)
+{
+    if(!t->lecture)
+    {
+        ecrit_tampon_courant(t);
+        attend_transfert(t);
+        if(fflush(t->fichier) != 0)
+        {
+            t->erreur = 1;
+        }
+    }
+    attend_transfert(t);
+    free(t->tampon[0]);
+    return t->erreur ? -1 : 0;
+}
+
+// etat du mode flux
+typedef struct
+{
+    unsigned short int version;
+    unsigned short int mode;
+    int format;
+    int echelle;               /** largeur en pixels d'un module  */
+    int zone_blanche;          /** largeur en modules de la marge */
+    QRtampon_double_t sortie;
+    int nb_donnees;            /** nombre de données lues      */
+    int nb_erreurs;            /** nombre de données non encodées */
+} QRflux_image_t;
+
+//////////////////////////////////////////////////////////////////////
+/// \fn static void traite_donnee_flux(QRflux_image_t *flux, const unsigned char *donnee, int longueur)
+/// \brief encode une donnée et ecrit son image a la suite dans le tampon de sortie
+///        (une donnée non encodable est signalée sur stderr, aucune image n'est ecrite)
+static void traite_donnee_flux(QRflux_image_t *flux, const unsigned char *donnee, int longueur)
+{
+    QRcode_t qrcode;
+    QRtampon_double_t *sortie = &flux->sortie;
+    int taille;
+
+    flux->nb_donnees++;
+    if((longueur > LONGUEUR_DONNEE_MAX) ||
+       (encode_QRcode(donnee, longueur, flux->version, flux->mode, MASQUE_AUTO, &qrcode) < 0))
+    {
+        fprintf(stderr, "donnee %d : non encodable dans cette version/mode\n", flux->nb_donnees);
+        flux->nb_erreurs++;
+        return;
+    }
+    taille = QRcode_to_image_memoire(&qrcode, flux->format, flux->echelle, flux->zone_blanche,
+                                     sortie->tampon[sortie->courant] + sortie->nb[sortie->courant],
+                                     (int)(sortie->taille - sortie->nb[sortie->courant]));
+    if(taille < 0)      // plus de place : on ecrit ce tampon et on recommence dans l'autre (assez grand pour une image)
+    {
+        ecrit_tampon_courant(sortie);
+        taille = QRcode_to_image_memoire(&qrcode, flux->format, flux->echelle, flux->zone_blanche,
+                                         sortie->tampon[sortie->courant], (int)sortie->taille);
+        if(taille < 0)  // image plus grande qu'un tampon vide : on ne l'ecrit pas
+        {
+            fprintf(stderr, "donnee %d : image trop grande pour le tampon de sortie\n", flux->nb_donnees);
+            flux->nb_erreurs++;
+            return;
+        }
+    }
+    sortie->nb[sortie->courant] += taille;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn int flux_QRcode(FILE *entree, FILE *sortie, unsigned short int version, unsigned short int mode, int format, int echelle, int zone_blanche, int longueur_prefixee)
+/// \brief Mode flux : encode chaque donnée lue sur entree et ecrit les images a la suite sur sortie
+/// \param[in] entree : les données, une par ligne (\n ou \r\n), ou précédées de leur longueur (4 octets, poids fort en tete)
+///                    lues par le descripteur du fichier (read), sans passer par le tampon de stdio
+/// \param[in] sortie : les images concaténées (PBM, PGM, bitmap brut, PNG, TIFF, SVG, PDF) ou les commandes d'imprimante (ZPL, ESC/POS), dans l'ordre des données
+/// \param[in] version : parmi M1_ ... M4_Q, ou VERSION_AUTO | niveau minimal (une version par donnée)
+/// \param[in] mode : parmi NUMERIC, ALPHANUM, ASCII, KANJI, ou MODE_AUTO
+/// \param[in] format : FORMAT_PBM, FORMAT_PGM, FORMAT_RAW, FORMAT_BITMAP, FORMAT_PNG, FORMAT_TIFF, FORMAT_SVG, FORMAT_PDF,
+///                    FORMAT_ZPL, FORMAT_Z64 ou FORMAT_ESCPOS
+/// \param[in] echelle : largeur en pixels d'un module (1 ou plus)
+/// \param[in] zone_blanche : largeur en modules de la marge blanche autour de chaque QRcode
+/// \param[in] longueur_prefixee : 0 pour une donnée par ligne, 1 pour longueur + données (données binaires)
+/// \return nombre de données non encodées, -1 en cas d'erreur d'entrée/sortie
+int flux_QRcode(FILE *entree, FILE *sortie, unsigned short int version,
+                unsigned short int mode, int format, int echelle, int zone_blanche, int longueur_prefixee)
+{
+    QRflux_image_t flux;
+    QRtampon_double_t lecture;
+    unsigned char *donnee;          // la donnée en cours (elle peut etre a cheval sur 2 tampons)
+    unsigned char *p, *fin, *q;
+    int longueur = 0;               // nombre d'octets de la donnée en cours
+    uint32_t attendu = 0;           // longueur_prefixee : nombre d'octets annoncés
+    uint32_t a_ignorer = 0;         // longueur_prefixee : octets restants d'une donnée trop longue
+    int nb_entete = 0;              // longueur_prefixee : nombre d'octets de longueur deja lus
+    int n, erreur;
+    size_t nb;
+    long long largeur = (NB_MODULE_MAX + 2LL*zone_blanche) * echelle;   // la plus grande image (M4)
+
+    if(echelle < 1 || zone_blanche < 0 || largeur > 0x3FFF)
+    {
+        return -1;
+    }
+    flux.version = (version & VERSION_AUTO) ? (version & (VERSION_AUTO | 3)) : (version & 7);
+    flux.mode = mode;
+    flux.format = format;
+    flux.echelle = echelle;
+    flux.zone_blanche = zone_blanche;
+    flux.nb_donnees = 0;
+    flux.nb_erreurs = 0;
+    donnee = malloc(LONGUEUR_DONNEE_MAX + 1);
+    if(donnee == NULL)
+    {
+        return -1;
+    }
+    if(demarre_tampon_double(&flux.sortie, sortie, 0, (128 + largeur*largeur > TAILLE_TAMPON_FLUX) ? 128 + largeur*largeur : TAILLE_TAMPON_FLUX) < 0)
+    {
+        free(donnee);
+        return -1;
+    }
+    if(demarre_tampon_double(&lecture, entree, 1, TAILLE_TAMPON_FLUX) < 0)
+    {
+        termine_tampon_double(&flux.sortie);
+        free(donnee);
+        return -1;
+    }
+
+    while((nb = lit_tampon_suivant(&lecture)) > 0)
+    {
+        p = lecture.tampon[lecture.courant];
+        fin = p + nb;
+        while(p < fin)
+        {
+            if(!longueur_prefixee)
+            {
+                q = memchr(p, '\n', fin - p);
+                n = (int)((q != NULL ? q : fin) - p);
+            }
+            else if(a_ignorer > 0)      // donnée trop longue : ses octets sont sautés, la donnée suivante reste alignée
+            {
+                n = ((size_t)(fin - p) < a_ignorer) ? (int)(fin - p) : (int)a_ignorer;
+                p += n;
+                a_ignorer -= n;
+                continue;
+            }
+            else if(nb_entete < 4)      // longueur sur 4 octets, poids fort en tete
+            {
+                attendu = (attendu << 8) | *p++;
+                nb_entete++;
+                if(nb_entete < 4)
+                {
+                    continue;
+                }
+                if(attendu > LONGUEUR_DONNEE_MAX)
+                {
+                    flux.nb_donnees++;
+                    fprintf(stderr, "donnee %d : trop longue (%lu octets), ignoree\n", flux.nb_donnees, (unsigned long)attendu);
+                    flux.nb_erreurs++;
+                    a_ignorer = attendu;
+                    attendu = 0;
+                    nb_entete = 0;
+                    continue;
+                }
+                if(attendu > 0)
+                {
+                    continue;
+                }
+                q = p;                  // donnée vide
+                n = 0;
+            }
+            else                        // attendu <= LONGUEUR_DONNEE_MAX
+            {
+                n = (fin - p < (int)attendu - longueur) ? (int)(fin - p) : (int)attendu - longueur;
+                q = (longueur + n == (int)attendu) ? p + n : NULL;
+            }
+            // on recopie ce qui tient dans la donnée (la suite d'une donnée trop longue est ignorée)
+            if(longueur <= LONGUEUR_DONNEE_MAX)
+            {
+                memcpy(donnee + longueur, p, (longueur + n > LONGUEUR_DONNEE_MAX + 1) ? LONGUEUR_DONNEE_MAX + 1 - longueur : n);
+            }
+            longueur += n;
+            p += n;
+            if(q != NULL)               // fin de la donnée
+            {
+                if(!longueur_prefixee)
+                {
+                    p++;                // le \n
+                    if(longueur > 0 && longueur <= LONGUEUR_DONNEE_MAX && donnee[longueur-1] == '\r')
+                    {
+                        longueur--;
+                    }
+                }
+                traite_donnee_flux(&flux, donnee, longueur);
+                longueur = 0;
+                attendu = 0;
+                nb_entete = 0;
+            }
+        }
+        if(nb < lecture.taille)         // l'entrée est tarie pour l'instant : les images deja produites partent sans attendre
+        {
+            ecrit_tampon_courant(&flux.sortie);
+        }
+    }
+    if(!longueur_prefixee && longueur > 0)      // derniere ligne sans \n
+    {
+        traite_donnee_flux(&flux, donnee, longueur);
+    }
+    else if(longueur_prefixee && nb_entete > 0)
+    {
+        fprintf(stderr, "donnee %d : tronquee en fin de flux\n", flux.nb_donnees + 1);
+        flux.nb_erreurs++;
+    }
+
+    erreur = termine_tampon_double(&lecture);
+    if(erreur < 0)
+    {
+        fprintf(stderr, "erreur de lecture de l'entree apres la donnee %d\n", flux.nb_donnees);
+    }
+    if(termine_tampon_double(&flux.sortie) < 0)
+    {
+        erreur = -1;
+    }
+    free(donnee);
+    return erreur < 0 ? -1 : flux.nb_erreurs;
+}
+
+//////////////////////////////////////////////////////////////////////
+/// \fn int main_flux(int argc, char *argv[])
+/// \brief analyse les options du mode flux et encode l'entrée standard vers la sortie standard
+///        microQRgen [-v M1|M2L|M2M|M3L|M3M|M4L|M4M|M4Q|auto|autoL|autoM|autoQ] [-m num|alnum|octet|kanji|auto] [-f pbm|pgm|raw|bitmap|png|tiff|svg|pdf|zpl|z64|escpos] [-e echelle] [-z zone] [-l]
+///        exemple : cat etiquettes.txt | microQRgen -v M3L -f pbm > etiquettes.pbm
+///                  cat references.txt | microQRgen -v autoL -m auto -f png > references.png
+/// \return 0 si tout est encodé, 1 si des données n'ont pas pu etre encodées, 2 en cas d'erreur
+int main_flux(int argc, char *argv[])
+{
+    static const char *noms_versions[12] = { "M1", "M2L", "M2M", "M3L", "M3M", "M4L", "M4M", "M4Q", "auto", "autoL", "autoM", "autoQ" };
+    static const unsigned short int versions[12] = { M1_, M2_L, M2_M, M3_L, M3_M, M4_L, M4_M, M4_Q,
+                                                     VERSION_AUTO, VERSION_AUTO | NIVEAU_L, VERSION_AUTO | NIVEAU_M, VERSION_AUTO | NIVEAU_Q };
+    static const char *noms_modes[5]    = { "num", "alnum", "octet", "kanji", "auto" };
+    static const unsigned short int modes[5] = { NUMERIC, ALPHANUM, ASCII, KANJI, MODE_AUTO };
+    static const char *noms_formats[11] = { "pbm", "pgm", "raw", "bitmap", "png", "tiff", "svg", "pdf", "zpl", "z64", "escpos" };
+    unsigned short int version = M4_L, mode = ASCII;
+    int format = FORMAT_PBM, longueur_prefixee = 0;
+    int echelle = PIX_BY_MODULE, zone_blanche = ZONE_BLANCHE;
+    int i, k, trouve, resultat;
+
+    for(i=1; i<argc; i++)
+    {
+        trouve = 0;
+        if(strcmp(argv[i], "-l") == 0)
+        {
+            longueur_prefixee = 1;
+            trouve = 1;
+        }
+        else if(i+1 < argc && strcmp(argv[i], "-v") == 0)
+        {
+            for(k=0; k<12; k++)
+            {
+                if(strcmp(argv[i+1], noms_versions[k]) == 0)
+                {
+                    version = versions[k];
+                    trouve = 1;
+                }
+            }
+            i++;
+        }
+        else if(i+1 < argc && strcmp(argv[i], "-m") == 0)
+        {
+            for(k=0; k<5; k++)
+            {
+                if(strcmp(argv[i+1], noms_modes[k]) == 0)
+                {
+                    mode = modes[k];
+                    trouve = 1;
+                }
+            }
+            i++;
+        }
+        else if(i+1 < argc && strcmp(argv[i], "-f") == 0)
+        {
+            for(k=0; k<11; k++)
+            {
+                if(strcmp(argv[i+1], noms_formats[k]) == 0)
+                {
+                    format = k;
+                    trouve = 1;
+                }
+            }
+            i++;
+        }
+        else if(i+1 < argc && strcmp(argv[i], "-e") == 0)
+        {
+            echelle = atoi(argv[++i]);
+            trouve = (echelle >= 1);
+        }
+        else if(i+1 < argc && strcmp(argv[i], "-z") == 0)
+        {
+            zone_blanche = atoi(argv[++i]);
+            trouve = (zone_blanche >= 0);
+        }
+        if(!trouve)
+        {
+            fprintf(stderr, "usage : %s [-v M1|M2L|M2M|M3L|M3M|M4L|M4M|M4Q|auto|autoL|autoM|autoQ] [-m num|alnum|octet|kanji|auto] [-f pbm|pgm|raw|bitmap|png|tiff|svg|pdf|zpl|z64|escpos] [-e echelle] [-z zone] [-l]\n"
+                            "  lit une donnee par ligne sur l'entree standard (-l : 4 octets de longueur puis la donnee)\n"
+                            "  et ecrit les images a la suite sur la sortie standard\n"
+                            "  (-e : pixels par module, %d par defaut ; -z : zone blanche en modules, %d par defaut)\n"
+                            "  (-v auto : plus petite version, autoL/autoM/autoQ : avec ce niveau de correction au moins ;\n"
+                            "   -m kanji : chaine UTF-8 de caracteres Shift-JIS ; -m auto : segments de longueur totale minimale)\n",
+                    argv[0], PIX_BY_MODULE, ZONE_BLANCHE);
+            return 2;
+        }
+    }
+
+#ifdef _WIN32
+    _setmode(_fileno(stdin),  _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    setvbuf(stdin,  NULL, _IONBF, 0);     // les tampons du mode flux remplacent ceux de stdio
+    setvbuf(stdout, NULL, _IONBF, 0);
+    resultat = flux_QRcode(stdin, stdout, version, mode, format, echelle, zone_blanche, longueur_prefixee);
+    if(resultat < 0)
+    {
+        fprintf(stderr, "erreur d'entree/sortie\n");
+        return 2;
+    }
+    return (resultat > 0) ? 1 : 0;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn void QRcode_to_console(const QRcode_t *qrcode){
+///  \brief  Code C fourni  : Fonction d'affichage basique du microQRcode sur la console
+/// affiche un microQRcode sur la console, . pour les blanc, * pour les noirs, F,V, S pour reperer les differentes
+/// zone lors du debug.
+/// \param[in] qrcode : le QRcode a afficher sur la console !
+void QRcode_to_console(const QRcode_t *qrcode)
+{
+    int i,j;
+    putchar('\n');
+    for(i=0; i<qrcode->nb_module; i++)
+    {
+        for(j=0; j<qrcode->nb_module; j++)
+        {
+            switch(qrcode->module[i][j])                                      // on ajoute 1 espace entre module pour que ca ressemble a un carré
+            {
+            case BLANC :
+                putchar('.');
+                putchar(' ');
+                break;       // des . pour le blanc /
+            case NOIR  :
+                putchar('*');
+                putchar(' ');
+                break;       // des * pour les noirs
+            default    :
+                if((qrcode->module[i][j] <=126) && (qrcode->module[i][j]>= 32) )  // on affiche les carectere "affichable"
+                {
+                    putchar(qrcode->module[i][j]);
+                    putchar(' ');
+                }
+                else
+                {
+                    putchar(' ');                      // si non on n'affiche rien
+                    putchar(' ');
+                };
+                break;
+            }
+        }
+        putchar('\n');
+    }
+    putchar('\n');
+}
+/// echelle (pixels par module) et zone blanche (en modules) utilisées par QRcode_to_pgm et QRcode_to_ppm
+static int echelle_rendu      = PIX_BY_MODULE;
+static int zone_blanche_rendu = ZONE_BLANCHE;
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn void fixe_rendu_QRcode(int echelle, int zone_blanche)
+/// \brief fixe la taille d'un module en pixels et la largeur de la zone blanche des exports QRcode_to_pgm et QRcode_to_ppm
+/// \param[in] echelle : largeur en pixels d'un module (PIX_BY_MODULE par défaut, 20 a 40 pour une imprimante 600 dpi)
+/// \param[in] zone_blanche : largeur en modules de la zone blanche autour du QRcode (ZONE_BLANCHE par défaut, 0 sans marge)
+void fixe_rendu_QRcode(int echelle, int zone_blanche)
+{
+    if(echelle >= 1)
+    {
+        echelle_rendu = echelle;
+    }
+    if(zone_blanche >= 0)
+    {
+        zone_blanche_rendu = zone_blanche;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static int largeur_image(const QRcode_t *qrcode, int echelle, int zone_blanche)
+/// \brief largeur (et hauteur) en pixels de l'image d'un QRcode
+/// \return la largeur, -1 si les parametres sont invalides ou l'image trop grande (plus de 16383 pixels de large)
+static int largeur_image(const QRcode_t *qrcode, int echelle, int zone_blanche)
+{
+    long long largeur = (long long)(qrcode->nb_module + 2LL*zone_blanche) * echelle;
+
+    if(echelle < 1 || zone_blanche < 0 || largeur > 0x3FFF)
+    {
+        return -1;
+    }
+    return (int)largeur;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static int ecrit_fichier_image(const char *filename, const unsigned char *image, int taille)
+/// \brief ecrit une image (préparée en memoire) dans un fichier, en une seule ecriture
+/// \return 0, -1 si le fichier ne s'ouvre pas ou si l'ecriture a echoué
+static int ecrit_fichier_image(const char *filename, const unsigned char *image, int taille)
+{
+    FILE *fd;
+    int erreur;
+
+//Test sur l'ouverture du fichier
+    if(!(fd = fopen(filename,"wb")) )
+    {
+        fprintf(stderr,"QRcode2ppm, erreur de cr�ation du fichier %s\n",filename);
+        return -1;
+    }
+    erreur = (fwrite(image, 1, taille, fd) != (size_t)taille);
+    erreur |= (fclose(fd) != 0);
+    return erreur ? -1 : 0;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void replique_ligne(unsigned char *ligne, int octets_ligne, int echelle)
+/// \brief recopie une ligne de pixels sur les echelle-1 lignes suivantes (un module fait echelle lignes)
+static void replique_ligne(unsigned char *ligne, int octets_ligne, int echelle)
+{
+    int k;
+    for(k=1; k<echelle; k++)
+    {
+        memcpy(ligne + k*octets_ligne, ligne, octets_ligne);
+    }
+}
+
+// agrandissement d'une ligne de modules en pixels (1 octet par pixel)
+// avec SSSE3, pour echelle < 16, un bloc de 16 pixels couvre au plus 16 modules consécutifs : il s'obtient par un pshufb
+// des modules, avec des index qui ne dependent que de la position du bloc modulo echelle (phase).
+typedef struct
+{
+    int echelle;
+#if defined(__SSSE3__)
+    __m128i index[16];          /** index[phase] : n° du module (relatif au premier module du bloc) de chacun des 16 pixels */
+#endif
+} QRagrandissement_t;
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void prepare_agrandissement(QRagrandissement_t *agrandissement, int echelle)
+/// \brief calcule une fois par image les index de pshufb de chaque phase
+static void prepare_agrandissement(QRagrandissement_t *agrandissement, int echelle)
+{
+#if defined(__SSSE3__)
+    unsigned char index[16];
+    int phase, k;
+
+    for(phase=0; phase<echelle && phase<16; phase++)
+    {
+        for(k=0; k<16; k++)
+        {
+            index[k] = (unsigned char)((phase + k) / echelle);
+        }
+        agrandissement->index[phase] = _mm_loadu_si128((const __m128i *)index);
+    }
+#endif
+    agrandissement->echelle = echelle;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void agrandit_ligne(const QRagrandissement_t *agrandissement, const unsigned char *modules, int nb, unsigned char *pixels)
+/// \brief ecrit nb*echelle pixels : chaque module (la valeur de ses pixels) est répété echelle fois
+///        SSSE3 et echelle < 16 : un pshufb par bloc de 16 pixels
+///        SSE2 et echelle >= 16 : la valeur du module est diffusée dans un registre puis ecrite par blocs de 16 pixels
+///        sinon : un memset par module
+/// \param[in]  agrandissement : l'echelle et ses index (voir prepare_agrandissement)
+/// \param[in]  modules[nb+16] : la valeur de chaque module (16 octets lisibles apres le dernier module)
+/// \param[in]  nb : nombre de modules
+/// \param[out] pixels[nb*echelle] : la ligne de pixels
+static void agrandit_ligne(const QRagrandissement_t *agrandissement, const unsigned char *modules, int nb, unsigned char *pixels)
+{
+    int echelle = agrandissement->echelle;
+    int j;
+#if defined(__SSSE3__)
+    if(echelle < 16)
+    {
+        unsigned char dernier[16];
+        int largeur = nb * echelle;
+        int x, premier = 0, phase = 0;
+        __m128i bloc;
+
+        for(x=0; x<largeur; x+=16)
+        {
+            bloc = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(modules + premier)), agrandissement->index[phase]);
+            if(x + 16 <= largeur)
+            {
+                _mm_storeu_si128((__m128i *)(pixels + x), bloc);
+            }
+            else
+            {
+                _mm_storeu_si128((__m128i *)dernier, bloc);
+                memcpy(pixels + x, dernier, largeur - x);
+            }
+            // bloc suivant : 16 pixels plus loin
+            premier += 16 / echelle;
+            phase += 16 % echelle;
+            if(phase >= echelle)
+            {
+                phase -= echelle;
+                premier++;
+            }
+        }
+        return;
+    }
+#endif
+#if defined(__SSE2__)
+    if(echelle >= 16)
+    {
+        __m128i valeur;
+        int k;
+
+        for(j=0; j<nb; j++)
+        {
+            valeur = _mm_set1_epi8((char)modules[j]);
+            for(k=0; k+16<=echelle; k+=16)
+            {
+                _mm_storeu_si128((__m128i *)(pixels + k), valeur);
+            }
+            if(k < echelle)     // fin du module : un bloc qui recouvre le précédent
+            {
+                _mm_storeu_si128((__m128i *)(pixels + echelle - 16), valeur);
+            }
+            pixels += echelle;
+        }
+        return;
+    }
+#endif
+    for(j=0; j<nb; j++)
+    {
+        memset(pixels + j*echelle, modules[j], echelle);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void QRcode_to_gris(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *pixels)
+/// \brief ecrit les pixels (1 octet par pixel, la valeur des modules) de l'image d'un QRcode entouré de sa zone blanche
+///        chaque ligne de pixels est construite une seule fois par ligne de modules puis recopiée echelle fois
+/// \param[out] pixels : largeur_image() * largeur_image() octets
+static void QRcode_to_gris(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *pixels)
+{
+    QRagrandissement_t agrandissement;
+    unsigned char modules[NB_MODULE_MAX + 16];
+    int largeur = (qrcode->nb_module + 2*zone_blanche) * echelle;
+    int marge = zone_blanche * echelle;
+    int i;
+
+    prepare_agrandissement(&agrandissement, echelle);
+    memset(modules, BLANC, sizeof(modules));
+    memset(pixels, BLANC, (size_t)marge * largeur);                 // zone blanche du haut
+    pixels += (size_t)marge * largeur;
+    for(i=0; i<qrcode->nb_module; i++)
+    {
+        memcpy(modules, qrcode->module[i], qrcode->nb_module);
+        memset(pixels, BLANC, marge);
+        agrandit_ligne(&agrandissement, modules, qrcode->nb_module, pixels + marge);
+        memset(pixels + largeur - marge, BLANC, marge);
+        replique_ligne(pixels, largeur, echelle);
+        pixels += (size_t)echelle * largeur;
+    }
+    memset(pixels, BLANC, (size_t)marge * largeur);                 // zone blanche du bas
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_pgm_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+/// \brief Ecrit l'image PGM (entete compris) d'un QRcode dans un tableau
+/// \param[in]  qrcode le QRcode (0 pour le noir, 255 pour le blanc)
+/// \param[in]  echelle : largeur en pixels d'un module (1 ou plus)
+/// \param[in]  zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \param[out] image : le tableau ou ecrire le PGM
+/// \param[in]  taille_max : taille du tableau
+/// \return nombre d'octets ecrits, -1 si le tableau est trop petit ou les parametres invalides (rien n'est ecrit)
+int QRcode_to_pgm_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+{
+    int largeur = largeur_image(qrcode, echelle, zone_blanche);
+    int entete;
+    char texte[96];
+
+    if(largeur < 0)
+    {
+        return -1;
+    }
+// ecriture du PGM en niveau de gris (256) Entete d'un fichier ppm  P5 = Magick number....
+    entete = sprintf(texte, "P5\n#fichier PGM pour QRcode \n#IUT VDA S.BRETTE 2021\n%d %d 255 ", largeur, largeur);
+    // entete ppm P5 : largeur, hauteur, nb niveaux de gris
+    // NE PAS TOUCHER A CETTE ENTETE, espace (et non \n indispensable apres le 255
+    if(entete + largeur*largeur > taille_max)
+    {
+        return -1;
+    }
+    memcpy(image, texte, entete);
+// BBBBBB a la suite jusqu'a la fin en partant en haut a gauche de l'image
+    QRcode_to_gris(qrcode, echelle, zone_blanche, image + entete);
+    return entete + largeur*largeur;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_ppm_memoire(const QRcode_t *qrcode, unsigned long int color, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+/// \brief Ecrit l'image PPM (entete compris) d'un QRcode dans un tableau
+///        tout module BLANC (et la zone blanche) est ecrit en blanc, les autres dans la couleur RGB color
+/// \param[in]  qrcode le QRcode
+/// \param[in]  color : la couleur des modules qui ne sont pas blancs (0x00FF0000 pour le rouge pur)
+/// \param[in]  echelle : largeur en pixels d'un module (1 ou plus)
+/// \param[in]  zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \param[out] image : le tableau ou ecrire le PPM
+/// \param[in]  taille_max : taille du tableau
+/// \return nombre d'octets ecrits, -1 si le tableau est trop petit ou les parametres invalides (rien n'est ecrit)
+int QRcode_to_ppm_memoire(const QRcode_t *qrcode, unsigned long int color, int echelle, int zone_blanche,
+                          unsigned char *image, int taille_max)
+{
+    int largeur = largeur_image(qrcode, echelle, zone_blanche);
+    int octets_ligne = 3*largeur;
+    int marge = zone_blanche * echelle;
+    int entete, i, j, jj;
+    unsigned char *ligne, *pixel;
+    unsigned char couleurs[2][3];                   // [0] : blanc, [1] : la couleur des modules non blancs
+    char texte[32];
+
+    if(largeur < 0)
+    {
+        return -1;
+    }
+    couleurs[0][0] = couleurs[0][1] = couleurs[0][2] = 255;
+    couleurs[1][0] = (color & 0x00FF0000)>>16;      // extraction des couleurs primaires R,G,B
+    couleurs[1][1] = (color & 0x0000FF00)>>8;       // pour ecriture dans le PPM
+    couleurs[1][2] = (color & 0x000000FF);
+
+// Entete d'un fichier ppm  P6 = Magick number....
+    entete = sprintf(texte, "P6\n%d %d\n255 ", largeur, largeur);  // entete ppm P6 : largeur, hauteur, nb niveaux sur  canaux RGB
+    if(entete + octets_ligne*largeur > taille_max)
+    {
+        return -1;
+    }
+    memcpy(image, texte, entete);
+// RGBRGBRGBRGB a la suite jusqu'a la fin en partant en haut a gauche de l'image
+    ligne = image + entete;
+    memset(ligne, 255, (size_t)marge * octets_ligne);               // zone blanche du haut
+    ligne += (size_t)marge * octets_ligne;
+    for(i=0; i<qrcode->nb_module; i++)
+    {
+        memset(ligne, 255, 3*marge);
+        pixel = ligne + 3*marge;
+        for(j=0; j<qrcode->nb_module; j++)
+        {
+            for(jj=0; jj<echelle; jj++) // repetition par colonne
+            {
+                memcpy(pixel, couleurs[qrcode->module[i][j] != BLANC], 3);
+                pixel += 3;
+            }
+        }
+        memset(pixel, 255, 3*marge);
+        replique_ligne(ligne, octets_ligne, echelle);
+        ligne += (size_t)echelle * octets_ligne;
+    }
+    memset(ligne, 255, (size_t)marge * octets_ligne);               // zone blanche du bas
+    return entete + octets_ligne*largeur;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_pgm(const QRcode_t *qrcode, char *filename)
+/// \brief Code C fourni : Fonction d'export en PGM (portable Gray map); format d'image lisible avec xniew
+/// \param[in] qrcode le QRcode !
+/// \param[out] *filename     le nom du fichier image ou enregistre le qr code (avec extension .pgm)
+
+// la taille en pixels d'un module (PIX_BY_MODULE par défaut) et la zone blanche (ZONE_BLANCHE modules par défaut)
+// sont fixées par fixe_rendu_QRcode. exemple si l'echelle vaut 8, chaque module =1bit)= deviendra 8 x 8 pixels dans l'image
+// le qrcode passé doit etre codé en niveau de gris (0 pour le noir, 255 pour le blanc)..
+// l'image est préparée en memoire (QRcode_to_pgm_memoire) puis ecrite en une seule fois
+
+int QRcode_to_pgm(const QRcode_t *qrcode, char *filename)
+{
+    unsigned char *image;
+    int largeur = largeur_image(qrcode, echelle_rendu, zone_blanche_rendu);
+    int taille_max = 128 + largeur*largeur;
+    int taille, resultat = -1;
+
+    if(largeur < 0 || (image = malloc(taille_max)) == NULL)
+    {
+        return -1;
+    }
+    taille = QRcode_to_pgm_memoire(qrcode, echelle_rendu, zone_blanche_rendu, image, taille_max);
+    if(taille >= 0)
+    {
+        resultat = ecrit_fichier_image(filename, image, taille);
+    }
+    free(image);
+    return resultat;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// /////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_ppm(const QRcode_t *qrcode, char *filename, unsigned long int color)
+/// \brief Code C fourni : Fonction d'export en PPM (portable Pix map  map); format d'image lisible avec xniew
+/// \param[in]  qrcode  LE qrcode !
+/// \param[in] *filename     le nom du fichier image ou enregistre le qr code (avec extension .ppm)
+/// \param[in]  color ! la couleur des modules qui ne sont pas blancs ( (0x00FF0000 pour le rouge pur)
+/// la taille en pixels d'un module et la zone blanche sont fixées par fixe_rendu_QRcode (PIX_BY_MODULE et ZONE_BLANCHE par défaut)
+/// exemple si l'echelle vaut 8, chaque module deviendra 8 x 8 pixel dans l'image
+/// le qrcode passé  est codé en niveau de gris (0 pour le noir, 255 pour le blanc)..
+/// tout module == 0 sera ecrit en blanc, les autres dans la couleur RGB définit dans la fonction.
+/// l'image est préparée en memoire (QRcode_to_ppm_memoire) puis ecrite en une seule fois
+int QRcode_to_ppm(const QRcode_t *qrcode, char *filename, unsigned long int color)
+{
+    unsigned char *image;
+    int largeur = largeur_image(qrcode, echelle_rendu, zone_blanche_rendu);
+    int taille_max = 64 + 3*largeur*largeur;
+    int taille, resultat = -1;
+
+    if(largeur < 0 || (image = malloc(taille_max)) == NULL)
+    {
+        return -1;
+    }
+    taille = QRcode_to_ppm_memoire(qrcode, color, echelle_rendu, zone_blanche_rendu, image, taille_max);
+    if(taille >= 0)
+    {
+        resultat = ecrit_fichier_image(filename, image, taille);
+    }
+    free(image);
+    return resultat;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void remplit_bits(unsigned char *ligne, int debut, int nb)
+/// \brief met a 1 les bits debut ... debut+nb-1 d'une ligne de pixels a 1 bit par pixel (poids fort a gauche)
+static void remplit_bits(unsigned char *ligne, int debut, int nb)
+{
+    int k, n;
+    while(nb > 0)
+    {
+        k = debut & 7;                  // premier bit dans l'octet
+        n = (8 - k < nb) ? 8 - k : nb;  // nombre de bits dans cet octet
+        ligne[debut >> 3] |= (unsigned char)((0xFF >> k) & (0xFF << (8 - k - n)));
+        debut += n;
+        nb -= n;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void ligne_bits_QRcode(const QRcode_t *qrcode, int i, int echelle, int marge, unsigned char *ligne, int octets_ligne)
+/// \brief une ligne de pixels (1 bit par pixel, 1 = NOIR) de la ligne de modules i, avec marge pixels blancs a gauche :
+///        les modules NOIR consécutifs donnent une seule suite de bits
+static void ligne_bits_QRcode(const QRcode_t *qrcode, int i, int echelle, int marge, unsigned char *ligne, int octets_ligne)
+{
+    int j, k;
+
+    memset(ligne, 0, octets_ligne);
+    for(j=0; j<qrcode->nb_module; j=k)
+    {
+        for(k=j+1; k<qrcode->nb_module && (qrcode->module[i][k] != BLANC) == (qrcode->module[i][j] != BLANC); k++);
+        if(qrcode->module[i][j] != BLANC)
+        {
+            remplit_bits(ligne, marge + j*echelle, (k-j)*echelle);
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_bitmap_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+/// \brief Ecrit le bitmap brut (sans entete) d'un QRcode dans un tableau : 1 bit par pixel, 1 = NOIR, poids fort a gauche,
+///        chaque ligne de pixels complétée a un nombre entier d'octets (meme codage que les données d'un PBM P4)
+/// \param[in]  qrcode le QRcode
+/// \param[in]  echelle : largeur en pixels d'un module (1 ou plus)
+/// \param[in]  zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \param[out] image : le tableau ou ecrire le bitmap
+/// \param[in]  taille_max : taille du tableau
+/// \return nombre d'octets ecrits, -1 si le tableau est trop petit ou les parametres invalides (rien n'est ecrit)
+int QRcode_to_bitmap_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+{
+    int largeur = largeur_image(qrcode, echelle, zone_blanche);
+    int octets_ligne, marge, i;
+    long long taille;
+    unsigned char *ligne;
+
+    if(largeur < 0)
+    {
+        return -1;
+    }
+    octets_ligne = (largeur + 7) / 8;
+    taille = (long long)octets_ligne * largeur;
+    if(taille > taille_max)
+    {
+        return -1;
+    }
+    marge = zone_blanche * echelle;
+    memset(image, 0, marge * octets_ligne);                 // zone blanche du haut
+    ligne = image + marge * octets_ligne;
+    for(i=0; i<qrcode->nb_module; i++)
+    {
+        // une ligne de pixels par ligne de modules, recopiée echelle fois
+        ligne_bits_QRcode(qrcode, i, echelle, marge, ligne, octets_ligne);
+        replique_ligne(ligne, octets_ligne, echelle);
+        ligne += echelle*octets_ligne;
+    }
+    memset(ligne, 0, marge * octets_ligne);                 // zone blanche du bas
+    return (int)taille;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_pbm_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+/// \brief Ecrit l'image PBM P4 (entete compris) d'un QRcode dans un tableau, 1 bit par pixel
+/// \param[in]  qrcode le QRcode
+/// \param[in]  echelle : largeur en pixels d'un module (1 ou plus)
+/// \param[in]  zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \param[out] image : le tableau ou ecrire le PBM
+/// \param[in]  taille_max : taille du tableau
+/// \return nombre d'octets ecrits, -1 si le tableau est trop petit ou les parametres invalides (rien n'est ecrit)
+int QRcode_to_pbm_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+{
+    int largeur = largeur_image(qrcode, echelle, zone_blanche);
+    int entete, taille;
+    char texte[32];
+
+    if(largeur < 0)
+    {
+        return -1;
+    }
+    entete = sprintf(texte, "P4\n%d %d\n", largeur, largeur);      // entete pbm P4 : largeur, hauteur
+    if(entete > taille_max)
+    {
+        return -1;
+    }
+    taille = QRcode_to_bitmap_memoire(qrcode, echelle, zone_blanche, image + entete, taille_max - entete);
+    if(taille < 0)
+    {
+        return -1;
+    }
+    memcpy(image, texte, entete);
+    return entete + taille;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static int taille_bitmap(const QRcode_t *qrcode, int echelle, int zone_blanche)
+/// \brief taille en octets du bitmap a 1 bit par pixel (sans entete), -1 si les parametres sont invalides
+static int taille_bitmap(const QRcode_t *qrcode, int echelle, int zone_blanche)
+{
+    int largeur = largeur_image(qrcode, echelle, zone_blanche);
+
+    return (largeur < 0) ? -1 : ((largeur + 7) / 8) * largeur;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_pbm(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche)
+/// \brief Fonction d'export en PBM P4 (portable bitmap, 1 bit par pixel) : 8 fois plus petit qu'un PGM
+/// \param[in] qrcode le QRcode
+/// \param[in] *filename : le nom du fichier image (avec extension .pbm)
+/// \param[in] echelle : largeur en pixels d'un module (1 ou plus)
+/// \param[in] zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \return 0, -1 si les parametres sont invalides ou si l'ecriture a echoué
+int QRcode_to_pbm(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche)
+{
+    unsigned char *image;
+    int taille_max = taille_bitmap(qrcode, echelle, zone_blanche);
+    int resultat = -1;
+
+    if(taille_max < 0 || (image = malloc(taille_max + 32)) == NULL)
+    {
+        return -1;
+    }
+    taille_max = QRcode_to_pbm_memoire(qrcode, echelle, zone_blanche, image, taille_max + 32);
+    if(taille_max >= 0)
+    {
+        resultat = ecrit_fichier_image(filename, image, taille_max);
+    }
+    free(image);
+    return resultat;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_bitmap(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche)
+/// \brief Fonction d'export en bitmap brut sans entete (1 bit par pixel, 1 = NOIR, lignes completées a l'octet)
+///        la largeur (et la hauteur) de l'image est (nb_module + 2*zone_blanche) * echelle pixels
+/// \param[in] qrcode le QRcode
+/// \param[in] *filename : le nom du fichier
+/// \param[in] echelle : largeur en pixels d'un module (1 ou plus)
+/// \param[in] zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \return 0, -1 si les parametres sont invalides ou si l'ecriture a echoué
+int QRcode_to_bitmap(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche)
+{
+    unsigned char *image;
+    int taille_max = taille_bitmap(qrcode, echelle, zone_blanche);
+    int resultat;
+
+    if(taille_max < 0 || (image = malloc(taille_max + 1)) == NULL)
+    {
+        return -1;
+    }
+    QRcode_to_bitmap_memoire(qrcode, echelle, zone_blanche, image, taille_max);
+    resultat = ecrit_fichier_image(filename, image, taille_max);
+    free(image);
+    return resultat;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void efface_bits(unsigned char *ligne, int debut, int nb)
+/// \brief met a 0 les bits debut ... debut+nb-1 d'une ligne de pixels a 1 bit par pixel (poids fort a gauche)
+static void efface_bits(unsigned char *ligne, int debut, int nb)
+{
+    int k, n;
+    while(nb > 0)
+    {
+        k = debut & 7;
+        n = (8 - k < nb) ? 8 - k : nb;
+        ligne[debut >> 3] &= (unsigned char)~((0xFF >> k) & (0xFF << (8 - k - n)));
+        debut += n;
+        nb -= n;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void copie_bits(unsigned char *destination, const unsigned char *source, int debut, int fin)
+/// \brief recopie les bits debut ... fin-1 d'une ligne a 1 bit par pixel sans toucher aux autres bits de la destination
+static void copie_bits(unsigned char *destination, const unsigned char *source, int debut, int fin)
+{
+    int premier = debut >> 3, dernier = (fin - 1) >> 3;
+    unsigned char masque_debut = (unsigned char)(0xFF >> (debut & 7));
+    unsigned char masque_fin   = (unsigned char)(0xFF << (7 - ((fin - 1) & 7)));
+
+    if(premier == dernier)
+    {
+        masque_debut &= masque_fin;
+        destination[premier] = (destination[premier] & ~masque_debut) | (source[premier] & masque_debut);
+        return;
+    }
+    destination[premier] = (destination[premier] & ~masque_debut) | (source[premier] & masque_debut);
+    memcpy(destination + premier + 1, source + premier + 1, dernier - premier - 1);
+    destination[dernier] = (destination[dernier] & ~masque_fin) | (source[dernier] & masque_fin);
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void remplit_pixels(unsigned char *ligne, int format_pixel, int debut, int nb, int noir)
+/// \brief colorie nb pixels consécutifs (a partir du pixel debut) d'une ligne de la page en noir ou en blanc
+static void remplit_pixels(unsigned char *ligne, int format_pixel, int debut, int nb, int noir)
+{
+    static const unsigned char couleurs[2][4] = { { 255, 255, 255, 255 }, { 0, 0, 0, 255 } };   // blanc, noir (RGBA)
+    int octets, fait, n;
+
+    switch(format_pixel)
+    {
+    case PIXEL_1BIT :
+        if(noir)
+        {
+            remplit_bits(ligne, debut, nb);
+        }
+        else
+        {
+            efface_bits(ligne, debut, nb);
+        }
+        return;
+    case PIXEL_GRIS8 :
+        memset(ligne + debut, noir ? NOIR : BLANC, nb);
+        return;
+    }
+    // RGB24 / RGBA32 : le premier pixel, puis des copies de taille doublée
+    octets = (format_pixel == PIXEL_RGB24) ? 3 : 4;
+    ligne += debut * octets;
+    nb *= octets;
+    memcpy(ligne, couleurs[noir != 0], octets);
+    for(fait=octets; fait<nb; fait+=n)
+    {
+        n = (fait < nb - fait) ? fait : nb - fait;
+        memcpy(ligne + fait, ligne, n);
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_page(const QRcode_t *qrcode, unsigned char *page, int largeur_page, int hauteur_page, int pas, int format_pixel, int x0, int y0, int echelle, int zone_blanche)
+/// \brief Dessine un QRcode, entouré de sa zone blanche, directement dans une page (framebuffer) fournie par l'appelant
+///        le QRcode est découpé aux bords de la page ; aucune allocation, aucun fichier, aucune copie intermédiaire
+///        chaque ligne de modules est dessinée une fois (fond blanc puis suites de modules noirs), puis recopiée
+///        sur les echelle-1 lignes de pixels suivantes (en PIXEL_1BIT, les bits hors du QRcode des octets du bord sont conservés)
+/// \param[in]     qrcode : le QRcode
+/// \param[in,out] page : le premier octet de la ligne 0 de la page
+/// \param[in]     largeur_page, hauteur_page : taille de la page en pixels
+/// \param[in]     pas : nombre d'octets entre 2 lignes de la page (négatif pour une page stockée de bas en haut)
+/// \param[in]     format_pixel : PIXEL_GRIS8, PIXEL_RGB24, PIXEL_RGBA32 ou PIXEL_1BIT
+/// \param[in]     x0, y0 : position dans la page du coin haut gauche de la zone blanche (peut etre hors de la page)
+/// \param[in]     echelle : largeur en pixels d'un module (1 ou plus)
+/// \param[in]     zone_blanche : largeur en modules de la marge blanche (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \return 0, -1 si les parametres sont invalides
+int QRcode_to_page(const QRcode_t *qrcode, unsigned char *page, int largeur_page, int hauteur_page,
+                   int pas, int format_pixel, int x0, int y0, int echelle, int zone_blanche)
+{
+    static const int octets_pixel[3] = { 1, 3, 4 };
+    int largeur = largeur_image(qrcode, echelle, zone_blanche);
+    int marge = zone_blanche * echelle;
+    int xa, xb, y, yb, i, j, k, debut, fin, ligne_module;
+    unsigned char *ligne, *premiere = NULL;
+
+    if(largeur < 0 || format_pixel < PIXEL_GRIS8 || format_pixel > PIXEL_1BIT || largeur_page < 0 || hauteur_page < 0)
+    {
+        return -1;
+    }
+    // partie visible du QRcode : colonnes [xa, xb[ et lignes [y, yb[ de la page
+    xa = (x0 > 0) ? x0 : 0;
+    xb = (x0 + largeur < largeur_page) ? x0 + largeur : largeur_page;
+    y  = (y0 > 0) ? y0 : 0;
+    yb = (y0 + largeur < hauteur_page) ? y0 + largeur : hauteur_page;
+    if(xa >= xb || y >= yb)
+    {
+        return 0;                       // entierement hors de la page
+    }
+
+    for(ligne_module=-1; y<yb; y++)
+    {
+        ligne = page + (ptrdiff_t)y * pas;
+        i = (y - y0) / echelle;         // ligne de modules (zone blanche comprise)
+        if(i == ligne_module)
+        {
+            if(format_pixel == PIXEL_1BIT)
+            {
+                copie_bits(ligne, premiere, xa, xb);
+            }
+            else
+            {
+                memcpy(ligne + xa*octets_pixel[format_pixel], premiere + xa*octets_pixel[format_pixel],
+                       (size_t)(xb - xa) * octets_pixel[format_pixel]);
+            }
+            continue;
+        }
+        ligne_module = i;
+        premiere = ligne;
+        remplit_pixels(ligne, format_pixel, xa, xb - xa, 0);
+        i -= zone_blanche;
+        if(i < 0 || i >= qrcode->nb_module)
+        {
+            continue;                   // zone blanche du haut ou du bas
+        }
+        for(j=0; j<qrcode->nb_module; j=k)
+        {
+            for(k=j+1; k<qrcode->nb_module && (qrcode->module[i][k] != BLANC) == (qrcode->module[i][j] != BLANC); k++);
+            if(qrcode->module[i][j] != BLANC)
+            {
+                debut = x0 + marge + j*echelle;
+                fin   = x0 + marge + k*echelle;
+                if(debut < xa) debut = xa;
+                if(fin > xb)   fin = xb;
+                if(debut < fin)
+                {
+                    remplit_pixels(ligne, format_pixel, debut, fin - debut, 1);
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// une planche en cours de rendu : chaque case de la grille est dessinée par une tache du pool
+typedef struct
+{
+    const QRcode_t *qrcodes;
+    int nb;                     /** nombre de QRcodes                                              */
+    int colonnes;               /** nombre de cases par ligne                                      */
+    int cellule;                /** largeur (et hauteur) en pixels d'une case                       */
+    int pas_colonne;            /** distance en pixels entre 2 cases (multiple de 8 en PIXEL_1BIT) */
+    int format_pixel;           /** PIXEL_GRIS8 (PGM) ou PIXEL_1BIT (PBM)                           */
+    int pas;                    /** nombre d'octets d'une ligne de la planche                      */
+    int nb_module_max;          /** largeur en modules du plus grand QRcode                        */
+    int echelle;
+    int zone_blanche;
+    unsigned char *pixels;      /** premier pixel de la planche (apres l'entete)                   */
+} QRatlas_t;
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void tache_atlas(int index, void *contexte)
+/// \brief tache du pool : dessine le QRcode n° index dans sa case (une case vide est blanchie)
+///        un QRcode plus petit que le plus grand est centré en élargissant sa zone blanche : toutes les cases ont la meme taille
+///        les cases ne partagent aucun octet : les taches peuvent ecrire en parallele sans synchronisation
+static void tache_atlas(int index, void *contexte)
+{
+    QRatlas_t *atlas = (QRatlas_t *)contexte;
+    unsigned char *case_atlas;
+    int colonne = index % atlas->colonnes;
+    int i;
+
+    case_atlas = atlas->pixels + (size_t)(index / atlas->colonnes) * atlas->cellule * atlas->pas
+                 + ((atlas->format_pixel == PIXEL_1BIT) ? colonne * atlas->pas_colonne / 8 : colonne * atlas->pas_colonne);
+    if(index < atlas->nb)
+    {
+        QRcode_to_page(&atlas->qrcodes[index], case_atlas, atlas->cellule, atlas->cellule, atlas->pas, atlas->format_pixel, 0, 0,
+                       atlas->echelle, atlas->zone_blanche + (atlas->nb_module_max - atlas->qrcodes[index].nb_module) / 2);
+    }
+    else if(atlas->format_pixel == PIXEL_GRIS8)     // en PBM, le fichier vide est deja blanc (bits a 0)
+    {
+        for(i=0; i<atlas->cellule; i++)
+        {
+            memset(case_atlas + (size_t)i * atlas->pas, BLANC, atlas->cellule);
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int atlas_QRcode(const char *filename, const QRcode_t *qrcodes, int nb, int colonnes, int format, int echelle, int zone_blanche, int nb_threads)
+/// \brief Ecrit une planche (atlas) de nb QRcodes rangés sur une grille de colonnes cases par ligne, dans un seul fichier PGM ou PBM
+///        le fichier est créé a sa taille finale (ftruncate) puis projeté en memoire (mmap) : les threads dessinent leurs cases
+///        directement dans le fichier, sans image intermédiaire. sous Windows, la planche est préparée en memoire puis ecrite en une fois.
+/// \param[in] filename : le nom du fichier (extension .pgm ou .pbm)
+/// \param[in] qrcodes[nb] : les QRcodes (versions mélangées possibles, les plus petits sont centrés dans leur case)
+/// \param[in] nb : nombre de QRcodes
+/// \param[in] colonnes : nombre de cases par ligne
+/// \param[in] format : FORMAT_PGM ou FORMAT_PBM
+/// \param[in] echelle : largeur en pixels d'un module (1 ou plus)
+/// \param[in] zone_blanche : largeur en modules de la marge blanche autour du plus grand QRcode (ZONE_BLANCHE pour un microQR)
+/// \param[in] nb_threads : nombre de threads (0 = un par coeur)
+/// \return 0, -1 si les parametres sont invalides ou en cas d'erreur de fichier
+int atlas_QRcode(const char *filename, const QRcode_t *qrcodes, int nb, int colonnes,
+                 int format, int echelle, int zone_blanche, int nb_threads)
+{
+    QRatlas_t atlas;
+    QRcode_t modele;
+    char entete[64];                    // "P5\n" + 2 nombres de 20 chiffres au plus + "\n255\n"
+    int taille_entete, lignes, k, erreur;
+    long long largeur, hauteur, taille;
+    unsigned char *fichier;
+#ifndef _WIN32
+    int fd;
+#endif
+
+    if(nb <= 0 || colonnes <= 0 || (format != FORMAT_PGM && format != FORMAT_PBM))
+    {
+        return -1;
+    }
+    atlas.nb_module_max = NB_MODULE_M1;
+    for(k=0; k<nb; k++)
+    {
+        if(qrcodes[k].nb_module > atlas.nb_module_max)
+        {
+            atlas.nb_module_max = qrcodes[k].nb_module;
+        }
+    }
+    modele.nb_module = atlas.nb_module_max;
+    atlas.cellule = largeur_image(&modele, echelle, zone_blanche);
+    if(atlas.cellule < 0)
+    {
+        return -1;
+    }
+    if(colonnes > nb)
+    {
+        colonnes = nb;
+    }
+    lignes = (nb + colonnes - 1) / colonnes;
+    atlas.qrcodes = qrcodes;
+    atlas.nb = nb;
+    atlas.colonnes = colonnes;
+    atlas.echelle = echelle;
+    atlas.zone_blanche = zone_blanche;
+    atlas.format_pixel = (format == FORMAT_PBM) ? PIXEL_1BIT : PIXEL_GRIS8;
+    atlas.pas_colonne = (format == FORMAT_PBM) ? (atlas.cellule + 7) & ~7 : atlas.cellule;
+    largeur = (long long)colonnes * atlas.pas_colonne;
+    hauteur = (long long)lignes * atlas.cellule;
+    if(largeur > 0x7FFFFFF || hauteur > 0x7FFFFFF)
+    {
+        return -1;
+    }
+    atlas.pas = (int)((format == FORMAT_PBM) ? (largeur + 7) / 8 : largeur);
+    if(format == FORMAT_PBM)
+    {
+        taille_entete = sprintf(entete, "P4\n%lld %lld\n", largeur, hauteur);
+    }
+    else
+    {
+        taille_entete = sprintf(entete, "P5\n%lld %lld\n255\n", largeur, hauteur);
+    }
+    taille = taille_entete + (long long)atlas.pas * hauteur;
+    if((unsigned long long)taille > (size_t)-1)
+    {
+        return -1;
+    }
+
+#ifdef _WIN32
+    if(taille > INT_MAX)                    // ecrit_fichier_image ecrit au plus INT_MAX octets
+    {
+        return -1;
+    }
+    fichier = calloc((size_t)taille, 1);
+    if(fichier == NULL)
+    {
+        return -1;
+    }
+#else
+    fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0)
+    {
+        fprintf(stderr,"atlas_QRcode, erreur de création du fichier %s\n",filename);
+        return -1;
+    }
+    if(ftruncate(fd, (off_t)taille) != 0 ||
+       (fichier = mmap(NULL, (size_t)taille, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED)
+    {
+        close(fd);
+        return -1;
+    }
+#endif
+    memcpy(fichier, entete, taille_entete);
+    atlas.pixels = fichier + taille_entete;
+    erreur = parallele_pour(lignes * colonnes, nb_threads, tache_atlas, &atlas);
+
+#ifdef _WIN32
+    if(erreur == 0)
+    {
+        erreur = ecrit_fichier_image(filename, fichier, (int)taille);
+    }
+    free(fichier);
+#else
+    erreur |= munmap(fichier, (size_t)taille);
+    erreur |= close(fd);
+#endif
+    return (erreur != 0) ? -1 : 0;
+}
+
+// ////////////////////////// EXPORT PNG ////////////////////////////////
+// PNG en niveaux de gris sur 1 bit (0 = noir, 1 = blanc), sans bibliotheque externe :
+// CRC32 par tranches de 8 octets (slice-by-8), zlib avec un deflate a codes de Huffman fixes
+// et un LZ77 glouton a petite fenetre. apres le filtre Up, les lignes de pixels répétées (echelle fois
+// chaque ligne de modules) ne contiennent plus que des 0 : elles se codent en quelques correspondances.
+
+#define FENETRE_LZ77     4096       /** distance maximale d'une correspondance LZ77 (octets, puissance de 2) */
+#define BITS_HACHAGE     12         /** taille de la table de hachage des triplets : 2^BITS_HACHAGE   */
+#define CHAINE_MAX       8          /** nombre maximal de candidats examinés par position             */
+
+static uint32_t table_crc32[8][256];           /** table_crc32[k][n] : CRC de l'octet n suivi de k octets nuls */
+static uint16_t code_litteral[289];            /** codes de Huffman fixes des littéraux/longueurs (bits inversés) */
+static unsigned char longueur_litteral[289];   /** nombre de bits de ces codes                                  */
+static unsigned char code_longueur[256];       /** code 0..28 d'une longueur de correspondance 3..258 (indice longueur-3) */
+static unsigned char code_distance[512];       /** code 0..29 d'une distance (voir distance_to_code)            */
+static pthread_once_t tables_png_pretes = PTHREAD_ONCE_INIT;
+
+static const unsigned short base_longueur[29] = { 3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258 };
+static const unsigned char  extra_longueur[29] = { 0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0 };
+static const unsigned short base_distance[30]  = { 1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,
+                                                    1025,1537,2049,3073,4097,6145,8193,12289,16385,24577 };
+static const unsigned char  extra_distance[30] = { 0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13 };
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static unsigned int inverse_bits(unsigned int code, int nb)
+/// \brief inverse l'ordre des nb bits de poids faible de code (deflate ecrit les codes de Huffman poids fort en premier)
+static unsigned int inverse_bits(unsigned int code, int nb)
+{
+    unsigned int inverse = 0;
+    while(nb-- > 0)
+    {
+        inverse = (inverse << 1) | (code & 1);
+        code >>= 1;
+    }
+    return inverse;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void construit_tables_png(void)
+/// \brief construit (une seule fois, meme avec plusieurs threads : voir pthread_once) les tables du CRC32 et du deflate
+static void construit_tables_png(void)
+{
+    uint32_t c;
+    int n, k, code;
+
+    for(n=0; n<256; n++)
+    {
+        c = n;
+        for(k=0; k<8; k++)
+        {
+            c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+        }
+        table_crc32[0][n] = c;
+    }
+    for(n=0; n<256; n++)
+    {
+        for(k=1; k<8; k++)
+        {
+            table_crc32[k][n] = (table_crc32[k-1][n] >> 8) ^ table_crc32[0][table_crc32[k-1][n] & 0xFF];
+        }
+    }
+    // codes de Huffman fixes (RFC 1951 3.2.6)
+    for(n=0; n<=287; n++)
+    {
+        if(n <= 143)      { code = 0x30 + n;          k = 8; }
+        else if(n <= 255) { code = 0x190 + n - 144;   k = 9; }
+        else if(n <= 279) { code = n - 256;           k = 7; }
+        else              { code = 0xC0 + n - 280;    k = 8; }
+        code_litteral[n] = (uint16_t)inverse_bits(code, k);
+        longueur_litteral[n] = (unsigned char)k;
+    }
+    for(code=0; code<29; code++)
+    {
+        for(n=base_longueur[code]; n<base_longueur[code] + (1 << extra_longueur[code]) && n<=258; n++)
+        {
+            code_longueur[n-3] = (unsigned char)code;
+        }
+    }
+    for(code=0; code<30; code++)
+    {
+        for(n=base_distance[code]; n<base_distance[code] + (1 << extra_distance[code]); n++)
+        {
+            if(n <= 256)
+            {
+                code_distance[n-1] = (unsigned char)code;
+            }
+            else
+            {
+                code_distance[256 + ((n-1) >> 7)] = (unsigned char)code;
+            }
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static uint32_t crc32_png(uint32_t crc, const unsigned char *octets, size_t nb)
+/// \brief CRC32 (polynome 0x04C11DB7 réfléchi) des nb octets, poursuivant crc ; 8 octets par itération (slice-by-8)
+static uint32_t crc32_png(uint32_t crc, const unsigned char *octets, size_t nb)
+{
+    uint32_t a, b;
+
+    crc = ~crc;
+    while(nb >= 8)
+    {
+        a = crc ^ (octets[0] | (octets[1] << 8) | (octets[2] << 16) | ((uint32_t)octets[3] << 24));
+        b = octets[4] | (octets[5] << 8) | (octets[6] << 16) | ((uint32_t)octets[7] << 24);
+        crc = table_crc32[7][a & 0xFF] ^ table_crc32[6][(a >> 8) & 0xFF] ^ table_crc32[5][(a >> 16) & 0xFF] ^ table_crc32[4][a >> 24]
+            ^ table_crc32[3][b & 0xFF] ^ table_crc32[2][(b >> 8) & 0xFF] ^ table_crc32[1][(b >> 16) & 0xFF] ^ table_crc32[0][b >> 24];
+        octets += 8;
+        nb -= 8;
+    }
+    while(nb-- > 0)
+    {
+        crc = table_crc32[0][(crc ^ *octets++) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static uint32_t adler32_png(const unsigned char *octets, size_t nb)
+/// \brief somme de controle Adler-32 de la fin d'un flux zlib
+static uint32_t adler32_png(const unsigned char *octets, size_t nb)
+{
+    uint32_t s1 = 1, s2 = 0;
+    size_t bloc;
+
+    while(nb > 0)
+    {
+        bloc = (nb < 5552) ? nb : 5552;     // plus grand bloc sans debordement de s2 sur 32 bits
+        nb -= bloc;
+        while(bloc-- > 0)
+        {
+            s1 += *octets++;
+            s2 += s1;
+        }
+        s1 %= 65521;
+        s2 %= 65521;
+    }
+    return (s2 << 16) | s1;
+}
+
+// flux de bits deflate : poids faible en premier
+typedef struct
+{
+    unsigned char *sortie;
+    size_t nb;                  /** nombre d'octets ecrits (ou qui l'auraient été)   */
+    size_t max;                 /** taille de sortie                                 */
+    uint64_t accumulateur;
+    int nb_bits;                /** nombre de bits dans l'accumulateur              */
+} QRdeflate_t;
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void ecrit_bits_deflate(QRdeflate_t *deflate, uint32_t valeur, int nb)
+/// \brief ajoute nb bits (poids faible en premier) au flux deflate ; au-dela de max, les octets sont comptés mais pas ecrits
+static void ecrit_bits_deflate(QRdeflate_t *deflate, uint32_t valeur, int nb)
+{
+    deflate->accumulateur |= (uint64_t)valeur << deflate->nb_bits;
+    deflate->nb_bits += nb;
+    while(deflate->nb_bits >= 8)
+    {
+        if(deflate->nb < deflate->max)
+        {
+            deflate->sortie[deflate->nb] = (unsigned char)deflate->accumulateur;
+        }
+        deflate->nb++;
+        deflate->accumulateur >>= 8;
+        deflate->nb_bits -= 8;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static uint32_t hache_triplet(const unsigned char *octets)
+/// \brief hachage des 3 octets a partir de octets (BITS_HACHAGE bits)
+static uint32_t hache_triplet(const unsigned char *octets)
+{
+    return (((uint32_t)octets[0] << 16 | (uint32_t)octets[1] << 8 | octets[2]) * 2654435761u) >> (32 - BITS_HACHAGE);
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static size_t deflate_fixe(const unsigned char *donnees, int nb, unsigned char *sortie, size_t max)
+/// \brief compresse nb octets en un seul bloc deflate a codes de Huffman fixes, avec un LZ77 glouton :
+///        pour chaque position, au plus CHAINE_MAX positions précédentes de meme hachage (a moins de FENETRE_LZ77 octets) sont essayées
+///        (le chainage des positions est circulaire : un maillon périmé donne au pire un candidat moins bon, les octets sont toujours comparés)
+/// \param[in]  donnees[nb] : les octets a compresser
+/// \param[out] sortie[max] : le bloc deflate
+/// \return taille du bloc deflate (plus grande que max si sortie est trop petite)
+static size_t deflate_fixe(const unsigned char *donnees, int nb, unsigned char *sortie, size_t max)
+{
+    QRdeflate_t deflate = { sortie, 0, max, 0, 0 };
+    int tete[1 << BITS_HACHAGE];
+    int precedent[FENETRE_LZ77];
+    uint64_t mot_i, mot_j;
+    int i, j, k, h, chaine, longueur, distance, meilleure_longueur, meilleure_distance, code, limite;
+
+    memset(tete, 0xFF, sizeof(tete));       // -1 : aucune position
+    ecrit_bits_deflate(&deflate, 1, 1);     // BFINAL : dernier bloc
+    ecrit_bits_deflate(&deflate, 1, 2);     // BTYPE = 01 : codes de Huffman fixes
+    for(i=0; i<nb; )
+    {
+        meilleure_longueur = 0;
+        meilleure_distance = 0;
+        if(i + 3 <= nb)
+        {
+            h = hache_triplet(donnees + i);
+            limite = (nb - i < 258) ? nb - i : 258;
+            for(j=tete[h], chaine=CHAINE_MAX; j>=0 && i-j<=FENETRE_LZ77 && chaine>0; j=precedent[j & (FENETRE_LZ77-1)], chaine--)
+            {
+                for(longueur=0; longueur+8<=limite; longueur+=8)        // 8 octets a la fois, puis octet par octet
+                {
+                    memcpy(&mot_j, donnees + j + longueur, 8);
+                    memcpy(&mot_i, donnees + i + longueur, 8);
+                    if(mot_j != mot_i)
+                    {
+                        break;
+                    }
+                }
+                for(; longueur<limite && donnees[j+longueur]==donnees[i+longueur]; longueur++);
+                if(longueur > meilleure_longueur)
+                {
+                    meilleure_longueur = longueur;
+                    meilleure_distance = i - j;
+                    if(longueur == limite)
+                    {
+                        break;
+                    }
+                }
+            }
+            precedent[i & (FENETRE_LZ77-1)] = tete[h];
+            tete[h] = i;
+        }
+        if(meilleure_longueur >= 3)
+        {
+            code = code_longueur[meilleure_longueur - 3];
+            ecrit_bits_deflate(&deflate, code_litteral[257 + code], longueur_litteral[257 + code]);
+            ecrit_bits_deflate(&deflate, meilleure_longueur - base_longueur[code], extra_longueur[code]);
+            distance = meilleure_distance;
+            code = (distance <= 256) ? code_distance[distance-1] : code_distance[256 + ((distance-1) >> 7)];
+            ecrit_bits_deflate(&deflate, inverse_bits(code, 5), 5);
+            ecrit_bits_deflate(&deflate, distance - base_distance[code], extra_distance[code]);
+            // les positions couvertes par une correspondance courte entrent aussi dans la table de hachage
+            // (pour une longue suite d'octets nuls, c'est inutile et ce serait le plus couteux de la compression)
+            for(k=i+1; meilleure_longueur<=32 && k<i+meilleure_longueur && k+3<=nb; k++)
+            {
+                h = hache_triplet(donnees + k);
+                precedent[k & (FENETRE_LZ77-1)] = tete[h];
+                tete[h] = k;
+            }
+            i += meilleure_longueur;
+        }
+        else
+        {
+            ecrit_bits_deflate(&deflate, code_litteral[donnees[i]], longueur_litteral[donnees[i]]);
+            i++;
+        }
+    }
+    ecrit_bits_deflate(&deflate, code_litteral[256], longueur_litteral[256]);     // fin de bloc
+    ecrit_bits_deflate(&deflate, 0, 7);                                            // complete le dernier octet
+    return deflate.nb;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void ecrit_32bits_png(unsigned char *octets, uint32_t valeur)
+/// \brief ecrit un entier de 32 bits, poids fort en tete (ordre des octets du PNG et de zlib)
+static void ecrit_32bits_png(unsigned char *octets, uint32_t valeur)
+{
+    octets[0] = (unsigned char)(valeur >> 24);
+    octets[1] = (unsigned char)(valeur >> 16);
+    octets[2] = (unsigned char)(valeur >> 8);
+    octets[3] = (unsigned char)valeur;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static int taille_max_png(const QRcode_t *qrcode, int echelle, int zone_blanche)
+/// \brief taille maximale d'un PNG (les codes fixes font au plus 9 bits par octet), -1 si les parametres sont invalides
+static int taille_max_png(const QRcode_t *qrcode, int echelle, int zone_blanche)
+{
+    int largeur = largeur_image(qrcode, echelle, zone_blanche);
+
+    return (largeur < 0) ? -1 : 128 + ((largeur + 7) / 8 + 1) * largeur * 9 / 8;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_png_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+/// \brief Ecrit le PNG (niveaux de gris sur 1 bit) d'un QRcode dans un tableau
+///        les lignes sont dessinées (QRcode_to_page) directement a leur place dans les données filtrées, puis filtrées sur place
+///        par None ou Up (celui qui donne le moins d'octets non nuls), de la derniere a la premiere ; le tout est compressé par deflate_fixe
+/// \param[in]  qrcode le QRcode
+/// \param[in]  echelle : largeur en pixels d'un module (1 ou plus)
+/// \param[in]  zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \param[out] image : le tableau ou ecrire le PNG
+/// \param[in]  taille_max : taille du tableau
+/// \return nombre d'octets ecrits, -1 si le tableau est trop petit, les parametres invalides ou en cas d'erreur d'allocation
+int QRcode_to_png_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+{
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    int largeur = largeur_image(qrcode, echelle, zone_blanche);
+    int octets_ligne, nb_filtres, y, x, nb_none, nb_up;
+    unsigned char *filtres, *ligne, *dessus;
+    size_t taille_deflate;
+    int position, resultat = -1;
+
+    if(largeur < 0 || taille_max < 8 + 25 + 12 + 6 + 12)
+    {
+        return -1;
+    }
+    pthread_once(&tables_png_pretes, construit_tables_png);
+    octets_ligne = (largeur + 7) / 8;
+    nb_filtres = (octets_ligne + 1) * largeur;              // un octet de type de filtre par ligne
+    filtres = calloc(nb_filtres, 1);
+    if(filtres == NULL)
+    {
+        return -1;
+    }
+    // en PNG gris 1 bit, 0 = noir : on dessine en PIXEL_1BIT (1 = noir) puis on inverse
+    QRcode_to_page(qrcode, filtres + 1, largeur, largeur, octets_ligne + 1, PIXEL_1BIT, 0, 0, echelle, zone_blanche);
+    for(y=0; y<largeur; y++)
+    {
+        ligne = filtres + (size_t)y * (octets_ligne + 1) + 1;
+        for(x=0; x<octets_ligne; x++)
+        {
+            ligne[x] = ~ligne[x];
+        }
+    }
+    // filtrage en partant du bas : la ligne du dessus n'est pas encore filtrée
+    for(y=largeur-1; y>0; y--)
+    {
+        ligne = filtres + (size_t)y * (octets_ligne + 1) + 1;
+        dessus = ligne - (octets_ligne + 1);
+        for(x=0, nb_up=0, nb_none=0; x<octets_ligne; x++)
+        {
+            nb_none += (ligne[x] != 0);
+            nb_up   += (ligne[x] != dessus[x]);
+        }
+        if(nb_up < nb_none)
+        {
+            ligne[-1] = 2;                                  // filtre Up : différence avec la ligne du dessus
+            for(x=0; x<octets_ligne; x++)
+            {
+                ligne[x] -= dessus[x];
+            }
+        }
+    }
+
+    // signature et IHDR : largeur, hauteur, 1 bit, niveaux de gris, deflate, filtres standards, non entrelacé
+    memcpy(image, signature, 8);
+    ecrit_32bits_png(image + 8, 13);
+    memcpy(image + 12, "IHDR", 4);
+    ecrit_32bits_png(image + 16, largeur);
+    ecrit_32bits_png(image + 20, largeur);
+    image[24] = 1;
+    image[25] = 0;
+    image[26] = 0;
+    image[27] = 0;
+    image[28] = 0;
+    ecrit_32bits_png(image + 29, crc32_png(0, image + 12, 17));
+    position = 33;
+
+    // IDAT : entete zlib (deflate, fenetre de 32 Ko), bloc deflate, Adler-32
+    memcpy(image + position + 4, "IDAT", 4);
+    image[position + 8] = 0x78;
+    image[position + 9] = 0x01;
+    taille_deflate = deflate_fixe(filtres, nb_filtres, image + position + 10, taille_max - position - 10 - 4 - 4 - 12);
+    if(taille_deflate <= (size_t)(taille_max - position - 10 - 4 - 4 - 12))
+    {
+        ecrit_32bits_png(image + position + 10 + taille_deflate, adler32_png(filtres, nb_filtres));
+        ecrit_32bits_png(image + position, (uint32_t)(2 + taille_deflate + 4));
+        ecrit_32bits_png(image + position + 10 + taille_deflate + 4, crc32_png(0, image + position + 4, 4 + 2 + taille_deflate + 4));
+        position += 4 + 4 + 2 + (int)taille_deflate + 4 + 4;
+        // IEND
+        ecrit_32bits_png(image + position, 0);
+        memcpy(image + position + 4, "IEND", 4);
+        ecrit_32bits_png(image + position + 8, crc32_png(0, image + position + 4, 4));
+        resultat = position + 12;
+    }
+    free(filtres);
+    return resultat;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_png(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche)
+/// \brief Fonction d'export en PNG (niveaux de gris sur 1 bit), lisible par tous les visualiseurs d'images
+/// \param[in] qrcode le QRcode
+/// \param[in] *filename : le nom du fichier image (avec extension .png)
+/// \param[in] echelle : largeur en pixels d'un module (1 ou plus)
+/// \param[in] zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \return 0, -1 si les parametres sont invalides ou si l'ecriture a echoué
+int QRcode_to_png(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche)
+{
+    unsigned char *image;
+    int taille_max = taille_max_png(qrcode, echelle, zone_blanche);
+    int taille, resultat = -1;
+
+    if(taille_max < 0 || (image = malloc(taille_max)) == NULL)
+    {
+        return -1;
+    }
+    taille = QRcode_to_png_memoire(qrcode, echelle, zone_blanche, image, taille_max);
+    if(taille >= 0)
+    {
+        resultat = ecrit_fichier_image(filename, image, taille);
+    }
+    free(image);
+    return resultat;
+}
+
+// ////////////////////////// EXPORT TIFF G4 ////////////////////////////////
+// TIFF bilevel compressé en CCITT groupe 4 (T.6) : chaque ligne de pixels est codée par rapport a la précédente
+// a partir de ses changements de couleur. ces changements se déduisent directement des modules (marge + j*echelle),
+// sans dessiner l'image ; les echelle lignes d'une meme ligne de modules sont identiques et se codent en 1 bit par changement.
+
+#define TAILLE_IFD_TIFF  (2 + 12*12 + 4 + 2*8)      /** 12 entrées, IFD suivant, XResolution et YResolution */
+#define DPI_TIFF         72                         /** résolution indiquée dans le fichier (points par pouce) */
+
+typedef struct
+{
+    uint16_t code;              /** code, aligné sur le poids faible */
+    unsigned char nb;           /** nombre de bits du code           */
+} QRcode_g4_t;
+
+// codes de Huffman modifiés (T.4) des longueurs de plage 0..63, par couleur (0 = blanc, 1 = noir)
+static const QRcode_g4_t code_terminaison[2][64] =
+{
+    {   // blanc
+        { 0x035,  8 }, { 0x007,  6 }, { 0x007,  4 }, { 0x008,  4 }, { 0x00B,  4 }, { 0x00C,  4 }, { 0x00E,  4 }, { 0x00F,  4 },
+        { 0x013,  5 }, { 0x014,  5 }, { 0x007,  5 }, { 0x008,  5 }, { 0x008,  6 }, { 0x003,  6 }, { 0x034,  6 }, { 0x035,  6 },
+        { 0x02A,  6 }, { 0x02B,  6 }, { 0x027,  7 }, { 0x00C,  7 }, { 0x008,  7 }, { 0x017,  7 }, { 0x003,  7 }, { 0x004,  7 },
+        { 0x028,  7 }, { 0x02B,  7 }, { 0x013,  7 }, { 0x024,  7 }, { 0x018,  7 }, { 0x002,  8 }, { 0x003,  8 }, { 0x01A,  8 },
+        { 0x01B,  8 }, { 0x012,  8 }, { 0x013,  8 }, { 0x014,  8 }, { 0x015,  8 }, { 0x016,  8 }, { 0x017,  8 }, { 0x028,  8 },
+        { 0x029,  8 }, { 0x02A,  8 }, { 0x02B,  8 }, { 0x02C,  8 }, { 0x02D,  8 }, { 0x004,  8 }, { 0x005,  8 }, { 0x00A,  8 },
+        { 0x00B,  8 }, { 0x052,  8 }, { 0x053,  8 }, { 0x054,  8 }, { 0x055,  8 }, { 0x024,  8 }, { 0x025,  8 }, { 0x058,  8 },
+        { 0x059,  8 }, { 0x05A,  8 }, { 0x05B,  8 }, { 0x04A,  8 }, { 0x04B,  8 }, { 0x032,  8 }, { 0x033,  8 }, { 0x034,  8 }
+    },
+    {   // noir
+        { 0x037, 10 }, { 0x002,  3 }, { 0x003,  2 }, { 0x002,  2 }, { 0x003,  3 }, { 0x003,  4 }, { 0x002,  4 }, { 0x003,  5 },
+        { 0x005,  6 }, { 0x004,  6 }, { 0x004,  7 }, { 0x005,  7 }, { 0x007,  7 }, { 0x004,  8 }, { 0x007,  8 }, { 0x018,  9 },
+        { 0x017, 10 }, { 0x018, 10 }, { 0x008, 10 }, { 0x067, 11 }, { 0x068, 11 }, { 0x06C, 11 }, { 0x037, 11 }, { 0x028, 11 },
+        { 0x017, 11 }, { 0x018, 11 }, { 0x0CA, 12 }, { 0x0CB, 12 }, { 0x0CC, 12 }, { 0x0CD, 12 }, { 0x068, 12 }, { 0x069, 12 },
+        { 0x06A, 12 }, { 0x06B, 12 }, { 0x0D2, 12 }, { 0x0D3, 12 }, { 0x0D4, 12 }, { 0x0D5, 12 }, { 0x0D6, 12 }, { 0x0D7, 12 },
+        { 0x06C, 12 }, { 0x06D, 12 }, { 0x0DA, 12 }, { 0x0DB, 12 }, { 0x054, 12 }, { 0x055, 12 }, { 0x056, 12 }, { 0x057, 12 },
+        { 0x064, 12 }, { 0x065, 12 }, { 0x052, 12 }, { 0x053, 12 }, { 0x024, 12 }, { 0x037, 12 }, { 0x038, 12 }, { 0x027, 12 },
+        { 0x028, 12 }, { 0x058, 12 }, { 0x059, 12 }, { 0x02B, 12 }, { 0x02C, 12 }, { 0x05A, 12 }, { 0x066, 12 }, { 0x067, 12 }
+    }
+};
+static const QRcode_g4_t code_complement[2][40] =
+{
+    {   // blanc : 64 ... 1728, puis 1792 ... 2560 (communs)
+        { 0x01B,  5 }, { 0x012,  5 }, { 0x017,  6 }, { 0x037,  7 }, { 0x036,  8 }, { 0x037,  8 }, { 0x064,  8 }, { 0x065,  8 },
+        { 0x068,  8 }, { 0x067,  8 }, { 0x0CC,  9 }, { 0x0CD,  9 }, { 0x0D2,  9 }, { 0x0D3,  9 }, { 0x0D4,  9 }, { 0x0D5,  9 },
+        { 0x0D6,  9 }, { 0x0D7,  9 }, { 0x0D8,  9 }, { 0x0D9,  9 }, { 0x0DA,  9 }, { 0x0DB,  9 }, { 0x098,  9 }, { 0x099,  9 },
+        { 0x09A,  9 }, { 0x018,  6 }, { 0x09B,  9 }, { 0x008, 11 }, { 0x00C, 11 }, { 0x00D, 11 }, { 0x012, 12 }, { 0x013, 12 },
+        { 0x014, 12 }, { 0x015, 12 }, { 0x016, 12 }, { 0x017, 12 }, { 0x01C, 12 }, { 0x01D, 12 }, { 0x01E, 12 }, { 0x01F, 12 }
+    },
+    {   // noir
+        { 0x00F, 10 }, { 0x0C8, 12 }, { 0x0C9, 12 }, { 0x05B, 12 }, { 0x033, 12 }, { 0x034, 12 }, { 0x035, 12 }, { 0x06C, 13 },
+        { 0x06D, 13 }, { 0x04A, 13 }, { 0x04B, 13 }, { 0x04C, 13 }, { 0x04D, 13 }, { 0x072, 13 }, { 0x073, 13 }, { 0x074, 13 },
+        { 0x075, 13 }, { 0x076, 13 }, { 0x077, 13 }, { 0x052, 13 }, { 0x053, 13 }, { 0x054, 13 }, { 0x055, 13 }, { 0x05A, 13 },
+        { 0x05B, 13 }, { 0x064, 13 }, { 0x065, 13 }, { 0x008, 11 }, { 0x00C, 11 }, { 0x00D, 11 }, { 0x012, 12 }, { 0x013, 12 },
+        { 0x014, 12 }, { 0x015, 12 }, { 0x016, 12 }, { 0x017, 12 }, { 0x01C, 12 }, { 0x01D, 12 }, { 0x01E, 12 }, { 0x01F, 12 }
+    }
+};
+// codes du mode vertical, indexés par a1-b1+3 : VL3 VL2 VL1 V0 VR1 VR2 VR3
+static const QRcode_g4_t code_vertical[7] = { { 0x02, 7 }, { 0x02, 6 }, { 0x02, 3 }, { 0x01, 1 }, { 0x03, 3 }, { 0x03, 6 }, { 0x03, 7 } };
+
+// flux de bits G4 : poids fort en premier (FillOrder = 1)
+typedef struct
+{
+    unsigned char *sortie;
+    size_t nb;                  /** nombre d'octets ecrits (ou qui l'auraient été)   */
+    size_t max;                 /** taille de sortie                                 */
+    uint32_t accumulateur;
+    int nb_bits;                /** nombre de bits dans l'accumulateur (< 8 entre deux appels) */
+} QRg4_t;
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void ecrit_bits_g4(QRg4_t *g4, uint32_t valeur, int nb)
+/// \brief ajoute nb bits (24 au plus, poids fort en premier) au flux G4 ; au-dela de max, les octets sont comptés mais pas ecrits
+static void ecrit_bits_g4(QRg4_t *g4, uint32_t valeur, int nb)
+{
+    g4->accumulateur = (g4->accumulateur << nb) | valeur;
+    g4->nb_bits += nb;
+    while(g4->nb_bits >= 8)
+    {
+        g4->nb_bits -= 8;
+        if(g4->nb < g4->max)
+        {
+            g4->sortie[g4->nb] = (unsigned char)(g4->accumulateur >> g4->nb_bits);
+        }
+        g4->nb++;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void ecrit_plage_g4(QRg4_t *g4, int longueur, int couleur)
+/// \brief code une plage de longueur pixels de la couleur donnée (0 = blanc, 1 = noir) : codes complémentaires puis terminaison
+static void ecrit_plage_g4(QRg4_t *g4, int longueur, int couleur)
+{
+    const QRcode_g4_t *code;
+
+    while(longueur >= 2560 + 64)
+    {
+        code = &code_complement[couleur][39];
+        ecrit_bits_g4(g4, code->code, code->nb);
+        longueur -= 2560;
+    }
+    if(longueur >= 64)
+    {
+        code = &code_complement[couleur][longueur/64 - 1];
+        ecrit_bits_g4(g4, code->code, code->nb);
+        longueur &= 63;
+    }
+    code = &code_terminaison[couleur][longueur];
+    ecrit_bits_g4(g4, code->code, code->nb);
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static int changements_g4(const QRcode_t *qrcode, int i, int echelle, int zone_blanche, int largeur, int *changements)
+/// \brief positions (en pixels) des changements de couleur d'une ligne de pixels de la ligne de modules i
+///        (i hors du QRcode : zone blanche, aucun changement), suivies de 3 fois largeur (fin de ligne)
+/// \return nombre de changements
+static int changements_g4(const QRcode_t *qrcode, int i, int echelle, int zone_blanche, int largeur, int *changements)
+{
+    int marge = zone_blanche * echelle;
+    int j, n = 0, noir = 0;
+
+    if(i >= 0 && i < qrcode->nb_module)
+    {
+        for(j=0; j<qrcode->nb_module; j++)
+        {
+            if((qrcode->module[i][j] != BLANC) != noir)
+            {
+                changements[n++] = marge + j*echelle;
+                noir = !noir;
+            }
+        }
+        if(noir && zone_blanche > 0)
+        {
+            changements[n++] = marge + qrcode->nb_module*echelle;
+        }
+    }
+    changements[n] = changements[n+1] = changements[n+2] = largeur;
+    return n;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void code_ligne_g4(QRg4_t *g4, const int *reference, const int *ligne, int largeur)
+/// \brief code une ligne de pixels (ses changements) par rapport a la ligne de référence (T.6) :
+///        mode passant si b2 est avant a1, mode vertical si |a1-b1| <= 3, sinon mode horizontal (deux plages)
+static void code_ligne_g4(QRg4_t *g4, const int *reference, const int *ligne, int largeur)
+{
+    int a0 = -1, a1, a2, b1, b2, ia = 0, ib = 0, couleur = 0;
+
+    while(a0 < largeur)
+    {
+        while(ligne[ia] <= a0)
+        {
+            ia++;
+        }
+        a1 = ligne[ia];
+        // b1 : premier changement de la référence après a0 vers la couleur opposée a celle de a0 (indice pair : vers le noir)
+        // en mode vertical, a0 peut reculer sous l'ancien b1 : on repart un changement plus tot
+        ib = (ib > 0) ? ib - 1 : 0;
+        while(reference[ib] <= a0 || (ib & 1) != couleur)
+        {
+            ib++;
+        }
+        b1 = reference[ib];
+        b2 = reference[ib+1];
+        if(b2 < a1)
+        {
+            ecrit_bits_g4(g4, 0x1, 4);              // mode passant : 0001
+            a0 = b2;
+        }
+        else if(a1 - b1 >= -3 && a1 - b1 <= 3)
+        {
+            ecrit_bits_g4(g4, code_vertical[a1-b1+3].code, code_vertical[a1-b1+3].nb);
+            a0 = a1;
+            couleur ^= 1;
+        }
+        else
+        {
+            a2 = ligne[ia+1];
+            ecrit_bits_g4(g4, 0x1, 3);              // mode horizontal : 001, plages a0a1 et a1a2
+            ecrit_plage_g4(g4, a1 - (a0 < 0 ? 0 : a0), couleur);
+            ecrit_plage_g4(g4, a2 - a1, couleur ^ 1);
+            a0 = a2;
+        }
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static size_t code_g4(const QRcode_t *qrcode, int echelle, int zone_blanche, int largeur, unsigned char *sortie, size_t max)
+/// \brief code l'image d'un QRcode en G4 (EOFB compris) ; la premiere ligne est codée par rapport a une ligne blanche.
+///        une ligne identique a la précédente (dans une ligne de modules) se code sans recherche : un V0 par changement et un pour la fin
+/// \return taille des données G4 (plus grande que max si sortie est trop petite)
+static size_t code_g4(const QRcode_t *qrcode, int echelle, int zone_blanche, int largeur, unsigned char *sortie, size_t max)
+{
+    QRg4_t g4 = { sortie, 0, max, 0, 0 };
+    int changements[2][NB_MODULE_MAX + 4];
+    int *reference = changements[0], *ligne = changements[1], *echange;
+    int i, k, n, reste;
+
+    changements_g4(qrcode, -1, echelle, zone_blanche, largeur, reference);
+    for(i=-zone_blanche; i<qrcode->nb_module+zone_blanche; i++)
+    {
+        n = changements_g4(qrcode, i, echelle, zone_blanche, largeur, ligne);
+        code_ligne_g4(&g4, reference, ligne, largeur);
+        for(k=1; k<echelle; k++)
+        {
+            for(reste=n+1; reste>0; reste-=24)
+            {
+                ecrit_bits_g4(&g4, (reste < 24) ? (1u << reste) - 1 : 0xFFFFFF, (reste < 24) ? reste : 24);
+            }
+        }
+        echange = reference;
+        reference = ligne;
+        ligne = echange;
+    }
+    ecrit_bits_g4(&g4, 0x001001, 24);              // EOFB : deux EOL
+    ecrit_bits_g4(&g4, 0, 7);                      // complete le dernier octet
+    return g4.nb;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void ecrit_32bits_tiff(unsigned char *octets, uint32_t valeur)
+/// \brief ecrit un entier de 32 bits, poids faible en tete (TIFF "II")
+static void ecrit_32bits_tiff(unsigned char *octets, uint32_t valeur)
+{
+    octets[0] = (unsigned char)valeur;
+    octets[1] = (unsigned char)(valeur >> 8);
+    octets[2] = (unsigned char)(valeur >> 16);
+    octets[3] = (unsigned char)(valeur >> 24);
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void ecrit_entree_tiff(unsigned char *entree, int etiquette, int type, uint32_t valeur)
+/// \brief ecrit une entrée d'IFD a une seule valeur (type 3 = SHORT, 4 = LONG, 5 = RATIONAL : valeur est alors l'offset)
+static void ecrit_entree_tiff(unsigned char *entree, int etiquette, int type, uint32_t valeur)
+{
+    entree[0] = (unsigned char)etiquette;
+    entree[1] = (unsigned char)(etiquette >> 8);
+    entree[2] = (unsigned char)type;
+    entree[3] = 0;
+    ecrit_32bits_tiff(entree + 4, 1);
+    ecrit_32bits_tiff(entree + 8, valeur);          // un SHORT est cadré a gauche : poids faible en tete, c'est la meme chose
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_tiff_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+/// \brief Ecrit le TIFF (1 bit par pixel, compression CCITT groupe 4) d'un QRcode dans un tableau
+///        entete, une seule bande de données G4, puis l'IFD
+/// \param[in]  qrcode le QRcode
+/// \param[in]  echelle : largeur en pixels d'un module (1 ou plus)
+/// \param[in]  zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \param[out] image : le tableau ou ecrire le TIFF
+/// \param[in]  taille_max : taille du tableau
+/// \return nombre d'octets ecrits, -1 si le tableau est trop petit ou les parametres invalides
+int QRcode_to_tiff_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+{
+    int largeur = largeur_image(qrcode, echelle, zone_blanche);
+    size_t taille_g4;
+    int ifd;
+    unsigned char *entree;
+
+    if(largeur < 0 || taille_max < 8 + 1 + TAILLE_IFD_TIFF)
+    {
+        return -1;
+    }
+    taille_g4 = code_g4(qrcode, echelle, zone_blanche, largeur, image + 8, taille_max - 8 - 1 - TAILLE_IFD_TIFF);
+    if(taille_g4 > (size_t)(taille_max - 8 - 1 - TAILLE_IFD_TIFF))
+    {
+        return -1;
+    }
+    // entete : petit-boutiste, 42, offset de l'IFD (sur un mot de 2 octets)
+    ifd = 8 + (int)taille_g4;
+    if(ifd & 1)
+    {
+        image[ifd++] = 0;
+    }
+    memcpy(image, "II*\0", 4);
+    ecrit_32bits_tiff(image + 4, ifd);
+
+    // IFD : entrées dans l'ordre croissant des etiquettes
+    image[ifd] = 12;
+    image[ifd+1] = 0;
+    entree = image + ifd + 2;
+    ecrit_entree_tiff(entree,       256, 4, largeur);           // ImageWidth
+    ecrit_entree_tiff(entree + 12,  257, 4, largeur);           // ImageLength
+    ecrit_entree_tiff(entree + 24,  258, 3, 1);                 // BitsPerSample
+    ecrit_entree_tiff(entree + 36,  259, 3, 4);                 // Compression : CCITT T.6
+    ecrit_entree_tiff(entree + 48,  262, 3, 0);                 // PhotometricInterpretation : WhiteIsZero
+    ecrit_entree_tiff(entree + 60,  273, 4, 8);                 // StripOffsets
+    ecrit_entree_tiff(entree + 72,  277, 3, 1);                 // SamplesPerPixel
+    ecrit_entree_tiff(entree + 84,  278, 4, largeur);           // RowsPerStrip : une seule bande
+    ecrit_entree_tiff(entree + 96,  279, 4, (uint32_t)taille_g4);   // StripByteCounts
+    ecrit_entree_tiff(entree + 108, 282, 5, ifd + 2 + 12*12 + 4);   // XResolution
+    ecrit_entree_tiff(entree + 120, 283, 5, ifd + 2 + 12*12 + 4 + 8);   // YResolution
+    ecrit_entree_tiff(entree + 132, 296, 3, 2);                 // ResolutionUnit : pouce
+    ecrit_32bits_tiff(entree + 144, 0);                         // pas d'autre IFD
+    ecrit_32bits_tiff(entree + 148, DPI_TIFF);
+    ecrit_32bits_tiff(entree + 152, 1);
+    ecrit_32bits_tiff(entree + 156, DPI_TIFF);
+    ecrit_32bits_tiff(entree + 160, 1);
+    return ifd + TAILLE_IFD_TIFF;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_tiff(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche)
+/// \brief Fonction d'export en TIFF G4 (fax), le format bilevel le plus compact, accepté par les logiciels d'impression et d'archivage
+/// \param[in] qrcode le QRcode
+/// \param[in] *filename : le nom du fichier image (avec extension .tif)
+/// \param[in] echelle : largeur en pixels d'un module (1 ou plus)
+/// \param[in] zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \return 0, -1 si les parametres sont invalides ou si l'ecriture a echoué
+int QRcode_to_tiff(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche)
 {
-    //int i;
-    // A COMPLETER
+    unsigned char *image;
+    int largeur = largeur_image(qrcode, echelle, zone_blanche);
+    int taille_max, taille, resultat = -1;
+
+    if(largeur < 0)
+    {
+        return -1;
+    }
+    // une premiere passe sans sortie donne la taille exacte des données G4
+    taille_max = 8 + (int)code_g4(qrcode, echelle, zone_blanche, largeur, NULL, 0) + 1 + TAILLE_IFD_TIFF;
+    if((image = malloc(taille_max)) == NULL)
+    {
+        return -1;
+    }
+    taille = QRcode_to_tiff_memoire(qrcode, echelle, zone_blanche, image, taille_max);
+    if(taille >= 0)
+    {
+        resultat = ecrit_fichier_image(filename, image, taille);
+    }
+    free(image);
+    return resultat;
 }
 
-//////////////////////////////////////////////////////////////////////
-/// \fn void ajoute_dataM2_QRcode(const unsigned char packedbyteDS[24],unsigned char qrcode[NB_MODULE][NB_MODULE])
-/// \brief Sujet 4 version M2 : Ajoute les données (packed) dans un microQRcode M2
-/// \param[in]     packedbyteDS[] : le tableau du flux binaire a ecrire compacté en octets (seuls les 10 premiers sont ecrits
-/// \param[in,out] qrcode[][]  : le qrcode
+// ////////////////////////// EXPORT VECTORIEL SVG / PDF ////////////////////////////////
+// les modules noirs consécutifs d'une ligne sont réunis en un seul rectangle : en SVG, un sous-chemin "Mx yhnv1h-nz"
+// d'un unique <path>, en PDF un "x y n 1 re" et un seul remplissage par QRcode. les coordonnées sont en modules,
+// la mise a l'echelle et la position sont données une fois (viewBox / translate en SVG, matrice cm en PDF).
 
-void ajoute_dataM2_QRcode(const unsigned char packedbyteDS[24],unsigned char qrcode[NB_MODULE][NB_MODULE])
+#define TAILLE_TRACE_MAX  (16 + 24*NB_MODULE_MAX*(NB_MODULE_MAX+1)/2)   /** au plus (n+1)/2 plages par ligne, 24 caracteres par plage */
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static int trace_QRcode(const QRcode_t *qrcode, int pdf, char *trace)
+/// \brief ecrit un rectangle par plage horizontale de modules noirs (coordonnées en modules, origine en haut a gauche)
+/// \param[in]  qrcode : le QRcode
+/// \param[in]  pdf : 0 pour un chemin SVG, 1 pour des rectangles PDF (opérateur re)
+/// \param[out] trace[TAILLE_TRACE_MAX] : le texte (terminé par \0)
+/// \return nombre de caracteres ecrits (0 si aucun module noir)
+static int trace_QRcode(const QRcode_t *qrcode, int pdf, char *trace)
 {
-    //int i;
-    // A completer
+    int i, j, k, n = 0;
+
+    trace[0] = '\0';
+    for(i=0; i<qrcode->nb_module; i++)
+    {
+        for(j=0; j<qrcode->nb_module; j=k)
+        {
+            for(k=j+1; k<qrcode->nb_module && (qrcode->module[i][k] != BLANC) == (qrcode->module[i][j] != BLANC); k++);
+            if(qrcode->module[i][j] == BLANC)
+            {
+                continue;
+            }
+            if(pdf)
+            {
+                n += sprintf(trace + n, "%d %d %d 1 re\n", j, i, k-j);
+            }
+            else
+            {
+                n += sprintf(trace + n, "M%d %dh%dv1h-%dz", j, i, k-j, k-j);
+            }
+        }
+    }
+    return n;
 }
-//////////////////////////////////////////////////////////////////////
-/// \fn void ajoute_dataM3L_QRcode(const unsigned char packedbyteDS[24],unsigned char qrcode[NB_MODULE][NB_MODULE])
-/// \brief HORS SUJET  M3L : Ajoute les données (packed)  dans un microQRcode M3L
-/// \param[in]      packedbyteDS[] : le tableau du flux binaire a ecrire compacté en octets (seuls les 17 premiers sont ecrits
-/// \param[in,out]  qrcode[][]  : le qrcode
 
-void ajoute_dataM3L_QRcode(const unsigned char packedbyteDS[24],unsigned char qrcode[NB_MODULE][NB_MODULE])
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_svg_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+/// \brief Ecrit le SVG d'un QRcode dans un tableau : un fond blanc et un seul chemin pour les modules noirs
+/// \param[in]  qrcode le QRcode
+/// \param[in]  echelle : largeur en pixels d'un module (taille d'affichage par défaut, le SVG reste redimensionnable)
+/// \param[in]  zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \param[out] image : le tableau ou ecrire le SVG
+/// \param[in]  taille_max : taille du tableau
+/// \return nombre d'octets ecrits, -1 si le tableau est trop petit ou les parametres invalides
+int QRcode_to_svg_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max)
 {
-    //int i;
-    // NON TRAITE
+    char trace[TAILLE_TRACE_MAX];
+    int largeur = largeur_image(qrcode, echelle, zone_blanche);
+    int cote = qrcode->nb_module + 2*zone_blanche;
+    int taille;
+
+    if(largeur < 0 || taille_max <= 0)
+    {
+        return -1;
+    }
+    trace_QRcode(qrcode, 0, trace);
+    taille = snprintf((char *)image, taille_max,
+                      "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                      "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\" viewBox=\"0 0 %d %d\" shape-rendering=\"crispEdges\">\n"
+                      "<rect width=\"%d\" height=\"%d\" fill=\"#fff\"/>\n"
+                      "<path transform=\"translate(%d %d)\" d=\"%s\"/>\n"
+                      "</svg>\n",
+                      largeur, largeur, cote, cote, cote, cote, zone_blanche, zone_blanche, trace);
+    return (taille < taille_max) ? taille : -1;
 }
 
-//////////////////////////////////////////////////////////////////////
-/// \fn void ajoute_dataM3M_QRcode(const unsigned char packedbyteDS[24],unsigned char qrcode[NB_MODULE][NB_MODULE])
-/// \brief HORS SUJET  M3M : ajoute les données (packed) dans un microQRcode M3M
-/// \param[in]     packedbyteDS[] : le tableau du flux binaire a ecrire compacté en octets (seuls les 17 premiers sont ecrits
-/// \param[in,out] qrcode[][]  : le qrcode !
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_svg(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche)
+/// \brief Fonction d'export en SVG (image vectorielle, redimensionnable sans perte)
+/// \param[in] qrcode le QRcode
+/// \param[in] *filename : le nom du fichier image (avec extension .svg)
+/// \param[in] echelle : largeur en pixels d'un module (taille d'affichage par défaut)
+/// \param[in] zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \return 0, -1 si les parametres sont invalides ou si l'ecriture a echoué
+int QRcode_to_svg(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche)
+{
+    unsigned char image[TAILLE_TRACE_MAX + 512];
+    int taille = QRcode_to_svg_memoire(qrcode, echelle, zone_blanche, image, sizeof(image));
+
+    return (taille < 0) ? -1 : ecrit_fichier_image(filename, image, taille);
+}
 
-void ajoute_dataM3M_QRcode(const unsigned char packedbyteDS[24],unsigned char qrcode[NB_MODULE][NB_MODULE])
+// sortie d'un PDF : un fichier (planches d'etiquettes de taille quelconque) ou un tableau
+typedef struct
 {
-    //int i;
-    // NON TRAITE
+    FILE *fd;                   /** fichier de sortie, NULL pour ecrire dans image          */
+    unsigned char *image;
+    long taille_max;            /** taille de image                                          */
+    long position;              /** nombre d'octets ecrits (ou qui l'auraient été)            */
+    int erreur;                 /** erreur d'ecriture dans le fichier                         */
+} QRsortie_pdf_t;
 
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void ecrit_pdf(QRsortie_pdf_t *pdf, const char *texte, int nb)
+/// \brief ajoute nb octets au PDF ; dans un tableau, au-dela de taille_max, les octets sont comptés mais pas ecrits
+static void ecrit_pdf(QRsortie_pdf_t *pdf, const char *texte, int nb)
+{
+    if(pdf->fd != NULL)
+    {
+        pdf->erreur |= (fwrite(texte, 1, nb, pdf->fd) != (size_t)nb);
+    }
+    else if(pdf->position + nb <= pdf->taille_max)
+    {
+        memcpy(pdf->image + pdf->position, texte, nb);
+    }
+    pdf->position += nb;
 }
 
-//////////////////////////////////////////////////////////////////////
-/// \fn void ajoute_dataM4_QRcode(const unsigned char packedbyteDS[24],unsigned char qrcode[NB_MODULE][NB_MODULE])
-/// \brief Sujet 4 (version M4) : Ajoute les données (packed) dans un microQRcode M4
-/// \param[in]     packedbyteDS[] : le tableau du flux binaire a ecrire compacté en octets
-/// \param[in,out] qrcode[][] : le qrcode
+/////////////////////////////////////////////////////////////////////////
+/// \fn static void ecrit_format_pdf(QRsortie_pdf_t *pdf, const char *format, ...)
+/// \brief comme printf, pour les objets du PDF (moins de 256 caracteres)
+static void ecrit_format_pdf(QRsortie_pdf_t *pdf, const char *format, ...)
+{
+    char texte[256];
+    va_list arguments;
+    int nb;
 
-void ajoute_dataM4_QRcode(const unsigned char packedbyteDS[24],unsigned char qrcode[NB_MODULE][NB_MODULE])
+    va_start(arguments, format);
+    nb = vsnprintf(texte, sizeof(texte), format, arguments);
+    va_end(arguments);
+    ecrit_pdf(pdf, texte, nb);
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static int pdf_QRcode(QRsortie_pdf_t *pdf, const QRcode_t *qrcodes, int nb, int colonnes, int lignes, int echelle, int zone_blanche)
+/// \brief ecrit un PDF de nb QRcodes, colonnes x lignes par page (cases de la taille du plus grand QRcode et de sa zone blanche)
+///        objets : 1 catalogue, 2 arbre des pages, puis pour la page p : 3+2p la page et 4+2p son contenu
+/// \return 0, -1 si les parametres sont invalides ou en cas d'erreur d'allocation
+static int pdf_QRcode(QRsortie_pdf_t *pdf, const QRcode_t *qrcodes, int nb, int colonnes, int lignes, int echelle, int zone_blanche)
 {
-    //int i;
-    // A COMPLETER
+    QRcode_t modele;
+    long *positions;                // position de chaque objet, pour la table xref
+    char *contenu;
+    long long largeur_page, hauteur_page;
+    int cellule, par_page, nb_pages, nb_objets, page, k, n, decalage, x, y, taille_trace;
+    long position_xref;
+
+    if(nb <= 0 || colonnes <= 0 || lignes <= 0)
+    {
+        return -1;
+    }
+    modele.nb_module = NB_MODULE_M1;
+    for(k=0; k<nb; k++)
+    {
+        if(qrcodes[k].nb_module > modele.nb_module)
+        {
+            modele.nb_module = qrcodes[k].nb_module;
+        }
+    }
+    if(largeur_image(&modele, echelle, zone_blanche) < 0)
+    {
+        return -1;
+    }
+    cellule = modele.nb_module + 2*zone_blanche;            // en modules
+    largeur_page = (long long)colonnes * cellule * echelle; // en points (1/72 de pouce)
+    hauteur_page = (long long)lignes * cellule * echelle;
+    if(largeur_page > 0x7FFFFFF || hauteur_page > 0x7FFFFFF)
+    {
+        return -1;
+    }
+    par_page = (colonnes * lignes < nb) ? colonnes * lignes : nb;
+    nb_pages = (nb + par_page - 1) / par_page;
+    nb_objets = 3 + 2*nb_pages;
+    positions = malloc(nb_objets * sizeof(long));
+    contenu = malloc((size_t)par_page * (TAILLE_TRACE_MAX + 64));
+    if(positions == NULL || contenu == NULL)
+    {
+        free(positions);
+        free(contenu);
+        return -1;
+    }
+
+    ecrit_pdf(pdf, "%PDF-1.4\n%\xE2\xE3\xCF\xD3\n", 15);
+    positions[1] = pdf->position;
+    ecrit_format_pdf(pdf, "1 0 obj\n<</Type/Catalog/Pages 2 0 R>>\nendobj\n");
+    positions[2] = pdf->position;
+    ecrit_format_pdf(pdf, "2 0 obj\n<</Type/Pages/Count %d/Kids[", nb_pages);
+    for(page=0; page<nb_pages; page++)
+    {
+        ecrit_format_pdf(pdf, "%d 0 R ", 3 + 2*page);
+    }
+    ecrit_format_pdf(pdf, "]>>\nendobj\n");
+
+    for(page=0; page<nb_pages; page++)
+    {
+        // contenu : pour chaque QRcode, une matrice (echelle points par module, axe y vers le bas) puis ses rectangles
+        n = 0;
+        for(k=0; k<par_page && page*par_page+k<nb; k++)
+        {
+            decalage = (cellule - qrcodes[page*par_page+k].nb_module) / 2;     // zone blanche (plus grande pour un petit QRcode)
+            x = ((k % colonnes) * cellule + decalage) * echelle;
+            y = (int)hauteur_page - ((k / colonnes) * cellule + decalage) * echelle;
+            n += sprintf(contenu + n, "q %d 0 0 %d %d %d cm\n", echelle, -echelle, x, y);
+            taille_trace = trace_QRcode(&qrcodes[page*par_page+k], 1, contenu + n);
+            n += taille_trace;
+            n += sprintf(contenu + n, (taille_trace > 0) ? "f Q\n" : "Q\n");
+        }
+        positions[3 + 2*page] = pdf->position;
+        ecrit_format_pdf(pdf, "%d 0 obj\n<</Type/Page/Parent 2 0 R/MediaBox[0 0 %lld %lld]/Resources<<>>/Contents %d 0 R>>\nendobj\n",
+                         3 + 2*page, largeur_page, hauteur_page, 4 + 2*page);
+        positions[4 + 2*page] = pdf->position;
+        ecrit_format_pdf(pdf, "%d 0 obj\n<</Length %d>>\nstream\n", 4 + 2*page, n);
+        ecrit_pdf(pdf, contenu, n);
+        ecrit_format_pdf(pdf, "\nendstream\nendobj\n");
+    }
+
+    // table des positions des objets (entrées de 20 octets) et trailer
+    position_xref = pdf->position;
+    ecrit_format_pdf(pdf, "xref\n0 %d\n0000000000 65535 f \n", nb_objets);
+    for(k=1; k<nb_objets; k++)
+    {
+        ecrit_format_pdf(pdf, "%010ld 00000 n \n", positions[k]);
+    }
+    ecrit_format_pdf(pdf, "trailer\n<</Size %d/Root 1 0 R>>\nstartxref\n%ld\n%%%%EOF\n", nb_objets, position_xref);
+    free(positions);
+    free(contenu);
+    return 0;
 }
 
-////////////////////////////////////////////////////////////////////////////////////
-/// \fn void put_byte_in_blocks(unsigned char qrcode[NB_MODULE][NB_MODULE],unsigned char byte,
-///                        unsigned char lig, unsigned char col, unsigned char direction)
-/// \brief Sujets 4 (commun a toutes les versions M1/M2/M3/M4 : Ecriture d'un bloc de 8 modules a un emplacement donné (et pour une direction donnée parmi UP, DN UL,DL, US  )
-/// \param[in,out] qrcode[][] le qrcode
-/// \param[in]    byte : les 8 bits à ecrire
-/// \param[in]    lig :  la ligne ou doit etre placé le bit7
-/// \param[in]   col  ; la colonne ou doit etre placée le bit de poid fort (bit7)
-/// \param[in]    direction : la direction parmi ( UP, DN, UL, DL, et US  pour UP LEFT ou DOWN LEFT, et US pour les blocs spéciaux de 4 bist )
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_pdf_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+/// \brief Ecrit un PDF d'une page, a la taille du QRcode et de sa zone blanche, dans un tableau
+/// \param[in]  qrcode le QRcode
+/// \param[in]  echelle : largeur en points (1/72 de pouce) d'un module
+/// \param[in]  zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \param[out] image : le tableau ou ecrire le PDF
+/// \param[in]  taille_max : taille du tableau
+/// \return nombre d'octets ecrits, -1 si le tableau est trop petit ou les parametres invalides
+int QRcode_to_pdf_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+{
+    QRsortie_pdf_t pdf = { NULL, image, taille_max, 0, 0 };
 
-void put_byte_in_blocks(unsigned char qrcode[NB_MODULE][NB_MODULE],unsigned char byte,
-                        unsigned char lig, unsigned char col, unsigned char direction)
+    if(pdf_QRcode(&pdf, qrcode, 1, 1, 1, echelle, zone_blanche) < 0 || pdf.position > taille_max)
+    {
+        return -1;
+    }
+    return (int)pdf.position;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int etiquettes_pdf_QRcode(const char *filename, const QRcode_t *qrcodes, int nb, int colonnes, int lignes, int echelle, int zone_blanche)
+/// \brief Ecrit un PDF de plusieurs pages : nb QRcodes sur des planches d'etiquettes de colonnes x lignes cases
+///        (une case par QRcode, a la taille du plus grand QRcode et de sa zone blanche ; les plus petits y sont centrés)
+///        les pages sont ecrites au fur et a mesure, sans garder le document en memoire
+/// \param[in] filename : le nom du fichier (extension .pdf)
+/// \param[in] qrcodes[nb] : les QRcodes, dans l'ordre des cases (ligne par ligne, page par page)
+/// \param[in] nb : nombre de QRcodes
+/// \param[in] colonnes : nombre de cases par ligne
+/// \param[in] lignes : nombre de lignes de cases par page
+/// \param[in] echelle : largeur en points (1/72 de pouce) d'un module
+/// \param[in] zone_blanche : largeur en modules de la marge blanche autour du plus grand QRcode (ZONE_BLANCHE pour un microQR)
+/// \return 0, -1 si les parametres sont invalides ou en cas d'erreur de fichier
+int etiquettes_pdf_QRcode(const char *filename, const QRcode_t *qrcodes, int nb, int colonnes, int lignes, int echelle, int zone_blanche)
 {
-    // A COMPLETER
-}//
+    QRsortie_pdf_t pdf = { NULL, NULL, 0, 0, 0 };
+    int erreur;
+
+    if(!(pdf.fd = fopen(filename, "wb")))
+    {
+        fprintf(stderr,"etiquettes_pdf_QRcode, erreur de création du fichier %s\n",filename);
+        return -1;
+    }
+    erreur = pdf_QRcode(&pdf, qrcodes, nb, colonnes, lignes, echelle, zone_blanche);
+    erreur |= pdf.erreur;
+    erreur |= (fclose(pdf.fd) != 0);
+    return (erreur != 0) ? -1 : 0;
+}
 
 /////////////////////////////////////////////////////////////////////////
-/// \fn void QRcode_to_console(const unsigned char qrcode[NB_MODULE][NB_MODULE]){
-///  \brief  Code C fourni  : Fonction d'affichage basique du microQRcode sur la console
-/// affiche un microQRcode sur la console, . pour les blanc, * pour les noirs, F,V, S pour reperer les differentes
-/// zone lors du debug.
-/// \param[in] qrcode : le QRcode a afficher sur la console !
-void QRcode_to_console(const unsigned char qrcode[NB_MODULE][NB_MODULE])
+/// \fn int QRcode_to_pdf(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche)
+/// \brief Fonction d'export en PDF (une page a la taille du QRcode, vectoriel)
+/// \param[in] qrcode le QRcode
+/// \param[in] *filename : le nom du fichier (avec extension .pdf)
+/// \param[in] echelle : largeur en points (1/72 de pouce) d'un module
+/// \param[in] zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \return 0, -1 si les parametres sont invalides ou si l'ecriture a echoué
+int QRcode_to_pdf(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche)
 {
-    int i,j;
-    putchar('\n');
-    for(i=0; i<NB_MODULE; i++)
+    return etiquettes_pdf_QRcode(filename, qrcode, 1, 1, 1, echelle, zone_blanche);
+}
+
+// ////////////////////////// EXPORT IMPRIMANTES THERMIQUES ////////////////////////////////
+// ZPL : une etiquette ^XA ... ^XZ avec un champ graphique ^GFA (1 bit par point, 1 = noir), en hexadécimal compressé
+// a la façon ZPL (':' ligne identique a la précédente, ',' fin de ligne blanche, '!' fin de ligne noire, compteurs G..Y / g..z)
+// ou en Z64 (base64 du zlib, meme deflate que le PNG, suivi du CRC-16 du texte base64).
+// ESC/POS : commandes raster GS v 0 par bandes de BANDE_ESCPOS lignes au plus.
+// les lignes de points sont construites a partir des modules (ligne_bits_QRcode), une fois par ligne de modules.
+
+#define REPETITION_ZPL_MAX  419     /** plus grand compteur ZPL : z (400) + Y (19)                        */
+#define BANDE_ESCPOS        256     /** lignes par commande GS v 0 (les imprimantes limitent leur tampon) */
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static int repetition_zpl(char *sortie, int nb, char caractere)
+/// \brief ecrit nb fois caractere en hexadécimal compressé ZPL : compteur (g..z = 20..400, G..Y = 1..19) puis le caractere
+/// \return nombre de caracteres ecrits
+static int repetition_zpl(char *sortie, int nb, char caractere)
+{
+    int n = 0, groupe;
+
+    while(nb > 0)
     {
-        for(j=0; j<NB_MODULE; j++)
+        groupe = (nb > REPETITION_ZPL_MAX) ? REPETITION_ZPL_MAX : nb;
+        if(groupe < 3)                  // un compteur n'apporte rien
+        {
+            memset(sortie + n, caractere, groupe);
+            n += groupe;
+        }
+        else
         {
-            switch(qrcode[i][j])                                      // on ajoute 1 espace entre module pour que ca ressemble a un carré
+            if(groupe >= 20)
             {
-            case BLANC :
-                putchar('.');
-                putchar(' ');
-                break;       // des . pour le blanc /
-            case NOIR  :
-                putchar('*');
-                putchar(' ');
-                break;       // des * pour les noirs
-            default    :
-                if((qrcode[i][j] <=126) && (qrcode[i][j]>= 32) )  // on affiche les carectere "affichable"
-                {
-                    putchar(qrcode[i][j]);
-                    putchar(' ');
-                }
-                else
-                {
-                    putchar(' ');                      // si non on n'affiche rien
-                    putchar(' ');
-                };
-                break;
+                sortie[n++] = (char)('g' + groupe/20 - 1);
+            }
+            if(groupe % 20)
+            {
+                sortie[n++] = (char)('G' + groupe%20 - 1);
             }
+            sortie[n++] = caractere;
         }
-        putchar('\n');
+        nb -= groupe;
     }
-    putchar('\n');
+    return n;
 }
-///largeur en pixel pour un module, utilisé pour generer les fic image ppm/pgm
-#define PIX_BY_MODULE 8
+
 /////////////////////////////////////////////////////////////////////////
-/// \fn int QRcode_to_pgm(const unsigned char qrcode[NB_MODULE][NB_MODULE], char *filename)
-/// \brief Code C fourni : Fonction d'export en PGM (portable Gray map); format d'image lisible avec xniew
-/// \param[in] qrcode[][] le QRcode !
-/// \param[out] *filename     le nom du fichier image ou enregistre le qr code (avec extension .pgm)
+/// \fn static int ligne_hexa_zpl(const unsigned char *ligne, int octets_ligne, char *sortie)
+/// \brief ecrit une ligne de points en hexadécimal compressé ZPL (au plus 2 caracteres par octet)
+/// \return nombre de caracteres ecrits
+static int ligne_hexa_zpl(const unsigned char *ligne, int octets_ligne, char *sortie)
+{
+    static const char hexa[16] = { '0','1','2','3','4','5','6','7','8','9','A','B','C','D','E','F' };
+    int nb_chiffres = 2*octets_ligne, fin, i, k, n = 0;
+    char chiffre;
 
-// la constante précédente PIX_BY_MODULE, definit la taille en pixels d'un module dans le fichier PGM
-// exemple si PIX_BY_MODULE =8, chaque module =1bit)= deviendra 8 x 8 pixels dans l'image
-// le qrcode passé doit etre codé en niveau de gris (0 pour le noir, 255 pour le blanc)..
+#define CHIFFRE_ZPL(x)  hexa[(ligne[(x) >> 1] >> (((x) & 1) ? 0 : 4)) & 15]
+    for(fin=nb_chiffres; fin>0 && CHIFFRE_ZPL(fin-1)=='0'; fin--);
+    for(i=0; i<fin; i=k)
+    {
+        chiffre = CHIFFRE_ZPL(i);
+        for(k=i+1; k<fin && CHIFFRE_ZPL(k)==chiffre; k++);
+        if(k == nb_chiffres && chiffre == 'F' && k-i > 1)
+        {
+            sortie[n++] = '!';          // noir jusqu'a la fin de la ligne
+        }
+        else
+        {
+            n += repetition_zpl(sortie + n, k-i, chiffre);
+        }
+    }
+#undef CHIFFRE_ZPL
+    if(fin < nb_chiffres)
+    {
+        sortie[n++] = ',';              // blanc jusqu'a la fin de la ligne
+    }
+    return n;
+}
 
-int QRcode_to_pgm(const unsigned char qrcode[NB_MODULE][NB_MODULE], char *filename)
+/////////////////////////////////////////////////////////////////////////
+/// \fn static uint16_t crc16_zpl(const char *texte, size_t nb)
+/// \brief CRC-16 CCITT (XModem : polynome 0x1021, valeur initiale 0) du texte base64 d'un champ Z64
+static uint16_t crc16_zpl(const char *texte, size_t nb)
 {
-    FILE *fd;
-    int i,j,ii,jj;
+    uint16_t crc = 0;
+    size_t i;
+    int k;
 
-//Test sur l'ouverture du fichier
-    if(!(fd = fopen(filename,"w+")) )
+    for(i=0; i<nb; i++)
     {
-        fprintf(stderr,"QRcode2ppm, erreur de cr�ation du fichier %s\n",filename);
-        exit(-1);
-    };
-// ecriture du PGM en niveau de gris (256) Entete d'un fichier ppm  P5 = Magick number....
-    fprintf(fd,"P5\n");              // Magik number pour Portable GreyMap ==P5
-    fprintf(fd,"#fichier PGM pour QRcode \n#IUT VDA S.BRETTE 2021\n");
-    fprintf(fd,"%d %d 255 ",NB_MODULE*PIX_BY_MODULE,NB_MODULE*PIX_BY_MODULE);
-    // entete ppm P5 : largeur, hauteur, nb niveaux de gris
-    // NE PAS TOUCHER A CETTE ENTETE, espace (et non \n indispensable apres le 255
-// BBBBBB a la suite jusqu'a la fin en partant en haut a gauche de l'image
-    for(i=0; i<NB_MODULE; i++)
+        crc ^= (uint16_t)((unsigned char)texte[i] << 8);
+        for(k=0; k<8; k++)
+        {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static size_t base64_zpl(const unsigned char *octets, size_t nb, char *sortie)
+/// \brief code nb octets en base64 (alphabet standard, complété par '=')
+/// \return nombre de caracteres ecrits : 4 par groupe de 3 octets
+static size_t base64_zpl(const unsigned char *octets, size_t nb, char *sortie)
+{
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t i, n = 0;
+    uint32_t groupe;
+
+    for(i=0; i<nb; i+=3)
+    {
+        groupe = (uint32_t)octets[i] << 16;
+        if(i+1 < nb) groupe |= (uint32_t)octets[i+1] << 8;
+        if(i+2 < nb) groupe |= octets[i+2];
+        sortie[n++] = alphabet[(groupe >> 18) & 63];
+        sortie[n++] = alphabet[(groupe >> 12) & 63];
+        sortie[n++] = (i+1 < nb) ? alphabet[(groupe >> 6) & 63] : '=';
+        sortie[n++] = (i+2 < nb) ? alphabet[groupe & 63] : '=';
+    }
+    return n;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn static int taille_max_zpl(const QRcode_t *qrcode, int echelle, int zone_blanche, int z64)
+/// \brief taille maximale d'une etiquette ZPL, -1 si les parametres sont invalides
+static int taille_max_zpl(const QRcode_t *qrcode, int echelle, int zone_blanche, int z64)
+{
+    int largeur = largeur_image(qrcode, echelle, zone_blanche);
+    long long nb_octets = (long long)((largeur + 7) / 8) * largeur;
+
+    if(largeur < 0)
     {
-        for(ii=0; ii<PIX_BY_MODULE; ii++) // on recopie plusieurs fois le module dans 8 pixels*8pixels
+        return -1;
+    }
+    // Z64 : le deflate a codes fixes fait au plus 9 bits par octet, le base64 4 caracteres pour 3 octets
+    return 96 + (int)(z64 ? (2 + (nb_octets*9/8 + 8) + 4 + 2) / 3 * 4 : 2*nb_octets);
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_zpl_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, int z64, unsigned char *image, int taille_max)
+/// \brief Ecrit une etiquette ZPL (^XA ^FO0,0 ^GFA ... ^FS ^XZ) contenant le QRcode, prete a etre envoyée a l'imprimante
+/// \param[in]  qrcode le QRcode
+/// \param[in]  echelle : largeur en points d'imprimante d'un module (1 ou plus)
+/// \param[in]  zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \param[in]  z64 : 0 pour les données en hexadécimal compressé, 1 pour le Z64 (base64 du zlib + CRC)
+/// \param[out] image : le tableau ou ecrire l'etiquette
+/// \param[in]  taille_max : taille du tableau
+/// \return nombre d'octets ecrits, -1 si le tableau est trop petit, les parametres invalides ou en cas d'erreur d'allocation
+int QRcode_to_zpl_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, int z64, unsigned char *image, int taille_max)
+{
+    int largeur = largeur_image(qrcode, echelle, zone_blanche);
+    int octets_ligne, nb_octets, marge, i, n;
+    unsigned char *bitmap, *zlib, *ligne;
+    char *texte = (char *)image;
+    size_t taille_deflate, taille_base64;
+
+    if(largeur < 0 || taille_max < taille_max_zpl(qrcode, echelle, zone_blanche, z64))
+    {
+        return -1;
+    }
+    octets_ligne = (largeur + 7) / 8;
+    nb_octets = octets_ligne * largeur;
+    marge = zone_blanche * echelle;
+    n = sprintf(texte, "^XA\n^FO0,0^GFA,%d,%d,%d,", nb_octets, nb_octets, octets_ligne);
+    if(!z64)
+    {
+        // une ligne par ligne de modules, puis ':' pour chacune de ses echelle-1 copies ; la zone blanche ne fait qu'une ligne ','
+        if((ligne = malloc(octets_ligne)) == NULL)
+        {
+            return -1;
+        }
+        for(i=-1; i<=qrcode->nb_module; i++)
         {
-            for(j=0; j<NB_MODULE; j++)
+            if(i < 0 || i == qrcode->nb_module)         // zone blanche du haut ou du bas : marge lignes
             {
-                for(jj=0; jj<PIX_BY_MODULE; jj++)
+                if(marge == 0)
                 {
-                    fprintf(fd,"%c",qrcode[i][j]);
+                    continue;
                 }
+                texte[n++] = ',';
+                memset(texte + n, ':', marge - 1);
+                n += marge - 1;
+                continue;
             }
+            ligne_bits_QRcode(qrcode, i, echelle, marge, ligne, octets_ligne);
+            n += ligne_hexa_zpl(ligne, octets_ligne, texte + n);
+            memset(texte + n, ':', echelle - 1);
+            n += echelle - 1;
         }
+        free(ligne);
     }
-    fclose(fd);
-    return 0;
+    else
+    {
+        bitmap = malloc(nb_octets);
+        zlib = malloc(2 + nb_octets*9/8 + 8 + 4);
+        if(bitmap == NULL || zlib == NULL)
+        {
+            free(bitmap);
+            free(zlib);
+            return -1;
+        }
+        pthread_once(&tables_png_pretes, construit_tables_png);
+        QRcode_to_bitmap_memoire(qrcode, echelle, zone_blanche, bitmap, nb_octets);
+        zlib[0] = 0x78;
+        zlib[1] = 0x01;
+        taille_deflate = deflate_fixe(bitmap, nb_octets, zlib + 2, nb_octets*9/8 + 8);
+        ecrit_32bits_png(zlib + 2 + taille_deflate, adler32_png(bitmap, nb_octets));
+        n += sprintf(texte + n, ":Z64:");
+        taille_base64 = base64_zpl(zlib, 2 + taille_deflate + 4, texte + n);
+        n += (int)taille_base64;
+        n += sprintf(texte + n, ":%04X", crc16_zpl(texte + n - taille_base64, taille_base64));
+        free(bitmap);
+        free(zlib);
+    }
+    n += sprintf(texte + n, "^FS\n^XZ\n");
+    return n;
 }
 
 /////////////////////////////////////////////////////////////////////////
-/// /////////////////////////////////////////////////////////////////////////
-/// \fn int QRcode_to_ppm(const unsigned char qrcode[NB_MODULE][NB_MODULE], char *filename, unsigned long int color)
-/// \brief Code C fourni : Fonction d'export en PPM (portable Pix map  map); format d'image lisible avec xniew
-/// \param[in]  qrcode[][]  LE qrcode !
-/// \param[in] *filename     le nom du fichier image ou enregistre le qr code (avec extension .ppm)
-/// \param[in]  color ! la couleur des modules qui ne sont pas blancs ( (0x00FF0000 pour le rouge pur)
-/// la constante PIX_BY_MODULE, definit la taille en pixel d'un module dans le fichier PGM
-/// exemple si PIX_BY_MODULE =8, chaque module deviendra 8 x 8 pixel dans l'image
-/// le qrcode passé  est codé en niveau de gris (0 pour le noir, 255 pour le blanc)..
-/// tout module == 0 sera ecrit en blanc, les autres dans la couleur RGB définit dans la fonction.
-int QRcode_to_ppm(const unsigned char qrcode[NB_MODULE][NB_MODULE], char *filename, unsigned long int color)
+/// \fn int QRcode_to_zpl(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche, int z64)
+/// \brief Fonction d'export en ZPL (etiquette complete, a envoyer telle quelle sur le port 9100 de l'imprimante)
+/// \param[in] qrcode le QRcode
+/// \param[in] *filename : le nom du fichier (avec extension .zpl)
+/// \param[in] echelle : largeur en points d'imprimante d'un module (1 ou plus)
+/// \param[in] zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \param[in] z64 : 0 pour les données en hexadécimal compressé, 1 pour le Z64
+/// \return 0, -1 si les parametres sont invalides ou si l'ecriture a echoué
+int QRcode_to_zpl(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche, int z64)
 {
-    FILE *fd;
-    int i,j,ii,jj;
-    unsigned char red_level,green_level,blue_level; // RGB pour la couleur des pixels
-    int w = NB_MODULE*PIX_BY_MODULE ; // surechantillonnage
-    int h = NB_MODULE*PIX_BY_MODULE ; // surechantillonnage
-    red_level   = (color & 0x00FF0000)>>16;     // extraction des couleurs primaires R,G,B
-    green_level = (color & 0x0000FF00)>>8;      // pour ecriture dans le PPM
-    blue_level  = (color & 0x000000FF);
+    unsigned char *image;
+    int taille_max = taille_max_zpl(qrcode, echelle, zone_blanche, z64);
+    int taille, resultat = -1;
 
-//Test sur l'ouverture du fichier
-    if(!(fd = fopen(filename,"w+")) )
+    if(taille_max < 0 || (image = malloc(taille_max)) == NULL)
     {
-        fprintf(stderr,"QRcode2ppm, erreur de cr�ation du fichier %s\n",filename);
-        exit(-1);
-    };
+        return -1;
+    }
+    taille = QRcode_to_zpl_memoire(qrcode, echelle, zone_blanche, z64, image, taille_max);
+    if(taille >= 0)
+    {
+        resultat = ecrit_fichier_image(filename, image, taille);
+    }
+    free(image);
+    return resultat;
+}
 
-// Entete d'un fichier ppm  P6 = Magick number....
-    fprintf(fd,"P6\n%d %d\n255 ",w,h);  // entete ppm P6 : largeur, hauteur, nb niveaux sur  canaux RGB
+/////////////////////////////////////////////////////////////////////////
+/// \fn static int taille_escpos(const QRcode_t *qrcode, int echelle, int zone_blanche)
+/// \brief taille des commandes ESC/POS d'un QRcode (8 octets d'entete par bande), -1 si les parametres sont invalides
+static int taille_escpos(const QRcode_t *qrcode, int echelle, int zone_blanche)
+{
+    int largeur = largeur_image(qrcode, echelle, zone_blanche);
 
-// RGBRGBRGBRGB a la suite jusqu'a la fin en partant en haut a gauche de l'image
-    for(i=0; i<NB_MODULE; i++)
+    return (largeur < 0) ? -1 : (largeur + 7) / 8 * largeur + 8 * ((largeur + BANDE_ESCPOS - 1) / BANDE_ESCPOS);
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_escpos_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+/// \brief Ecrit un QRcode en commandes raster ESC/POS : GS v 0 (mode normal), xL xH (octets par ligne), yL yH (lignes), puis les points
+///        (1 = noir, poids fort a gauche), une commande par bande de BANDE_ESCPOS lignes
+/// \param[in]  qrcode le QRcode
+/// \param[in]  echelle : largeur en points d'imprimante d'un module (1 ou plus)
+/// \param[in]  zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \param[out] image : le tableau ou ecrire les commandes
+/// \param[in]  taille_max : taille du tableau
+/// \return nombre d'octets ecrits, -1 si le tableau est trop petit ou les parametres invalides (rien n'est ecrit)
+int QRcode_to_escpos_memoire(const QRcode_t *qrcode, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+{
+    int largeur = largeur_image(qrcode, echelle, zone_blanche);
+    int taille = taille_escpos(qrcode, echelle, zone_blanche);
+    int octets_ligne, marge, bande, hauteur_bande, y, k = 0;
+    unsigned char *ligne;
+
+#define LIGNE_ESCPOS(y)  (image + ((y) / BANDE_ESCPOS + 1) * 8 + (size_t)(y) * octets_ligne)   /** adresse de la ligne de points y */
+    if(taille < 0 || taille > taille_max)
+    {
+        return -1;
+    }
+    octets_ligne = (largeur + 7) / 8;
+    marge = zone_blanche * echelle;
+    for(bande=0; bande*BANDE_ESCPOS<largeur; bande++)
     {
-        for(ii=0; ii<PIX_BY_MODULE; ii++) // on recopie plusieurs fois le module dans 8 pixels*8pixels
+        hauteur_bande = (largeur - bande*BANDE_ESCPOS < BANDE_ESCPOS) ? largeur - bande*BANDE_ESCPOS : BANDE_ESCPOS;
+        ligne = LIGNE_ESCPOS(bande*BANDE_ESCPOS) - 8;
+        ligne[0] = 0x1D;
+        ligne[1] = 'v';
+        ligne[2] = '0';
+        ligne[3] = 0;
+        ligne[4] = (unsigned char)octets_ligne;
+        ligne[5] = (unsigned char)(octets_ligne >> 8);
+        ligne[6] = (unsigned char)hauteur_bande;
+        ligne[7] = (unsigned char)(hauteur_bande >> 8);
+    }
+    // les lignes d'une meme ligne de modules sont recopiées (elles peuvent etre de part et d'autre d'un entete de bande)
+    for(y=0; y<largeur; y++)
+    {
+        if(y < marge || y >= largeur - marge)
         {
-            for(j=0; j<NB_MODULE; j++)
-            {
-                for(jj=0; jj<PIX_BY_MODULE; jj++) // repetition par colonne
-                {
-                    if(qrcode[i][j] == BLANC)
-                    {
-                        fprintf(fd,"%c%c%c",255,255,255);  //
-                    }
-                    else
-                    {
-                        fprintf(fd,"%c%c%c",red_level, green_level, blue_level);
-                    }
-                }
-            }
+            memset(LIGNE_ESCPOS(y), 0, octets_ligne);
+        }
+        else if((y - marge) % echelle == 0)
+        {
+            ligne_bits_QRcode(qrcode, (y - marge) / echelle, echelle, marge, LIGNE_ESCPOS(y), octets_ligne);
+            k = y;
+        }
+        else
+        {
+            memcpy(LIGNE_ESCPOS(y), LIGNE_ESCPOS(k), octets_ligne);
         }
     }
-    fclose(fd);
-    return 0;
+#undef LIGNE_ESCPOS
+    return taille;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_escpos(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche)
+/// \brief Fonction d'export en commandes raster ESC/POS (a envoyer telles quelles a une imprimante de tickets)
+/// \param[in] qrcode le QRcode
+/// \param[in] *filename : le nom du fichier
+/// \param[in] echelle : largeur en points d'imprimante d'un module (1 ou plus)
+/// \param[in] zone_blanche : largeur en modules de la marge blanche autour du QRcode (ZONE_BLANCHE pour un microQR, 0 sans marge)
+/// \return 0, -1 si les parametres sont invalides ou si l'ecriture a echoué
+int QRcode_to_escpos(const QRcode_t *qrcode, char *filename, int echelle, int zone_blanche)
+{
+    unsigned char *image;
+    int taille = taille_escpos(qrcode, echelle, zone_blanche);
+    int resultat = -1;
+
+    if(taille < 0 || (image = malloc(taille)) == NULL)
+    {
+        return -1;
+    }
+    if(QRcode_to_escpos_memoire(qrcode, echelle, zone_blanche, image, taille) >= 0)
+    {
+        resultat = ecrit_fichier_image(filename, image, taille);
+    }
+    free(image);
+    return resultat;
+}
+
+/////////////////////////////////////////////////////////////////////////
+/// \fn int QRcode_to_image_memoire(const QRcode_t *qrcode, int format, int echelle, int zone_blanche, unsigned char *image, int taille_max)
+/// \brief Ecrit l'image d'un QRcode dans un tableau (PBM P4, PGM P5, bitmap brut 8 ou 1 bit sans entete, PNG, TIFF G4, SVG, PDF,
+///        ou commandes d'imprimante ZPL / ESC/POS)
+/// \param[in]  qrcode : le QRcode
+/// \param[in]  format : FORMAT_PBM, FORMAT_PGM, FORMAT_RAW, FORMAT_BITMAP, FORMAT_PNG, FORMAT_TIFF, FORMAT_SVG, FORMAT_PDF,
+///                     FORMAT_ZPL, FORMAT_Z64 ou FORMAT_ESCPOS
+/// \param[in]  echelle : largeur en pixels d'un module (1 ou plus)
+/// \param[in]  zone_blanche : largeur en modules de la marge blanche autour du QRcode
+/// \param[out] image : le tableau ou ecrire l'image (entete compris)
+/// \param[in]  taille_max : taille du tableau
+/// \return nombre d'octets ecrits, -1 si le tableau est trop petit ou les parametres invalides (rien n'est ecrit)
+int QRcode_to_image_memoire(const QRcode_t *qrcode, int format, int echelle, int zone_blanche,
+                            unsigned char *image, int taille_max)
+{
+    int largeur;
+
+    switch(format)
+    {
+    case FORMAT_PBM :
+        return QRcode_to_pbm_memoire(qrcode, echelle, zone_blanche, image, taille_max);
+    case FORMAT_PGM :
+        return QRcode_to_pgm_memoire(qrcode, echelle, zone_blanche, image, taille_max);
+    case FORMAT_BITMAP :
+        return QRcode_to_bitmap_memoire(qrcode, echelle, zone_blanche, image, taille_max);
+    case FORMAT_PNG :
+        return QRcode_to_png_memoire(qrcode, echelle, zone_blanche, image, taille_max);
+    case FORMAT_TIFF :
+        return QRcode_to_tiff_memoire(qrcode, echelle, zone_blanche, image, taille_max);
+    case FORMAT_SVG :
+        return QRcode_to_svg_memoire(qrcode, echelle, zone_blanche, image, taille_max);
+    case FORMAT_PDF :
+        return QRcode_to_pdf_memoire(qrcode, echelle, zone_blanche, image, taille_max);
+    case FORMAT_ZPL :
+    case FORMAT_Z64 :
+        return QRcode_to_zpl_memoire(qrcode, echelle, zone_blanche, format == FORMAT_Z64, image, taille_max);
+    case FORMAT_ESCPOS :
+        return QRcode_to_escpos_memoire(qrcode, echelle, zone_blanche, image, taille_max);
+    }
+    // FORMAT_RAW : les pixels d'un PGM, sans entete
+    largeur = largeur_image(qrcode, echelle, zone_blanche);
+    if(largeur < 0 || largeur*largeur > taille_max)
+    {
+        return -1;
+    }
+    QRcode_to_gris(qrcode, echelle, zone_blanche, image);
+    return largeur*largeur;
 }
 
 ////////////////////////////////////////////////////////////////
@@ -901,10 +6228,3 @@ void packedbyte_to_console(const unsigned char packedbyteDS[])
     //#warning 'bug a corriger : si un packedbyte = 255 .... fin d'affichage'
     putchar('\n');
 }
-
-
-
-
-
-
-